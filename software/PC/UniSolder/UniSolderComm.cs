@@ -25,6 +25,13 @@ public class UniSolderComm
 
         APP_SET_PID = 3,
         APP_GET_PID = 4,
+        APP_CLEAR_PID = 6,
+        APP_GET_I2C_STATS = 7,
+        APP_LIVE_RECORDS = 8,
+        APP_SET_TELEMETRY = 9,
+        APP_TELEMETRY = 10,
+        APP_CAPTURE = 11,
+        APP_CAPTURE_DATA = 12,
 
         BL_GET_INFO = 0xE0,
         BL_ERASE_FLASH = 0xE1,
@@ -83,6 +90,18 @@ public class UniSolderComm
         public byte DGain;
         public byte OVSGain;
     }
+
+    public class I2CStats
+    {
+        public UInt32 Time;         //core timer, 25ns ticks
+        public UInt32 BusyTicks;
+        public UInt32 Bytes;
+        public UInt32 Starts;
+        public UInt32 Polls;
+        public UInt32 Cmds;
+        public UInt32 Skipped;
+        public UInt32 Late;
+    }
     #endregion
 
     private SSComm.IUniComm lTransport;
@@ -114,6 +133,73 @@ public class UniSolderComm
     }
 
     public event EventHandler<LiveDataReceivedEventData> LiveDataReceived;
+
+    //One PID run of a channel, from the live record reports
+    public class LiveRecord
+    {
+        public UInt32 Seq;
+        public UInt16 Ticks;
+        public byte Ch;
+        public byte Heater;
+        public Int16 CTemp;         //degrees * 2
+        public UInt16 ADCTemp;
+        public UInt16 Duty;
+        public Int16 HR;            //heater resistance * 10
+        public UInt16 HP;
+    }
+
+    public class LiveRecordsReceivedEventData : EventArgs
+    {
+        public LiveRecord[] Records;
+        public UInt32 Lost;         //records lost before these ones
+    }
+
+    public event EventHandler<LiveRecordsReceivedEventData> LiveRecordsReceived;
+
+    //Telemetry frame: Values[field] has the elements of each channel in turn, null for the fields not in Mask
+    public class TelemetryFrameReceivedEventData : EventArgs
+    {
+        public UInt16 Seq;
+        public UInt16 Ticks;
+        public int Channels;
+        public UInt32 Mask;
+        public Int32[][] Values;
+        public UInt16 Lost;         //frames lost before this one
+    }
+
+    public event EventHandler<TelemetryFrameReceivedEventData> TelemetryFrameReceived;
+
+    //Field descriptors returned by AppSetTelemetry: element size in bits 0-2, elements - 1 in bits 3-5,
+    //signed 0x40, one for each channel 0x80
+    public byte[] TelemetryDesc = new byte[0];
+    public UInt32 TelemetryMask;
+    private UInt16 TelemetrySeq;
+
+    public const byte CAPTURE_NOW = 0, CAPTURE_HEATER = 1, CAPTURE_STATUS = 0x10, CAPTURE_RESEND = 0x11;
+
+    public class CaptureStatus
+    {
+        public byte State;          //0 off, 1 armed, 2 running, 3 done
+        public UInt16 Len;          //words captured
+        public UInt16 Size;         //capture buffer words
+        public UInt16 Lost;         //sample pairs which did not fit
+    }
+
+    //Complete capture: Data has the header of each half period (3 words: ticks, sample pairs, temperature ADC,
+    //off delay, heater, channel, power and ADC step) followed by its sample pairs, voltage in the low half
+    public class CaptureReceivedEventData : EventArgs
+    {
+        public UInt32[] Data;
+    }
+
+    public event EventHandler<CaptureReceivedEventData> CaptureReceived;
+
+    private UInt32[] CaptureData;
+    private int CaptureMissing;
+
+    private UInt32 LiveRecordSeq;
+    private bool LiveRecordSeqValid;
+    public UInt32 LiveRecordsLost;
     public event EventHandler InstrumentChange;
 
 
@@ -257,6 +343,70 @@ public class UniSolderComm
         SendBINCommand(BB, 0, BB.Length, null, 0);
     }
 
+    public void AppClearPIDParameters()
+    {
+        byte[] bb = { (byte)Commands.APP_CLEAR_PID };
+        SendBINCommand(bb, 0, 1, null, 0);
+        Debug.Print("Clear stored PID parameters.");
+    }
+
+    //I2C bus counters, free running: the bus utilisation is (BusyTicks2 - BusyTicks1) / (Time2 - Time1) of two reads
+    public I2CStats AppGetI2CStats()
+    {
+        byte[] bb = new byte[33];
+        bb[0] = (byte)Commands.APP_GET_I2C_STATS;
+        Debug.Print("Get I2C statistics");
+        SendBINCommand(bb, 0, 1, bb, 1000);
+        return new I2CStats
+        {
+            Time = BitConverter.ToUInt32(bb, 0),
+            BusyTicks = BitConverter.ToUInt32(bb, 4),
+            Bytes = BitConverter.ToUInt32(bb, 8),
+            Starts = BitConverter.ToUInt32(bb, 12),
+            Polls = BitConverter.ToUInt32(bb, 16),
+            Cmds = BitConverter.ToUInt32(bb, 20),
+            Skipped = BitConverter.ToUInt32(bb, 24),
+            Late = BitConverter.ToUInt32(bb, 28)
+        };
+    }
+
+    //Request the telemetry fields of mask (bits of the firmware TLM_FIELDS), 0 goes back to the LiveData reports.
+    //Returns the fields the firmware accepted, the ones which fit in a frame
+    public UInt32 AppSetTelemetry(UInt32 mask)
+    {
+        byte[] bb = new byte[64];
+        bb[0] = (byte)Commands.APP_SET_TELEMETRY;
+        BitConverter.GetBytes(mask).CopyTo(bb, 1);
+        Debug.Print("Set telemetry fields");
+        if (SendBINCommand(bb, 0, 5, bb, 1000) != 0) return 0;
+        var desc = new byte[bb[1]];
+        Array.Copy(bb, 7, desc, 0, desc.Length);
+        TelemetryDesc = desc;
+        TelemetrySeq = 0;
+        return TelemetryMask = BitConverter.ToUInt32(bb, 2);
+    }
+
+    //Start a capture of halves half periods (0 = until the buffer is full) with trigger CAPTURE_NOW or CAPTURE_HEATER,
+    //or CAPTURE_STATUS. The capture is sent in APP_CAPTURE_DATA reports once complete, CAPTURE_RESEND sends it again from offset
+    public CaptureStatus AppCapture(byte op, byte halves = 0, UInt16 offset = 0)
+    {
+        byte[] bb = new byte[64];
+        bb[0] = (byte)Commands.APP_CAPTURE;
+        bb[1] = op;
+        bb[2] = halves;
+        BitConverter.GetBytes(offset).CopyTo(bb, 3);
+        Debug.Print("Capture");
+        if (op != CAPTURE_STATUS && op != CAPTURE_RESEND) CaptureData = null;
+        if (SendBINCommand(bb, 0, 5, bb, 1000) != 0) return null;
+        return new CaptureStatus
+        {
+            State = bb[0],
+            Len = BitConverter.ToUInt16(bb, 1),
+            Size = BitConverter.ToUInt16(bb, 3),
+            Lost = BitConverter.ToUInt16(bb, 5)
+        };
+    }
+
     public Int32 BlGetInfo(ref byte blVerMaj, ref byte blVerMin)
     {
         byte[] bb = {
@@ -432,6 +582,15 @@ public class UniSolderComm
             case 3:
                 LiveDataReceived(this, new LiveDataReceivedEventData() { Data = RXB });
                 break;
+            case (byte)Commands.APP_LIVE_RECORDS:
+                ProcessLiveRecords(ref RXB);
+                break;
+            case (byte)Commands.APP_TELEMETRY:
+                ProcessTelemetry(ref RXB);
+                break;
+            case (byte)Commands.APP_CAPTURE_DATA:
+                ProcessCapture(ref RXB);
+                break;
             default:
                 CommandFeedBack.ReadFromBuffer(ref RXB, 0, 64);
                 break;
@@ -439,6 +598,94 @@ public class UniSolderComm
         return true;
     }
 
+    //Report of up to 4 records of 14 bytes from byte 6 on, the sequence number of the first one is in bytes 1-4
+    private void ProcessLiveRecords(ref byte[] RXB)
+    {
+        UInt32 seq = BitConverter.ToUInt32(RXB, 1);
+        int n = Math.Min((int)RXB[5], 4);
+        UInt32 lost = 0;
+        if (LiveRecordSeqValid && seq != LiveRecordSeq)
+        {
+            lost = seq - LiveRecordSeq;
+            LiveRecordsLost += lost;
+        }
+        LiveRecordSeq = seq + (UInt32)n;
+        LiveRecordSeqValid = true;
+        var recs = new LiveRecord[n];
+        for (int i = 0; i < n; i++)
+        {
+            int o = 6 + i * 14;
+            recs[i] = new LiveRecord
+            {
+                Seq = seq + (UInt32)i,
+                Ticks = BitConverter.ToUInt16(RXB, o),
+                Ch = RXB[o + 2],
+                Heater = RXB[o + 3],
+                CTemp = BitConverter.ToInt16(RXB, o + 4),
+                ADCTemp = BitConverter.ToUInt16(RXB, o + 6),
+                Duty = BitConverter.ToUInt16(RXB, o + 8),
+                HR = BitConverter.ToInt16(RXB, o + 10),
+                HP = BitConverter.ToUInt16(RXB, o + 12)
+            };
+        }
+        LiveRecordsReceived?.Invoke(this, new LiveRecordsReceivedEventData() { Records = recs, Lost = lost });
+    }
+
+    //Frame: version, channels, sequence, ticks and mask in bytes 1-10, the fields from byte 11 on
+    private void ProcessTelemetry(ref byte[] RXB)
+    {
+        var e = new TelemetryFrameReceivedEventData()
+        {
+            Channels = RXB[2],
+            Seq = BitConverter.ToUInt16(RXB, 3),
+            Ticks = BitConverter.ToUInt16(RXB, 5),
+            Mask = BitConverter.ToUInt32(RXB, 7),
+            Values = new Int32[TelemetryDesc.Length][]
+        };
+        int o = 11;
+        e.Lost = (UInt16)(e.Seq - TelemetrySeq);
+        TelemetrySeq = (UInt16)(e.Seq + 1);
+        for (int f = 0; f < TelemetryDesc.Length; f++)
+        {
+            if ((e.Mask & (1U << f)) == 0) continue;
+            int size = TelemetryDesc[f] & 7;
+            int n = ((TelemetryDesc[f] >> 3) & 7) + 1;
+            if ((TelemetryDesc[f] & 0x80) != 0) n *= e.Channels;
+            e.Values[f] = new Int32[n];
+            for (int k = 0; k < n && o + size <= 64; k++, o += size)
+            {
+                Int32 v = 0;
+                for (int b = size - 1; b >= 0; b--) v = (v << 8) | RXB[o + b];
+                if ((TelemetryDesc[f] & 0x40) != 0 && size < 4) v = (v << (32 - size * 8)) >> (32 - size * 8);
+                e.Values[f][k] = v;
+            }
+        }
+        TelemetryFrameReceived?.Invoke(this, e);
+    }
+
+    //Chunk of up to 14 words from byte 6 on at word offset bytes 1-2 of a capture of bytes 3-4 words
+    private void ProcessCapture(ref byte[] RXB)
+    {
+        int offset = BitConverter.ToUInt16(RXB, 1);
+        int len = BitConverter.ToUInt16(RXB, 3);
+        int n = Math.Min((int)RXB[5], 14);
+        if (CaptureData == null || CaptureData.Length != len || offset == 0 && CaptureMissing == 0)
+        {
+            CaptureData = new UInt32[len];
+            CaptureMissing = len;
+        }
+        for (int i = 0; i < n && offset + i < len; i++)
+        {
+            CaptureData[offset + i] = BitConverter.ToUInt32(RXB, 6 + i * 4);
+            CaptureMissing--;
+        }
+        if (offset + n >= len && CaptureMissing <= 0)
+        {
+            CaptureMissing = 0;
+            CaptureReceived?.Invoke(this, new CaptureReceivedEventData() { Data = CaptureData });
+        }
+    }
+
     private UInt16 CalculateCRC(ref byte[] data, int boff, int blen)
     {
         UInt16[] crc_table = {
@@ -1,43 +1,458 @@
 #define _EEP_C
 
+#include <GenericTypeDefs.h>
+#include "mcu.h"
 #include "isr.h"
+#include "EEP.h"
 
-void EEPWrite(UINT16 a, UINT8 * b, UINT16 c){
-    if(c){
-        while(EEPAddrW != 0xFFFF){};
-        EEPAddrW = a;
-        EEPDataW = b;
-        EEPCntW = c;
+static volatile int I2CCommands;         //pending commands, I2C_FLAGS
+static volatile int I2CCCommand;         //command on the bus, 0 if none
+
+//Commands with a deadline (the pot writes) run before the others, the earliest deadline first, and the EEPROM
+//transfers yield to them at the next byte. I2CDue is the core timer deadline of the pending command of each flag
+static volatile int I2CTimed;            //pending commands with a deadline
+static UINT32 I2CDue[I2C_CMDS];
+static int I2CCTimed;                   //the command on the bus has a deadline, I2CCDue
+static UINT32 I2CCDue;
+
+//Shadow of the pot and DAC registers, the values written by the last commands. The registers of I2CRegValid hold
+//the values of I2CReg, so a command sends only the registers which differ and I2CSetPots skips the commands that
+//would not change anything. A command which does not complete invalidates its registers
+enum I2C_REG{
+    I2C_REG_TCON,       //CPOT
+    I2C_REG_WIPER0,
+    I2C_REG_WIPER1,
+    I2C_REG_GAIN,       //GAINPOT
+    I2C_REG_OFFSET,     //OFFADC
+    I2C_REGS
+};
+#define I2C_CPOT_REGS ((1 << I2C_REG_TCON) | (1 << I2C_REG_WIPER0) | (1 << I2C_REG_WIPER1))
+static UINT16 I2CReg[I2C_REGS];
+static volatile int I2CRegValid;
+
+//Bytes of the pot command on the bus after the device address, built from the changed registers when it starts
+static UINT8 I2CTx[6];
+static int I2CTxN;
+static UINT8 I2CTxDev;
+
+static UINT32 I2CBusyT;                 //core timer when the bus became busy
+
+static t_EEPReq * volatile EEPHead;     //request in the I2C engine, 0 if none
+static t_EEPReq * volatile EEPTail;
+
+void I2CInit(){
+    I2CStep = 0;
+    I2CCommands = 0;
+    I2CCCommand = 0;
+    I2CTimed = 0;
+    I2CCTimed = 0;
+    I2CRegValid = 0;
+    I2CIdle = 1;
+    EEPAddrR = 0xFFFF;
+    EEPDataR = 0;
+    EEPCntR = 0;
+    EEPAddrW = 0xFFFF;
+    EEPDataW = 0;
+    EEPCntW = 0;
+    EEPHead = EEPTail = 0;
+}
+
+void I2CAddCommands(int c){
+    int i;
+    i=mcuDisableInterrupts();
+    I2CCommands |= c;
+    if(I2CIdle)mcuI2CWakeUp();
+    mcuRestoreInterrupts(i);
+}
+
+//Pot and DAC register values for I2CData, returns the mask of the registers which differ from the shadow
+static int I2CRegs(UINT16 * r){
+    int k, m = 0;
+    r[I2C_REG_TCON] = 0xFF;
+    if(I2CData.CurrentA.ui16 == 0) r[I2C_REG_TCON] &= 0xF0;       //disconnect R0A when currentA is 0
+    if(I2CData.CurrentA.ui16 >= 256) r[I2C_REG_TCON] &= 0xFE;     //disconnect R0B when currentA is MAX
+    if(I2CData.CurrentB.ui16 == 0) r[I2C_REG_TCON] &= 0x0F;       //disconnect R1A when currentB is 0
+    if(I2CData.CurrentB.ui16 >= 256) r[I2C_REG_TCON] &= 0xEF;     //disconnect R1B when currentB is MAX
+    r[I2C_REG_WIPER0] = I2CData.CurrentA.ui16;
+    r[I2C_REG_WIPER1] = I2CData.CurrentB.ui16;
+    r[I2C_REG_GAIN] = I2CData.Gain.ui16;
+    r[I2C_REG_OFFSET] = I2CData.Offset.ui16;
+    for(k = 0; k < I2C_REGS; k++){
+        if(!(I2CRegValid & (1 << k)) || (r[k] != I2CReg[k])) m |= 1 << k;
+    }
+    return m;
+}
+
+//Commands which write the registers of mask m
+static int I2CRegCommands(int m){
+    int c = 0;
+    if(m & I2C_CPOT_REGS) c |= I2C_SET_CPOT;
+    if(m & (1 << I2C_REG_GAIN)) c |= I2C_SET_GAINPOT;
+    if(m & (1 << I2C_REG_OFFSET)) c |= I2C_SET_OFFSET;
+    return c;
+}
+
+//Registers written by command c
+static int I2CCommandRegs(int c){
+    if(c == I2C_SET_CPOT) return I2C_CPOT_REGS;
+    if(c == I2C_SET_GAINPOT) return 1 << I2C_REG_GAIN;
+    if(c == I2C_SET_OFFSET) return 1 << I2C_REG_OFFSET;
+    return 0;
+}
+
+//Bytes of pot command c for the registers of I2CData which differ from the shadow, the shadow takes their values.
+//Returns the number of bytes, 0 if the device has all the values. Called with the interrupts disabled
+static int I2CLatch(int c){
+    UINT16 r[I2C_REGS];
+    int k, m = I2CRegs(r) & I2CCommandRegs(c);
+    I2CTxN = 0;
+    switch(c){
+        case I2C_SET_CPOT:
+            I2CTxDev = CPOT;
+            if(m & (1 << I2C_REG_TCON)){
+                I2CTx[I2CTxN++] = 0x40;                                 //write to TCON
+                I2CTx[I2CTxN++] = r[I2C_REG_TCON];
+            }
+            if(m & (1 << I2C_REG_WIPER0)){
+                I2CTx[I2CTxN++] = r[I2C_REG_WIPER0] >> 8;               //Wiper0
+                I2CTx[I2CTxN++] = r[I2C_REG_WIPER0] & 0xFF;
+            }
+            if(m & (1 << I2C_REG_WIPER1)){
+                I2CTx[I2CTxN++] = (r[I2C_REG_WIPER1] >> 8) | 0x10;      //Wiper1
+                I2CTx[I2CTxN++] = r[I2C_REG_WIPER1] & 0xFF;
+            }
+            break;
+        case I2C_SET_GAINPOT:
+            I2CTxDev = GAINPOT;
+            if(m){
+                I2CTx[I2CTxN++] = r[I2C_REG_GAIN] >> 8;
+                I2CTx[I2CTxN++] = r[I2C_REG_GAIN] & 0xFF;
+            }
+            break;
+        case I2C_SET_OFFSET:
+            I2CTxDev = OFFADC;
+            if(m){
+                I2CTx[I2CTxN++] = 0b01011000;
+                I2CTx[I2CTxN++] = r[I2C_REG_OFFSET] >> 2;
+                I2CTx[I2CTxN++] = (r[I2C_REG_OFFSET] << 6) & 0xFF;
+            }
+            break;
+    }
+    for(k = 0; k < I2C_REGS; k++){
+        if(m & (1 << k)) I2CReg[k] = r[k];
+    }
+    I2CRegValid |= m;
+    return I2CTxN;
+}
+
+//Queue the writes of the I2CData values the pots and the offset DAC do not have yet, to be complete by core timer due.
+//A pending write takes the latest values when it starts, so it is kept and gets the earlier deadline
+void I2CSetPots(UINT32 due){
+    UINT16 r[I2C_REGS];
+    int i, k, c;
+    i=mcuDisableInterrupts();
+    c = (I2CCommands & I2C_POTS) | I2CRegCommands(I2CRegs(r));
+    I2CStats.Skipped += 3 - ((c & 1) + ((c >> 1) & 1) + ((c >> 2) & 1));
+    for(k = 0; k < 3; k++){
+        if(!(c & (1 << k))) continue;
+        if(!(I2CTimed & (1 << k)) || ((INT32)(due - I2CDue[k]) < 0)) I2CDue[k] = due;
+    }
+    I2CTimed |= c;
+    I2CCommands |= c;
+    if(c && I2CIdle)mcuI2CWakeUp();
+    mcuRestoreInterrupts(i);
+}
+
+//Pending command to run next: the earliest deadline, then the lowest flag
+static int I2CNext(){
+    int c, k, best = 0, bk = 0;
+    for(k = 0, c = 1; k < I2C_CMDS; k++, c <<= 1){
+        if(!(I2CCommands & c)) continue;
+        if(!best || ((I2CTimed & c) && (!(I2CTimed & best) || ((INT32)(I2CDue[k] - I2CDue[bk]) < 0)))){
+            best = c;
+            bk = k;
+        }
+    }
+    return best;
+}
+
+//Command complete, a write with a deadline counts if it was late
+static void I2CDone(){
+    if(I2CCTimed && ((INT32)(mcuReadCoreTimer() - I2CCDue) > 0)) I2CStats.Late++;
+    I2CCTimed = 0;
+    I2CCCommand = 0;
+}
+
+
+static void EEPStart(t_EEPReq * R){
+    if(R->Write){
+        EEPAddrW = R->Addr;
+        EEPDataW = R->Data;
+        EEPCntW = R->Cnt;
         I2CAddCommands(I2C_EEPWRITE);
-        while(EEPAddrW != 0xFFFF){};
+    }
+    else{
+        EEPAddrR = R->Addr;
+        EEPDataR = R->Data;
+        EEPCntR = R->Cnt;
+        I2CAddCommands(I2C_EEPREAD);
     }
 }
 
+//Queue request R, returns at once (after the previous transfer of R if it is still busy)
+void EEPSubmit(t_EEPReq * R){
+    int i;
+    EEPWait(R);
+    R->Next = 0;
+    if(!R->Cnt){
+        if(R->Callback) R->Callback(R);
+        return;
+    }
+    R->Busy = 1;
+    i = mcuDisableInterrupts();
+    if(EEPHead){
+        EEPTail->Next = R;
+        EEPTail = R;
+    }
+    else{
+        EEPHead = EEPTail = R;
+        EEPStart(R);
+    }
+    mcuRestoreInterrupts(i);
+}
+
+//Wait until the transfer of R is complete
+void EEPWait(t_EEPReq * R){
+    while(R->Busy) mcuI2CIdle();
+}
+
+//1 while there are queued transfers, a write is complete when the EEPROM has finished its write cycle
+int EEPBusy(){
+    return EEPHead != 0;
+}
+
+//Transfer of the head request complete, called by I2CISRTasks
+void EEPISRDone(){
+    t_EEPReq * R = EEPHead;
+    if(!R) return;
+    EEPHead = R->Next;
+    if(EEPHead) EEPStart(EEPHead);
+    R->Busy = 0;
+    if(R->Callback) R->Callback(R);
+}
+
+void EEPWrite(UINT16 a, UINT8 * b, UINT16 c){
+    t_EEPReq R = {a, b, c, 1, 0, 0, 0};
+    EEPSubmit(&R);
+    EEPWait(&R);
+}
+
 void EEPWriteImm(UINT16 a, UINT8 b){
-        while(EEPAddrW != 0xFFFF){};
-        EEPAddrW = a;
-        EEPDataW = &b;
-        EEPCntW = 1;
-        I2CAddCommands(I2C_EEPWRITE);
-        while(EEPAddrW != 0xFFFF){};
+    EEPWrite(a, &b, 1);
 }
 
 UINT8 EEPRead(UINT16 a, UINT8 * b, UINT16 c){
     UINT8 lb;
     if(c){
+        t_EEPReq R = {a, b, c, 0, 0, 0, 0};
         if(b == 0){
-            b = &lb;
-            c = 1;
+            R.Data = b = &lb;
+            R.Cnt = c = 1;
         }
-        while(EEPAddrR != 0xFFFF);
-        EEPAddrR = a;
-        EEPDataR = b;
-        EEPCntR = c;
-        I2CAddCommands(I2C_EEPREAD);
-        while(EEPAddrR != 0xFFFF);
+        EEPSubmit(&R);
+        EEPWait(&R);
         return b[c-1];
     }
     return 0xFF;
 }
 
-#undef __EEP_C
+//Bus operations counted in I2CStats
+static void I2CStart(){
+    I2CStats.Starts++;
+    mcuI2CStart();
+}
+
+static void I2CSendByte(UINT8 b){
+    I2CStats.Bytes++;
+    mcuI2CSendByte(b);
+}
+
+static void I2CReceive(){
+    I2CStats.Bytes++;
+    mcuI2CReceiverEnable();
+}
+
+//Stop, and start the current EEPROM command again at the next interrupt. The EEPROM does not acknowledge its address
+//until its write cycle is over, so the restart polls for the end of the write cycle and continues with the next page
+//at once. Returns FALSE to yield the bus (the command is queued again) when a higher priority command is pending,
+//the pots and the DAC can be written during the write cycle
+static BOOL EEPPoll(){
+    if(I2CCommands & (I2CCCommand - 1)) return FALSE;
+    I2CStep = -1;
+    mcuI2CStop();
+    return TRUE;
+}
+
+void I2CISRTasks(){
+    
+    int i;
+    BOOL CmdOK;
+
+    if(I2CCCommand){
+        I2CStep++;
+    }
+    else{
+        I2CStep=0;
+        i=mcuDisableInterrupts();
+        while((I2CCCommand = I2CNext())){
+            I2CCommands -= I2CCCommand;
+            I2CCTimed = I2CTimed & I2CCCommand;
+            I2CTimed &= ~I2CCCommand;
+            I2CCDue = I2CDue[__builtin_ctz(I2CCCommand)];
+            if(!(I2CCCommand & I2C_POTS) || I2CLatch(I2CCCommand)) break;  //pot values latched with the interrupts disabled
+            I2CStats.Skipped++;             //the values have changed back since the write was queued
+        }
+        if(I2CCCommand){
+            I2CStats.Cmds++;
+            if(I2CIdle) I2CBusyT = mcuReadCoreTimer();
+            I2CIdle=0;
+        }
+        else{
+            if(!I2CIdle) I2CStats.BusyTicks += mcuReadCoreTimer() - I2CBusyT;
+            I2CIdle=1;
+        }
+        mcuRestoreInterrupts(i);
+    }
+    
+    CmdOK = TRUE;
+    switch(I2CCCommand){
+        case I2C_SET_CPOT:
+        case I2C_SET_GAINPOT:
+        case I2C_SET_OFFSET:
+            if(I2CStep == 0){
+                I2CStart();
+            }
+            else if(I2CStep == 1){
+                I2CSendByte(I2CTxDev);
+            }
+            else if(I2CStep - 2 < I2CTxN){
+                I2CSendByte(I2CTx[I2CStep - 2]);
+            }
+            else{
+                I2CDone();
+                mcuI2CStop();
+            }
+            break;
+        case I2C_EEPWRITE:
+            switch(I2CStep){
+                case 0:
+                    I2CStart();
+                    break;
+                case 1:
+                    I2CSendByte(EEP);
+                    break;
+                case 2:
+                    if(!mcuI2CIsACK()){                     //write cycle of the previous page is not over - poll again
+                        I2CStats.Polls++;
+                        CmdOK = EEPPoll();
+                    }
+                    else if(EEPCntW){
+                        I2CSendByte(EEPAddrW >> 8);
+                    }
+                    else{                                   //last page is written
+                        EEPAddrW=0xFFFF;
+                        I2CCCommand=0;
+                        mcuI2CStop();
+                        EEPISRDone();
+                    }
+                    break;
+                case 3:
+                    I2CSendByte(EEPAddrW & 0xFF);
+                    break;
+                case 4:
+                    I2CSendByte(*EEPDataW);
+                    break;
+                case 5:
+                    EEPCntW--;
+                    EEPDataW++;
+                    EEPAddrW++;
+                    if(EEPCntW && (EEPAddrW & (EEP_PAGE - 1)) && !(I2CCommands & (I2CCCommand - 1))){
+                        I2CStep = 4;
+                        I2CSendByte(*EEPDataW);
+                    }
+                    else{                                   //page boundary, last byte or pending higher priority command:
+                        CmdOK = EEPPoll();                  //the stop starts the write cycle, then poll for its end
+                    }
+                    break;
+            }
+            break;
+        case I2C_EEPREAD:
+            switch(I2CStep){
+                case 0:
+                    I2CStart();
+                    break;
+                case 1:
+                    I2CSendByte(EEP);
+                    break;
+                case 2:
+                    if(!mcuI2CIsACK()){
+                        I2CStats.Polls++;
+                        CmdOK = EEPPoll();
+                    }
+                    else I2CSendByte(EEPAddrR >> 8);
+                    break;
+                case 3:
+                    I2CSendByte(EEPAddrR & 0xFF);
+                    break;
+                case 4:
+                    I2CStart();
+                    break;
+                case 5:
+                    I2CSendByte(EEP | 1);
+                    break;
+                case 6:
+                    I2CReceive();
+                    break;
+                case 7:
+                    *EEPDataR = mcuI2CGetByte();
+                    EEPCntR--;
+                    if(EEPCntR){
+                        EEPDataR++;
+                        EEPAddrR++;
+                        if(I2CCommands & (I2CCCommand - 1)){  //Abort if there is pending higher priority command, sequential reads cross the pages
+                            mcuI2CReceiverDisable();
+                            CmdOK = FALSE;                            
+                        }
+                        else{
+                            mcuI2CACK();
+                            I2CStep = 5;
+                        }
+                    }
+                    else{
+                        mcuI2CReceiverDisable();
+                        EEPAddrR = 0xFFFF;
+                        I2CCCommand=0;
+                        mcuI2CStop();
+                        EEPISRDone();
+                    }
+                    break;
+            }
+            break;
+        default:
+            I2CCCommand=0;
+            break;
+    }
+    if(CmdOK == FALSE){
+        I2CRegValid &= ~I2CCommandRegs(I2CCCommand);
+        if(I2CCTimed){
+            I2CDue[__builtin_ctz(I2CCCommand)] = I2CCDue;
+            I2CTimed |= I2CCCommand;
+            I2CCTimed = 0;
+        }
+        I2CCommands |= I2CCCommand;
+        I2CCCommand=0;
+        mcuI2CStop();
+    }    
+}
+
+#undef _EEP_C
@@ -12,12 +12,32 @@
 extern "C" {
 #endif
 
+#define EEP_PAGE 32     //24LC64 page size, the I2C engine splits writes at page boundaries
+
+//Asynchronous EEPROM transfer. The caller owns the request and the data until Busy is cleared, requests are served in order
+//by the I2C interrupt
+typedef struct t_EEPReq {
+    UINT16 Addr;
+    UINT8 * Data;
+    UINT16 Cnt;
+    UINT8 Write;                                //1 - write Data to the EEPROM, 0 - read into Data
+    volatile UINT8 Busy;                        //set by EEPSubmit, cleared when the transfer is complete
+    void (*Callback)(struct t_EEPReq * R);      //called from the I2C interrupt when the transfer is complete, may be 0
+    struct t_EEPReq * volatile Next;
+} t_EEPReq;
+
 #ifndef _EEP_C
 #define EEP_EXTERN extern
 #else
 #define EEP_EXTERN
 #endif
 
+EEP_EXTERN void EEPSubmit(t_EEPReq * R);
+EEP_EXTERN void EEPWait(t_EEPReq * R);
+EEP_EXTERN int EEPBusy();
+EEP_EXTERN void EEPISRDone();
+
+//blocking transfers, for the power-up
 EEP_EXTERN void EEPWrite(UINT16 a, UINT8 * b, UINT16 c);
 EEP_EXTERN void EEPWriteImm(UINT16 a, UINT8 b);
 EEP_EXTERN UINT8 EEPRead(UINT16 a, UINT8 * b, UINT16 c);
@@ -1,12 +1,12 @@
 #define _OLED_C
 
+#include <string.h>
 #include "main.h"
 #include "mcu.h"
-#include "font32x48numbers.h"
 #include "fonts.h"
 #include "font6x8.h"
-#include "font8x16.h"
 #include "OLED.h"
+#include "fontspacked.h"
 
 #define CmdNOP 0xE3
 #define CmdRot0 0xC0A0
@@ -17,6 +17,10 @@
 
 volatile displaysetup_t DisplaySetup = {0, 0};
 
+const t_OLEDFont OLEDFont68 = {(const UINT8 *)font6x8, 0, 32, 5, 1, 1};
+const t_OLEDFont OLEDFont88 = {(const UINT8 *)font8x8, 0, 0, 8, 1, 0};
+const t_OLEDFont OLEDFont816 = {0, &font8x16Packed, 0, 8, 2, 0};
+
 const unsigned char OLEDInitBuff1[]={
     0xAE,       //display control ([AE] OFF, AF ON)
     0xD5,0x80,  //set clock & divide ratio [50]
@@ -43,21 +47,43 @@ typedef union {
             UINT8 Bri;
             UINT16 Rot;
         } PreDisplayUpdate;
-        struct __PACKED{
-            UINT8 Row;
-            UINT8 ColHi;
-            UINT8 ColLow;
-        } PreRowUpdate;
     };
 }preUpdate_t;
 
-preUpdate_t PreUpdateBuff = {
-    CmdBri, 225,
-    CmdRot0,
-    0xB0,
-    0x10,
-    0
-};
+preUpdate_t PreUpdateBuff = {{
+    {CmdBri, 225,
+    CmdRot0}
+}};
+
+//A frame goes out as segments of commands (D/C low) or display data (D/C high): the brightness and rotation,
+//then the page and column address and the changed columns of each page, sent from the front frame
+typedef struct {
+    const UINT8 * Buf;
+    UINT8 Len;
+    UINT8 DC;
+}t_OLEDSeg;
+
+static t_OLEDSeg OLEDSeg[1 + 8 * 2];
+static int OLEDSegCnt;
+static volatile int OLEDSegPos;
+static volatile int OLEDBusy;   //DMA transfer of a frame in progress
+static UINT8 RowCmd[8][3];
+
+//OLEDBUFF is the back frame the drawing goes to, the front one has what the panel shows once it is sent
+static t_OLEDFrame OLEDFrames[2];
+t_OLEDFrame * OLEDBack = &OLEDFrames[0];
+static t_OLEDFrame * OLEDFront = &OLEDFrames[1];
+
+static UINT8 ColShift;          //column of the first pixel in the controller RAM
+static int PreSent;             //brightness and rotation of PreDisplayUpdate are the display ones
+
+void OLEDMark(int col, int colnum, int row, int rownum){
+    while(rownum--){
+        if(col < OLEDDirty[row].L) OLEDDirty[row].L = col;
+        if(col + colnum > OLEDDirty[row].R) OLEDDirty[row].R = col + colnum;
+        row++;
+    }
+}
 
 void OLEDInit(){
     mcuSPIClose();
@@ -116,52 +142,112 @@ void OLEDInit(){
     mcuSPISendBytes((unsigned int*)OLEDInitBuff1, sizeof(OLEDInitBuff1));
     mcuSPIWait();
     if(DisplaySetup.SH1106){
-        PreUpdateBuff.PreRowUpdate.ColLow = 2; //SSH1106 is 131x64 - shift right by 2
+        ColShift = 2; //SSH1106 is 131x64 - shift right by 2
         mcuSPISendByte(0xAD); //charge pump control       
         mcuSPISendByte(DisplaySetup.InternalChargePump ? 0x8B : 0x8A);
     }
     else{
-        PreUpdateBuff.PreRowUpdate.ColLow = 0; //SSD1306 is 128x64 - no need to shift
+        ColShift = 0; //SSD1306 is 128x64 - no need to shift
         mcuSPISendByte(0x8D); //charge pump control       
         mcuSPISendByte(DisplaySetup.InternalChargePump ? 0x14 : 0x10);        
     }
     mcuSPIWait();
     mcuSPISendBytes((unsigned int*)OLEDInitBuff2, sizeof(OLEDInitBuff2));     
 
+    PreSent = 0;
     OLEDFill(0, 128, 0, 8, 0);
+    OLEDMark(0, 128, 0, 8);
     OLEDUpdate();
 }
 
-//void OLEDUpdateDMA(){
-//    mcuSPIWait();
-//    mcuSPIStop();
-//    PreUpdateBuff.PreDisplayUpdate.Bri = (pars.Bri << 4) - 15;
-//    PreUpdateBuff.PreDisplayUpdate.Rot = pars.DispRot ? CmdRot180 : CmdRot0;
-//    OLED_DC = 0;
-//    OLED_CS = 0;
-//    mcuSPISendBytes((int*)&PreUpdateBuff, sizeof(PreUpdateBuff));
-//    mcuSPIWait();    
-//    OLED_DC = 1;
-//    mcuSPISendAuto(OLEDBUFF.B[0],128*8);
-//}
+static void OLEDAddSeg(const void * buf, int len, int dc){
+    OLEDSeg[OLEDSegCnt].Buf = buf;
+    OLEDSeg[OLEDSegCnt].Len = len;
+    OLEDSeg[OLEDSegCnt].DC = dc;
+    OLEDSegCnt++;
+}
 
+static void OLEDStartSeg(){
+    t_OLEDSeg * S = &OLEDSeg[OLEDSegPos];
+    OLED_DC = S->DC;
+    OLED_CS = 0;
+    mcuSPIStartAuto((void *)S->Buf, S->Len);
+}
+
+//DMA block done: D/C may change only once the last byte has left the shift register, which takes at most
+//two byte times after the DMA wrote it
+void OLEDDMATasks(){
+    mcuSPIWait();
+    if(++OLEDSegPos < OLEDSegCnt){
+        OLEDStartSeg();
+    }
+    else{
+        OLEDBusy = 0;
+    }
+}
+
+//Widen the span of page r to the columns which differ between the back and the front frame, compared a word at a time
+static void OLEDDiff(int r){
+    const UINT32 * b = OLEDBack->D[r], * f = OLEDFront->D[r];
+    int l = 0, h = 32;
+    while(l < h && b[l] == f[l]) l++;
+    if(l == h) return;
+    while(b[h - 1] == f[h - 1]) h--;
+    l <<= 2;
+    h <<= 2;
+    while(OLEDBack->B[r][l] == OLEDFront->B[r][l]) l++;
+    while(OLEDBack->B[r][h - 1] == OLEDFront->B[r][h - 1]) h--;
+    OLEDMark(l, h - l, r, 1);
+}
+
+//Swap the frames and send the brightness and rotation if they changed and the columns of each page which differ from
+//the previous frame or were marked, on DMA once SPIAuto is set. Waits only if the previous frame is still going out.
+//The sent columns are copied to the new back frame, so drawing goes on from the frame just sent
 void OLEDUpdate(){
-    UINT8 r;
+    UINT8 r, c;
+    UINT8 bri = (pars.Bri << 4) - 15;
+    UINT16 rot = pars.DispRot ? CmdRot180 : CmdRot0;
+    t_OLEDFrame * F;
+    while(OLEDBusy);
     mcuSPIWait();
-    OLED_DC = 0;
-    OLED_CS = 0;
-    PreUpdateBuff.PreDisplayUpdate.Bri = (pars.Bri << 4) - 15;
-    PreUpdateBuff.PreDisplayUpdate.Rot = pars.DispRot ? CmdRot180 : CmdRot0;
-    mcuSPISendBytes((unsigned int*)&PreUpdateBuff.PreDisplayUpdate, sizeof(PreUpdateBuff.PreDisplayUpdate) );    
+    for(r = 0; r <= 7; r++) OLEDDiff(r);
+    F = OLEDFront;
+    OLEDFront = OLEDBack;
+    OLEDBack = F;
+    OLEDSegCnt = 0;
+    if(!PreSent || PreUpdateBuff.PreDisplayUpdate.Bri != bri || PreUpdateBuff.PreDisplayUpdate.Rot != rot){
+        if(PreUpdateBuff.PreDisplayUpdate.Rot != rot) OLEDMark(0, 128, 0, 8); //the column remap applies to the data written after it
+        PreUpdateBuff.PreDisplayUpdate.Bri = bri;
+        PreUpdateBuff.PreDisplayUpdate.Rot = rot;
+        PreSent = 1;
+        OLEDAddSeg(&PreUpdateBuff.PreDisplayUpdate, sizeof(PreUpdateBuff.PreDisplayUpdate), 0);
+    }
     for(r=0;r<=7;r++ ){
-        PreUpdateBuff.PreRowUpdate.Row = 0xB0+r;
-        mcuSPIWait();       
-        OLED_DC = 0;
-        OLED_CS = 0;
-        mcuSPISendBytes((unsigned int*)&PreUpdateBuff.PreRowUpdate, sizeof(PreUpdateBuff.PreRowUpdate));
+        UINT8 l = OLEDDirty[r].L, n;
+        if(l >= OLEDDirty[r].R) continue;
+        n = OLEDDirty[r].R - l;
+        c = l + ColShift;
+        RowCmd[r][0] = 0xB0+r;
+        RowCmd[r][1] = 0x10 | (c >> 4);
+        RowCmd[r][2] = c & 15;
+        memcpy(&OLEDBack->B[r][l], &OLEDFront->B[r][l], n);
+        OLEDAddSeg(RowCmd[r], 3, 0);
+        OLEDAddSeg(&OLEDFront->B[r][l], n, 1);
+        OLEDDirty[r].L = 128;
+        OLEDDirty[r].R = 0;
+    }
+    if(!OLEDSegCnt) return;
+    OLEDSegPos = 0;
+    if(SPIAuto){
+        OLEDBusy = 1;
+        OLEDStartSeg();
+        return;
+    }
+    for(; OLEDSegPos < OLEDSegCnt; OLEDSegPos++){
         mcuSPIWait();
-        OLED_DC = 1;    
-        mcuSPISendBytes((unsigned int*)OLEDBUFF.B[r], 128 );
+        OLED_DC = OLEDSeg[OLEDSegPos].DC;
+        OLED_CS = 0;
+        mcuSPISendBytes((unsigned int*)OLEDSeg[OLEDSegPos].Buf, OLEDSeg[OLEDSegPos].Len);
     }
 }
 
@@ -188,7 +274,7 @@ void OLEDFillXY(int x, int dx, int y, int dy, int b){
             while(cc--)OLEDBUFF.B[y >> 3][cx++] |= mask;
         }
         else{
-            mask = !mask;
+            mask = ~mask;
             while(cc--)OLEDBUFF.B[y >> 3][cx++] &= mask;
         }
         dy -= rowL;
@@ -233,8 +319,41 @@ void OLEDWrite(int col, int colnum, int row, void * buf, int num){
     }
 }
 
+//Glyph of up to 3 pages at any y followed by blank columns: each column is gathered into one word, shifted
+//once and merged into every page it covers with a single read-modify-write, clipped at the bottom page
+static void OLEDBlitXY(int x, int y, const UINT8 * g, int width, int height, int blank){
+    if(height > 3){
+        if(width) OLEDWriteXY(x, width, y, (void *)g, width * height);
+        OLEDFillXY(x + width, blank, y, height << 3, 0);
+        return;
+    }
+    int s = y & 7;
+    int pages = (s + (height << 3) + 7) >> 3;
+    if(pages > 8 - (y >> 3)) pages = 8 - (y >> 3);
+    UINT32 m = (0xFFFFFFFFUL >> (32 - (height << 3))) << s;
+    UINT8 m0 = ~m, m1 = ~(m >> 8), m2 = ~(m >> 16), m3 = ~(m >> 24);
+    const UINT8 * g1 = g + width;
+    const UINT8 * g2 = g1 + width;
+    UINT8 * d = &OLEDBUFF.B[y >> 3][x];
+    int c;
+    for(c = 0; c < width + blank; c++){
+        UINT32 w = 0;
+        if(c < width){
+            w = g[c];
+            if(height > 1) w |= (UINT32)g1[c] << 8;
+            if(height > 2) w |= (UINT32)g2[c] << 16;
+            w <<= s;
+        }
+        d[c] = (d[c] & m0) | w;
+        if(pages > 1) d[c + 128] = (d[c + 128] & m1) | (w >> 8);
+        if(pages > 2) d[c + 256] = (d[c + 256] & m2) | (w >> 16);
+        if(pages > 3) d[c + 384] = (d[c + 384] & m3) | (w >> 24);
+    }
+}
+
 void OLEDWriteXY(int x, int colnum, int y, void * buf, int num){
     if(!(y & 7)) return OLEDWrite(x, colnum, y >> 3, buf, num );    
+    if(num <= 3 * colnum && !(num % colnum)) return OLEDBlitXY(x, y, buf, colnum, num / colnum, 0);
     int row70 = y & 7;
     int row71 = 8 - row70;
     UINT8 mask0 = 0xFF >> row71;
@@ -262,6 +381,53 @@ void OLEDWriteXY(int x, int colnum, int y, void * buf, int num){
 }
 
 
+//Decodes rownum pages of glyph g of P to d, the pages stride bytes apart, and keeps the first colnum columns
+static void OLEDUnpack(const t_OLEDPacked * P, int g, UINT8 * d, int stride, int colnum, int rownum){
+    const UINT8 * s = &P->Data[P->Base[g >> P->Shift] + P->Offs[g]];
+    UINT8 codes = 0, b = 0;
+    int c, n = 0;
+    while(rownum--){
+        for(c = 0; c < P->Width; c++, codes >>= 2){
+            if(!(n++ & 3)) codes = *s++;
+            switch(codes & 3){
+                case 0: b = 0; break;
+                case 1: b = 0xFF; break;
+                case 3: b = *s++; break;
+            }
+            if(c < colnum) d[c] = b;
+        }
+        d += stride;
+    }
+}
+
+void OLEDWritePacked(int col, int colnum, int row, int rownum, const t_OLEDPacked * P, int g){
+    OLEDUnpack(P, g, &OLEDBUFF.B[row][col], 128, colnum, rownum);
+}
+
+//Character c and its blank columns at a page
+static void OLEDChar(int col, int row, const t_OLEDFont * font, int c){
+    if(font->Raw){
+        OLEDWrite(col, font->Width, row, (void *)&font->Raw[font->Width * font->Height * (c - font->Start)], font->Width * font->Height);
+    }
+    else{
+        OLEDWritePacked(col, font->Width, row, font->Height, font->Packed, c - font->Start);
+    }
+    OLEDFill(col + font->Width, font->Blank, row, font->Height, 0);
+}
+
+//Character c and its blank columns at a pixel row, a packed glyph is decoded first
+static void OLEDCharXY(int x, int y, const t_OLEDFont * font, int c){
+    UINT8 buf[OLED_GLYPH_MAX];
+    const UINT8 * g = buf;
+    if(font->Raw){
+        g = &font->Raw[font->Width * font->Height * (c - font->Start)];
+    }
+    else{
+        OLEDUnpack(font->Packed, c - font->Start, buf, font->Width, font->Width, font->Height);
+    }
+    OLEDBlitXY(x, y, g, font->Width, font->Height, font->Blank);
+}
+
 void OLEDPrintNum3248(int col, int row, int num){
     int i, cd;
     col += 64;
@@ -270,7 +436,7 @@ void OLEDPrintNum3248(int col, int row, int num){
         cd = num % 10;
         num /= 10;
         if(num || cd || (i>1)) {
-            OLEDWrite(col, 32, row, (void *)numbers32x48[cd],192);
+            OLEDWritePacked(col, 32, row, 6, &numbers32x48Packed, cd);
         }
         else{
             OLEDFill(col, 32, row, 6, 0);
@@ -279,17 +445,11 @@ void OLEDPrintNum3248(int col, int row, int num){
     }
 }
 void OLEDPrintCF1648(int col, int row, int CF){
-    CF+=10;
-    OLEDWrite(col, 16, row++, (void *)&numbers32x48[CF][0],16);
-    OLEDWrite(col, 16, row++, (void *)&numbers32x48[CF][32],16);
-    OLEDWrite(col, 16, row++, (void *)&numbers32x48[CF][64],16);
-    OLEDWrite(col, 16, row++, (void *)&numbers32x48[CF][96],16);
-    OLEDWrite(col, 16, row++, (void *)&numbers32x48[CF][128],16);
+    OLEDWritePacked(col, 16, row, 5, &numbers32x48Packed, CF + 10);
 }
 
-void OLEDPrintNum(int col, int row, int dec, int num, void * font, int startChar, int width, int height, int blank ){    
-    int cb = width * height;
-    int cw = width + blank;
+void OLEDPrintNum(int col, int row, int dec, int num, const t_OLEDFont * font){
+    int cw = font->Width + font->Blank;
     int i, cd;
     int minus=0;
     if(num<0){
@@ -299,31 +459,27 @@ void OLEDPrintNum(int col, int row, int dec, int num, void * font, int startChar
     i = dec;
     dec--;
     col += cw * dec;
-    if(num < 0) num =- num;
     while(i--){
         cd = num % 10;
         num /= 10;
         if(num || cd || (i == dec)) {
-            OLEDWrite(col, width, row, &((char *)font)[cb * (cd + 0x30 - startChar)], cb);
-            OLEDFill(col + width, blank, row, height, 0);
+            OLEDChar(col, row, font, cd + 0x30);
         }
         else{
             if(minus){
-                OLEDWrite(col, width, row, &((char *)font)[cb * ('-' - startChar)], cb);
-                OLEDFill(col + width, blank, row, height, 0);
+                OLEDChar(col, row, font, '-');
                 minus=0;
             }
             else{
-                OLEDFill(col, cw, row, height, 0);
+                OLEDFill(col, cw, row, font->Height, 0);
             }
         }
         col -= cw;
     }
 }
 
-void OLEDPrintNumXY(int x, int y, int dec, int num, void* font, int startChar, int width, int height, int blank ){    
-    int cb = width * height;
-    int cw = width + blank;
+void OLEDPrintNumXY(int x, int y, int dec, int num, const t_OLEDFont * font){
+    int cw = font->Width + font->Blank;
     int i, cd;
     int minus=0;
     if(num<0){
@@ -333,66 +489,54 @@ void OLEDPrintNumXY(int x, int y, int dec, int num, void* font, int startChar, i
     i = dec;
     dec--;
     x += cw * dec;
-    if(num < 0) num =- num;
     while(i--){
         cd = num % 10;
         num /= 10;
         if(num || cd || (i == dec)) {
-            OLEDWriteXY(x, width, y, &((char*)font)[cb * (cd + 0x30 - startChar)], cb);
-            OLEDFillXY(x + width, blank, y, height << 3, 0);
+            OLEDCharXY(x, y, font, cd + 0x30);
         }
         else{
             if(minus){
-                OLEDWrite(x, width, y, &((char *)font)[cb * ('-' - startChar)], cb);
-                OLEDFill(x + width, blank, y, height << 3, 0);
+                OLEDCharXY(x, y, font, '-');
                 minus=0;
             }
             else{
-                OLEDFill(x, cw, y, height<<3, 0);
+                OLEDBlitXY(x, y, 0, 0, font->Height, cw);
             }
         }
         x -= cw;
     }
 }
-void OLEDPrintHex(int col, int row, int dec, unsigned int num, void* font, int startChar, int width, int height, int blank ){    
-    int cb = width * height;
-    int cw = width + blank;
+void OLEDPrintHex(int col, int row, int dec, unsigned int num, const t_OLEDFont * font){
+    int cw = font->Width + font->Blank;
     unsigned int i, cd;
     i = dec;
     dec--;
     col += cw * dec;
-    if(num<0)num=-num;
     while(i--){
         cd = num & 15;
         num >>= 4;
-        OLEDWrite(col, width, row, &((char*)font)[cb * (cd + (cd <= 9 ? 0x30 : 0x37) - startChar)], cb);
-        OLEDFill(col + width, blank, row, height, 0);
+        OLEDChar(col, row, font, cd + (cd <= 9 ? 0x30 : 0x37));
         col -= cw;
     }
 }
 
-void OLEDPrint(int col, int row, const char * s, int num, void * font, int startChar, int width, int height, int blank){
-    int cb = width * height;
+void OLEDPrint(int col, int row, const char * s, int num, const t_OLEDFont * font){
     if(num == 0) num = 128;
     while(num--){
         if(s[0] == 0) break;
-        OLEDWrite(col, width, row, &((char *)font)[cb * (s[0] - startChar)], cb);
-        col += width;
-        OLEDFill(col, blank, row, height, 0);
-        col += blank;
+        OLEDChar(col, row, font, s[0]);
+        col += font->Width + font->Blank;
         s++;
     }
 }
 
-void OLEDPrintXY(int x, int y, const char * s, int num, void * font, int startChar, int width, int height, int blank){
-    int cb = width * height;
+void OLEDPrintXY(int x, int y, const char * s, int num, const t_OLEDFont * font){
     if(num == 0) num = 128;
     while(num--){
         if(s[0] == 0) break;
-        OLEDWriteXY(x, width, y, &((char *)font)[cb * (s[0] - startChar)], cb);
-        x += width;
-        OLEDFillXY(x, blank, y, height << 3, 0);
-        x += blank;
+        OLEDCharXY(x, y, font, s[0]);
+        x += font->Width + font->Blank;
         s++;
     }
 }
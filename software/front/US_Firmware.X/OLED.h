@@ -19,6 +19,31 @@ typedef struct __PACKED{
     int InternalChargePump:1;
 }displaysetup_t;
 
+//Bitmaps packed by US_Simulator/fontpack into fontspacked.h: every glyph byte is a 2-bit code, four codes to a
+//code byte from the low bits up, each code byte followed by the literals its codes need: 0 - 0x00, 1 - 0xFF,
+//2 - the byte before again, 3 - the next literal. Glyph g starts at Data[Base[g >> Shift] + Offs[g]].
+typedef struct {
+    UINT8 Width;                //glyph columns
+    UINT8 Height;               //glyph pages
+    UINT8 Shift;
+    const UINT16 * Base;
+    const UINT8 * Offs;
+    const UINT8 * Data;
+}t_OLEDPacked;
+
+#define OLED_GLYPH_MAX 48       //largest glyph of a packed print font, in bytes
+
+//Font of the print functions: characters from Start of Width columns and Height pages, each followed by Blank
+//empty columns, read from Raw or decoded from Packed
+typedef struct {
+    const UINT8 * Raw;
+    const t_OLEDPacked * Packed;
+    UINT8 Start;
+    UINT8 Width;
+    UINT8 Height;
+    UINT8 Blank;
+}t_OLEDFont;
+
 #ifndef _OLED_C
 #define OLEDC_EXTERN extern
 
@@ -27,50 +52,67 @@ extern volatile displaysetup_t DisplaySetup;
 extern const UINT8 font8x8[128][8];
 extern const UINT8 font6x8[96][5];
 extern const UINT8 degrees4x8[4];
-extern const UINT8 font8x16[128][16];
 extern const UINT8 degrees4x16[8];
+extern const t_OLEDPacked numbers32x48Packed;
+extern const t_OLEDPacked font8x16Packed;
+extern const t_OLEDPacked logoPacked;
+extern const t_OLEDFont OLEDFont68;
+extern const t_OLEDFont OLEDFont88;
+extern const t_OLEDFont OLEDFont816;
 #else
 #define OLEDC_EXTERN
 #endif
 
 
-OLEDC_EXTERN union {
+typedef union {
     UINT32 D[8][32];
     UINT8 B[8][128];
-}OLEDBUFF;
+}t_OLEDFrame;
+
+OLEDC_EXTERN t_OLEDFrame * OLEDBack;
+#define OLEDBUFF (*OLEDBack)
+
+//Columns L to R - 1 of each page the next OLEDUpdate sends besides the ones which changed, none if L >= R
+OLEDC_EXTERN struct {
+    UINT8 L;
+    UINT8 R;
+}OLEDDirty[8];
 
 OLEDC_EXTERN void OLEDInit();
 OLEDC_EXTERN void OLEDUpdate();
+OLEDC_EXTERN void OLEDDMATasks();
+OLEDC_EXTERN void OLEDMark(int col, int colnum, int row, int rownum);
 OLEDC_EXTERN void OLEDInvert(int col,int colnum, int row, int rownum);
 OLEDC_EXTERN void OLEDInvertXY(int x, int dx, int y, int dy);
 OLEDC_EXTERN void OLEDFill(int col, int colnum, int row, int rownum, UINT8 b);
 OLEDC_EXTERN void OLEDFillXY(int x, int dx, int y, int dy, int b);
 OLEDC_EXTERN void OLEDWrite(int col, int colnum, int row, void * buf, int num);
 OLEDC_EXTERN void OLEDWriteXY(int x, int colnum, int y, void * buf, int num);
+OLEDC_EXTERN void OLEDWritePacked(int col, int colnum, int row, int rownum, const t_OLEDPacked * P, int g);
 OLEDC_EXTERN void OLEDPrintNum3248(int col, int row, int num);
 OLEDC_EXTERN void OLEDPrintCF1648(int col, int row, int CF);
-OLEDC_EXTERN void OLEDPrintNum(int col, int row, int dec, int num, void* font, int startChar, int width, int height, int blank );
-OLEDC_EXTERN void OLEDPrintNumXY(int x, int y, int dec, int num, void* font, int startChar, int width, int height, int blank );
-OLEDC_EXTERN void OLEDPrintHex(int col, int row, int dec, unsigned int num, void* font, int startChar, int width, int height, int blank );
-OLEDC_EXTERN void OLEDPrint(int col, int row, const char * s, int num, void * font, int startChar, int width, int height, int blank);
-OLEDC_EXTERN void OLEDPrintXY(int col, int row, const char * s, int num, void * font, int startChar, int width, int height, int blank);
-
-
-#define OLEDPrint68(col, row, s, num) OLEDPrint(col, row, s, num, font6x8, 32, 5, 1, 1)
-#define OLEDPrintXY68(x, y, s, num) OLEDPrintXY(x, y, s, num, font6x8, 32, 5, 1, 1)
-#define OLEDPrintNum68(col, row, dec, num) OLEDPrintNum(col, row, dec, num, font6x8, 32, 5, 1, 1)
-#define OLEDPrintNumXY68(x, y, dec, num) OLEDPrintNumXY(x, y, dec, num, font6x8, 32, 5, 1, 1)
-#define OLEDPrintHex68(col, row, dec, num) OLEDPrintHex(col, row, dec, num, font6x8, 32, 5, 1, 1)
-#define OLEDPrint88(col, row, s, num) OLEDPrint(col, row, s, num, font8x8, 0, 8, 1, 0)
-#define OLEDPrintXY88(x, y, s, num) OLEDPrintXY(x, y, s, num, font8x8, 0, 8, 1, 0)
-#define OLEDPrintNum88(col, row, dec, num) OLEDPrintNum(col, row, dec, num, font8x8, 0, 8, 1, 0)
-#define OLEDPrintNumXY88(x, y, dec, num) OLEDPrintNumXY(x, y, dec, num, font8x8, 0, 8, 1, 0)
-#define OLEDPrintHex88(col, row, dec, num) OLEDPrintHex(col, row, dec, num, font8x8, 0, 8, 1, 0)
-#define OLEDPrint816(col, row, s, num) OLEDPrint(col, row, s, num, font8x16, 0, 8, 2, 0)
-#define OLEDPrintXY816(col, row, s, num) OLEDPrintXY(col, row, s, num, font8x16, 0, 8, 2, 0)
-#define OLEDPrintNum816(col, row, dec, num) OLEDPrintNum(col, row, dec, num, font8x16, 0, 8, 2, 0)
-#define OLEDPrintNumXY816(x, y, dec, num) OLEDPrintNumXY(x, y, dec, num, font8x16, 0, 8, 2, 0)
-#define OLEDPrintHex816(col, row, dec, num) OLEDPrintHEX(col, row, dec, num, font8x16, 0, 8, 2, 0)
+OLEDC_EXTERN void OLEDPrintNum(int col, int row, int dec, int num, const t_OLEDFont * font);
+OLEDC_EXTERN void OLEDPrintNumXY(int x, int y, int dec, int num, const t_OLEDFont * font);
+OLEDC_EXTERN void OLEDPrintHex(int col, int row, int dec, unsigned int num, const t_OLEDFont * font);
+OLEDC_EXTERN void OLEDPrint(int col, int row, const char * s, int num, const t_OLEDFont * font);
+OLEDC_EXTERN void OLEDPrintXY(int x, int y, const char * s, int num, const t_OLEDFont * font);
+
+
+#define OLEDPrint68(col, row, s, num) OLEDPrint(col, row, s, num, &OLEDFont68)
+#define OLEDPrintXY68(x, y, s, num) OLEDPrintXY(x, y, s, num, &OLEDFont68)
+#define OLEDPrintNum68(col, row, dec, num) OLEDPrintNum(col, row, dec, num, &OLEDFont68)
+#define OLEDPrintNumXY68(x, y, dec, num) OLEDPrintNumXY(x, y, dec, num, &OLEDFont68)
+#define OLEDPrintHex68(col, row, dec, num) OLEDPrintHex(col, row, dec, num, &OLEDFont68)
+#define OLEDPrint88(col, row, s, num) OLEDPrint(col, row, s, num, &OLEDFont88)
+#define OLEDPrintXY88(x, y, s, num) OLEDPrintXY(x, y, s, num, &OLEDFont88)
+#define OLEDPrintNum88(col, row, dec, num) OLEDPrintNum(col, row, dec, num, &OLEDFont88)
+#define OLEDPrintNumXY88(x, y, dec, num) OLEDPrintNumXY(x, y, dec, num, &OLEDFont88)
+#define OLEDPrintHex88(col, row, dec, num) OLEDPrintHex(col, row, dec, num, &OLEDFont88)
+#define OLEDPrint816(col, row, s, num) OLEDPrint(col, row, s, num, &OLEDFont816)
+#define OLEDPrintXY816(col, row, s, num) OLEDPrintXY(col, row, s, num, &OLEDFont816)
+#define OLEDPrintNum816(col, row, dec, num) OLEDPrintNum(col, row, dec, num, &OLEDFont816)
+#define OLEDPrintNumXY816(x, y, dec, num) OLEDPrintNumXY(x, y, dec, num, &OLEDFont816)
+#define OLEDPrintHex816(col, row, dec, num) OLEDPrintHex(col, row, dec, num, &OLEDFont816)
 
 #undef OLEDC_EXTERN
 
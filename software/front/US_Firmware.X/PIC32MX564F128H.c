@@ -193,6 +193,18 @@ void mcuInit4(){
     INTSetVectorPriority(_OUTPUT_COMPARE_2_VECTOR, INT_PRIORITY_LEVEL_5);
     INTSetVectorSubPriority(_OUTPUT_COMPARE_2_VECTOR, INT_SUB_PRIORITY_LEVEL_3);
     INTEnable(INT_OC2,INT_ENABLED);
+    INTClearFlag(INT_DMA0);
+    INTSetVectorPriority(_DMA0_VECTOR, INT_PRIORITY_LEVEL_7);
+    INTSetVectorSubPriority(_DMA0_VECTOR, INT_SUB_PRIORITY_LEVEL_1);
+    //display transfer: DMA channel 1 feeds SPI3 whenever its transmit buffer is empty, the block done interrupt
+    //starts the next part of the frame
+    DmaChnOpen(DMA_CHANNEL1, DMA_CHN_PRI0, DMA_OPEN_DEFAULT);
+    DmaChnSetEventControl(DMA_CHANNEL1, DMA_EV_START_IRQ_EN | DMA_EV_START_IRQ(_SPI3_TX_IRQ));
+    DmaChnSetEvEnableFlags(DMA_CHANNEL1, DMA_EV_BLOCK_DONE);
+    INTClearFlag(INT_DMA1);
+    INTSetVectorPriority(_DMA1_VECTOR, INT_PRIORITY_LEVEL_3);
+    INTSetVectorSubPriority(_DMA1_VECTOR, INT_SUB_PRIORITY_LEVEL_1);
+    INTEnable(INT_DMA1, INT_ENABLED);
     ConfigIntCapture1(IC_INT_ON | IC_INT_PRIOR_4 | IC_INT_SUB_PRIOR_3);
     ConfigIntCapture3(IC_INT_ON | IC_INT_PRIOR_4 | IC_INT_SUB_PRIOR_3);    
     OLEDPrintNum68(0, 0, 2, 41);
@@ -206,20 +218,11 @@ void mcuInit4(){
     OLEDUpdate();
     
     INTEnableSystemMultiVectoredInt();
+    SPIAuto = 1;    //display updates on DMA from now on
     OLEDPrintNum68(0, 0, 2, 43);
     OLEDUpdate();
 }
 
-unsigned int mcuSqrt(register unsigned int n){
-    register unsigned int r, x;
-    r = 0;
-    for(x = 0x8000L; x; x >>= 1){
-        r += x;
-        if((UINT32)(r * r) > n)r -= x;
-    }
-    return r;
-}
-
 void DelayTicks(UINT32 a){
     UINT32 StartTime;
     StartTime = ReadCoreTimer();
@@ -280,11 +283,15 @@ void mcuStopISRTimer(){
 int ADCAuto = 0;
 
 void mcuADCStop(){
-    if(ADCAuto && !VTIBuffCnt) VTIBuffCnt = DmaChnGetDstPnt(DMA_CHANNEL0) >> 2;
+    if(ADCAuto && !VTIBuffCnt){
+        VIRingEnd = mcuVIRingPos();
+        VTIBuffCnt = VIRingCnt + ((VIRingEnd - VIRingCnt) & VIACC_RING_MASK);  //the last ring half may not be counted yet
+    }
+    INTEnable(INT_DMA0, INT_DISABLED);
+    INTClearFlag(INT_DMA0);
     DmaChnAbortTxfer(DMA_CHANNEL0);
-    DmaChnAbortTxfer(DMA_CHANNEL1);
     DmaChnDisable(DMA_CHANNEL0);
-    DmaChnDisable(DMA_CHANNEL1);
+    DmaChnClrEvFlags(DMA_CHANNEL0, DMA_EV_ALL_EVNTS);
     CloseADC10();
     ADC1BUF0; //read all buffers in case there's data on them (cannot clear interrupt flag otherwise))
     ADC1BUF1;
@@ -335,22 +342,23 @@ void mcuADCStartManualAVdd(){
 void mcuADCStartAutoVRef(int temp){
     mcuADCStop();
 
-    DmaChnOpen(DMA_CHANNEL0,DMA_CHN_PRI1, DMA_OPEN_DEFAULT);
+    //the ADC interrupts after every conversion of the scan (voltage, then current or temperature) and the DMA copies its
+    //16 bit result, so VIRing gets voltage/current pairs. The channel restarts at the ring start when it is full (auto
+    //enable) and interrupts at the half and at the end of the ring, VIRingISRTasks adds the samples
+    VIRingCnt = 0;
+    DmaChnOpen(DMA_CHANNEL0,DMA_CHN_PRI1, DMA_OPEN_AUTO);
     DmaChnSetEventControl(DMA_CHANNEL0, DMA_EV_START_IRQ_EN | DMA_EV_START_IRQ(_ADC_IRQ));
-    DmaChnSetTxfer(DMA_CHANNEL0,(void*)&ADC1BUF0,(void*)VBuff,4,sizeof(VBuff),2);
-    DmaChnWriteEvEnableFlags(DMA_CHANNEL0, DMA_EV_CELL_DONE);
+    DmaChnSetTxfer(DMA_CHANNEL0,(void*)&ADC1BUF0,(void*)VIRing,2,sizeof(VIRing),2);
+    DmaChnWriteEvEnableFlags(DMA_CHANNEL0, DMA_EV_DST_HALF | DMA_EV_BLOCK_DONE);
+    DmaChnClrEvFlags(DMA_CHANNEL0, DMA_EV_ALL_EVNTS);
+    INTClearFlag(INT_DMA0);
+    INTEnable(INT_DMA0, INT_ENABLED);
     DmaChnEnable(DMA_CHANNEL0);
 
-    DmaChnOpen(DMA_CHANNEL1,DMA_CHN_PRI0, DMA_OPEN_DEFAULT);
-    DmaChnSetEventControl(DMA_CHANNEL1, DMA_EV_START_IRQ_EN | DMA_EV_START_IRQ(_ADC_IRQ));
-    DmaChnSetTxfer(DMA_CHANNEL1,(void*)&ADC1BUF1,(void*)TIBuff,4,sizeof(TIBuff),4);
-    DmaChnWriteEvEnableFlags(DMA_CHANNEL1, 0);
-    DmaChnEnable(DMA_CHANNEL1);
-
     SetChanADC10(ADCH_VIN);// | (ADCH_VSHUNT<<8));
     OpenADC10(\
-            ADC_MODULE_ON | ADC_IDLE_STOP | ADC_FORMAT_INTG32 | ADC_CLK_AUTO | ADC_AUTO_SAMPLING_ON | ADC_SAMP_ON , \
-            ADC_VREF_EXT_EXT | ADC_OFFSET_CAL_DISABLE | ADC_SCAN_ON | ADC_SAMPLES_PER_INT_2 | ADC_ALT_BUF_OFF | ADC_ALT_INPUT_OFF, \
+            ADC_MODULE_ON | ADC_IDLE_STOP | ADC_FORMAT_INTG16 | ADC_CLK_AUTO | ADC_AUTO_SAMPLING_ON | ADC_SAMP_ON , \
+            ADC_VREF_EXT_EXT | ADC_OFFSET_CAL_DISABLE | ADC_SCAN_ON | ADC_SAMPLES_PER_INT_1 | ADC_ALT_BUF_OFF | ADC_ALT_INPUT_OFF, \
             ADC_SAMPLE_TIME_31 | ADC_CONV_CLK_PB | ADC_CONV_CLK_35Tcy2, \
             /*ADC_SAMPLE_TIME_31 | ADC_CONV_CLK_PB | ADC_CONV_CLK_23Tcy2, \*/
             ENABLE_AN0_ANA | ENABLE_AN1_ANA | ENABLE_AN2_ANA | ENABLE_AN3_ANA | ENABLE_AN4_ANA | ENABLE_AN5_ANA | ENABLE_AN12_ANA | ENABLE_AN13_ANA | ENABLE_AN14_ANA, \
@@ -449,6 +457,19 @@ void __ISR(_I2C_4_VECTOR,IPL6SOFT) I2CISR(void)
 
 void __ISR(_OUTPUT_COMPARE_2_VECTOR,IPL5SOFT) PIDISR(void){    
     INTClearFlag(INT_OC2);
+    PIDISRTasks();
+}
+
+void __ISR(_DMA0_VECTOR, IPL7SRS) DMA0ISR(void){
+    DmaChnClrEvFlags(DMA_CHANNEL0, DMA_EV_DST_HALF | DMA_EV_BLOCK_DONE);
+    INTClearFlag(INT_DMA0);
+    VIRingISRTasks();
+}
+
+void __ISR(_DMA1_VECTOR, IPL3SOFT) DMA1ISR(void){
+    DmaChnClrEvFlags(DMA_CHANNEL1, DMA_EV_BLOCK_DONE);
+    INTClearFlag(INT_DMA1);
+    OLEDDMATasks();
 }
 
 void __ISR(_INPUT_CAPTURE_1_VECTOR, IPL4SOFT) IC1ISR(void){
@@ -476,56 +497,21 @@ void __ISR(_INPUT_CAPTURE_3_VECTOR, IPL4SOFT) IC3ISR(void){
     INTClearFlag(INT_IC3);    
 }
 
-int SPIAuto;
 void mcuSPIStop()
 {
-    //DmaChnAbortTxfer(DMA_CHANNEL2);
-    //mcuSPIClose();
+    DmaChnAbortTxfer(DMA_CHANNEL1);
     mSPI3AClearAllIntFlags();
     mSPI3ATXIntEnable(0);
     mSPI3ARXIntEnable(0);
-    //mcuSPIOpen()
     SPIAuto=0;
 };
 
-//void mcuSPISendAuto(void * buffer, int len)
-//{
-//    SPIAuto = 1;
-//    mcuSPIStop();
-    //mcuSPIOpen();
-    //DmaChnOpen(DMA_CHANNEL2,DMA_CHN_PRI3, DMA_OPEN_DEFAULT);
-    //DmaChnSetEventControl(DMA_CHANNEL2, DMA_EV_START_IRQ_EN | DMA_EV_START_IRQ(_SPI3_TX_IRQ));
-	//DmaChnSetTxfer(DMA_CHANNEL2,(void*)buffer,(void*)&SPI3BUF, len, 1, 1);
-    //DmaChnWriteEvEnableFlags(DMA_CHANNEL2, DMA_EV_CELL_DONE);
-    //DmaChnEnable(DMA_CHANNEL2);
-
-	//DmaChnSetEvEnableFlags(dmaTxChn, DMA_EV_BLOCK_DONE);	// enable the transfer done interrupt, when all buffer transferred
-    //INTSetVectorPriority(DMA_CHANNEL3, INT_PRIORITY_LEVEL_5);
-	//INTSetVectorSubPriority(INT_VECTOR_DMA3, INT_SUB_PRIORITY_LEVEL_2);
-	//INTEnable(INT_SOURCE_DMA(dmaTxChn), INT_ENABLED);		// enable the chn interrupt in the INT controller
-	//DmaTxIntFlag=0;			// clear the interrupt flag we're  waiting on
-
-	// wait for the transfer to complete
-	// In a real application you can do some other stuff while the DMA transfer is taking place
-	//while(!DmaTxIntFlag);
-	// ok, we've sent the data in the buffer
-	//return 1;
-//}
-
-// handler for the DMA channel 1 interrupt
-//void __ISR(_DMA1_VECTOR, IPL5SOFT) DmaHandler1(void)
-//{
-	//int	evFlags;				// event flags when getting the interrupt
-//
-	//INTClearFlag(INT_SOURCE_DMA(DMA_CHANNEL1));	// acknowledge the INT controller, we're servicing int
-//
-	//evFlags=DmaChnGetEvFlags(DMA_CHANNEL1);	// get the event flags
-//
-//    if(evFlags&DMA_EV_BLOCK_DONE)
-//    { // just a sanity check. we enabled just the DMA_EV_BLOCK_DONE transfer done interrupt
-//    	DmaTxIntFlag=1;
-//        DmaChnClrEvFlags(DMA_CHANNEL1, DMA_EV_BLOCK_DONE);
-//    }
-//}
+//Send len bytes from buff on DMA channel 1, the first one is forced as the transmit buffer is already empty
+void mcuSPIStartAuto(void * buff, int len)
+{
+    DmaChnSetTxfer(DMA_CHANNEL1, buff, (void*)&SPI3BUF, len, 1, 1);
+    DmaChnClrEvFlags(DMA_CHANNEL1, DMA_EV_ALL_EVNTS);
+    DmaChnStartTxfer(DMA_CHANNEL1, DMA_WAIT_NOT, 0);
+}
 
 #undef _PIC32MX534F064H_C
@@ -35,7 +35,6 @@ P32_EXTERN void DelayTicks(UINT32 a);
 #define _delay_us(a) DelayTicks(a*(CORETIMER_FREQ/1000000UL))
 #define _delay_ms(a) DelayTicks(a*(CORETIMER_FREQ/1000UL))
 
-P32_EXTERN unsigned int mcuSqrt(unsigned int);
 
 //outputs
 #define HEATER      LATEbits.LATE6
@@ -139,10 +138,10 @@ P32_EXTERN void mcuStartISRTimer(unsigned int per);
 #define mcuStartISRTimer_us(us) mcuStartISRTimer((us*(PER_FREQ/1000000))/256);
 
 P32_EXTERN int mcuReadTime_us();
+#define mcuReadCoreTimer() ReadCoreTimer()
 
 //DMA
-#define mcuVBuffPos() DmaChnGetDstPnt(DMA_CHANNEL0)
-#define mcuTIBuffPos() DmaChnGetDstPnt(DMA_CHANNEL1)
+#define mcuVIRingPos() (DmaChnGetDstPnt(DMA_CHANNEL0) >> 2)   //ring index of the next complete sample pair
 
 //ADC channels
 #define ADCH_VIN ADC_CH0_POS_SAMPLEA_AN3
@@ -174,6 +173,7 @@ P32_EXTERN int mcuADCReadWait(int ADCCH, int num);
 P32_EXTERN void mcuSPIWait();
 P32_EXTERN void mcuSPIStop();
 P32_EXTERN void mcuSPIStartAuto(void * buff, int len);
+P32_EXTERN volatile int SPIAuto;       //the display frames go out on DMA, set once the interrupts are enabled
 
 #define mcuI2CStart() {int i=INTDisableInterrupts(); I2CStart(I2C4); INTRestoreInterrupts(i); }
 #define mcuI2CStop() {int i=INTDisableInterrupts(); I2CStop(I2C4); INTRestoreInterrupts(i); }
@@ -186,6 +186,7 @@ P32_EXTERN void mcuSPIStartAuto(void * buff, int len);
 #define mcuI2CIsACK() I2CByteWasAcknowledged(I2C4)
 #define mcuI2CACK() I2CAcknowledgeByte(I2C4, TRUE);
 #define mcuI2CWakeUp() INTSetFlag(INT_I2C4)
+#define mcuI2CIdle()                        //body of the loops waiting for the I2C interrupt
 
 #define mcuPIDWakeUp() INTSetFlag(INT_OC2)
 
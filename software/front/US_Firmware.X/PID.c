@@ -1,6 +1,7 @@
 #define _PID_C
 
 #include <GenericTypeDefs.h>
+#include <math.h>
 #include "PID.h"
 #include "isr.h"
 #include "iron.h"
@@ -16,16 +17,99 @@ void PIDInit(){
         PIDVars[i].PIDDutyP = 0;
         PIDVars[i].PIDDutyI = 0;
         PIDVars[i].PIDDutyFull = 0;
+        PIDVars[i].FFHold = 0;
+        PIDVars[i].FFLoad = 0;
         PIDVars[i].PWM = 0;
         PIDVars[i].OffDelay = 1600;
         PIDVars[i].Power = 3; //1/8 power as a start
+        PIDVars[i].Out[0].Duty = PIDVars[i].Out[1].Duty = 0;
+        PIDVars[i].Out[0].Power = PIDVars[i].Out[1].Power = 3;
+        PIDVars[i].Out[0].KeepOff = PIDVars[i].Out[1].KeepOff = 0;
+        PIDVars[i].OutSel = 0;
+        PIDTune[i].State = PID_TUNE_OFF;
     }
 };
 
+//Copy up to n PIDHist records from record *seq on into R, returns the number of records copied. When the reader has
+//fallen behind the ring *seq moves to the oldest record kept, so the gap in the sequence is the number of records lost.
+//Records the PID runs overwrite during the copy are given up the same way, the next read starts after them
+int PIDHistRead(UINT32 * seq, t_PIDHist * R, int n){
+    UINT32 s = *seq, cnt = PIDHistCnt;
+    int i;
+    if(cnt - s > PID_HIST_SIZE - PID_HIST_MARGIN) s = cnt - (PID_HIST_SIZE - PID_HIST_MARGIN);
+    if(n > cnt - s) n = cnt - s;
+    for(i = 0; i < n; i++) R[i] = *(t_PIDHist *)&PIDHist[(s + i) & (PID_HIST_SIZE - 1)];
+    if(PIDHistCnt - s > PID_HIST_SIZE) n = 0;
+    *seq = s;
+    return n;
+}
+
+void PIDTuneStart(){
+    int i;
+    for(i = 2; i--;){
+        volatile t_PIDTune * TU = &PIDTune[i];
+        TU->State = PID_TUNE_OFF;
+        if(IronPars.Config[i].SensorConfig.Type == SENSOR_UNDEFINED || IronPars.Config[i].SensorConfig.Type == SENSOR_NONE) continue;
+        TU->Runs = 0;
+        TU->OnRuns = 0;
+        TU->Set = CTTemp;
+        TU->State = PID_TUNE_SETTLE;
+    }
+}
+
+void PIDTuneStop(){
+    PIDTune[0].State = PID_TUNE_OFF;
+    PIDTune[1].State = PID_TUNE_OFF;
+}
+
+//State of the auto-tune run over the tuned channels: failed if one failed, running until both are done
+int PIDTuneState(){
+    int a = PIDTune[0].State, b = PIDTune[1].State;
+    if(a == PID_TUNE_FAILED || b == PID_TUNE_FAILED) return PID_TUNE_FAILED;
+    if(a == PID_TUNE_OFF) return b;
+    if(b == PID_TUNE_OFF) return a;
+    return min(a, b);
+}
+
+//Coefficients from the relay cycles: ultimate gain Ku = (2 * High * sin(pi * on fraction) / pi) / amplitude (first harmonic
+//of the relay output), ultimate period Tu. Kp = 0.45 Ku, Ti = 2.2 Tu, Td = Tu / 6.3 (Tyreus-Luyben, little overshoot on the
+//heater to tip lag). The average duty and the heating and cooling rates give the feed-forward loss and thermal mass.
+//Float math, run by PIDTasks in the main loop once the PID run has measured the cycles
+static void PIDTuneResult(t_IronConfig * IC, t_PIDTune * TU){
+    int n = PID_TUNE_CYCLES - PID_TUNE_SKIP, AVG = TU->AVG;
+    float per = (float)(MAINS_PER_US << (1 + ADCAVG - AVG)) * 1e-6f;        //PID run period (s)
+    float tu = (float)TU->SumRuns / n;                                      //runs
+    float on = (float)TU->SumOnRuns / TU->SumRuns;
+    float pp = (float)TU->SumPP / (n * 2);                                  //peak to peak (degrees)
+    float a = pp / 2, e = PID_TUNE_HYST / 2.0f;
+    float kp, p, dt;
+
+    a = (a > e * 1.1f) ? sqrtf(a * a - e * e) : e * 0.46f;
+    //Delta = degrees * 64, P = Delta * PID_KP (normalized duty)
+    kp = 0.45f * (2.0f * TU->High * sinf(3.14159f * on) / 3.14159f) / a / 64;
+    IC->PID_KP = (kp > 65535) ? 65535 : (kp < 1) ? 1 : (UINT16)kp;
+    kp = kp / (2.2f * tu);
+    IC->PID_KI = (kp > 65535) ? 65535 : (kp < 1) ? 1 : (UINT16)kp;
+    //TAvgP = TAvgF + slope * PID_DGain * ((1 << AVG) - 1) / 4 runs
+    kp = (tu / 6.3f) * 4 / ((1 << AVG) - 1);
+    IC->PID_DGain = (kp > 32) ? 32 : (UINT8)(kp + 0.5f);
+
+    p = (float)TU->High * IC->PID_PMax * (1000.0f / 16777216.0f);          //relay on power (mW)
+    dt = (float)((CTTemp << 2) - CRTemp) / 2;
+    if(dt > 10){
+        kp = p * on / dt;
+        IC->FF_Loss = (kp > 65535) ? 65535 : (kp < 1) ? 1 : (UINT16)kp;
+    }
+    //mass * (heating rate + cooling rate) = relay on power
+    kp = p / (pp / (on * tu * per) + pp / ((1 - on) * tu * per));
+    IC->FF_Mass = (kp > 65535) ? 65535 : (UINT16)kp;
+}
+
 void PIDTasks(){
+    int i;
     t_SensorConfig *CJC = (t_SensorConfig *)IronPars.ColdJunctionSensorConfig;    
     if(CJC && ADCData.VCJ && ADCData.VCJ<1023){
-        INT32 t = GetSensorTemperature(ADCData.VCJ, CJC);
+        INT32 t = GetSensorTemperatureLUT(ADCData.VCJ, &SensorLUT[SENSOR_LUT_CJ]);
         if(t > -273*2 && t < 200){
             CJTemp = t;                
         }
@@ -37,6 +121,87 @@ void PIDTasks(){
         CJTemp = -273*2;
     }
     ADCData.VCJ = 0;
+    for(i = 2; i--;){
+        if(PIDTune[i].State != PID_TUNE_MEASURED) continue;
+        PIDTuneResult((t_IronConfig *)&IronPars.Config[i], (t_PIDTune *)&PIDTune[i]);
+        PIDTune[i].State = PID_TUNE_DONE;
+    }
+}
+
+//Auto-tune step of a PID run, returns the duty to use instead of pdt
+static INT32 PIDTuneStep(t_PIDVars * PV, t_IronConfig * IC, t_PIDTune * TU, int AVG, INT32 pdt){
+    int t = PV->TAvgF[0] >> AVG;
+    int set = CTTemp << 2;
+
+    //the heater checks only count once the PID got the heater going
+    if(((TU->State == PID_TUNE_RELAY) && (PV->NoHeater || PV->NoSensor || PV->ShortCircuit)) || mainFlags.TipChange || CTTemp != TU->Set ||
+        ++TU->Runs > (PID_TUNE_TIMEOUT * 1000000UL) / (MAINS_PER_US << (1 + ADCAVG - AVG))){
+        TU->State = PID_TUNE_FAILED;
+        return pdt;
+    }
+    if(TU->State == PID_TUNE_SETTLE){
+        if(t > set - PID_TUNE_BAND && t < set + PID_TUNE_BAND){
+            if(++TU->OnRuns >= (8 << AVG)){
+                //relay around the duty the integral term settled at
+                TU->High = PV->PIDDutyI << 1;
+                if(TU->High < (0x00FFFFFF >> 2)) TU->High = 0x00FFFFFF >> 2;
+                if(TU->High > 0x00FFFFFF) TU->High = 0x00FFFFFF;
+                TU->Relay = 0;
+                TU->Cycle = 0;
+                TU->Runs = 0;
+                TU->OnRuns = 0;
+                TU->TMax = TU->TMin = t;
+                TU->SumRuns = 0;
+                TU->SumOnRuns = 0;
+                TU->SumPP = 0;
+                TU->State = PID_TUNE_RELAY;
+            }
+        }
+        else{
+            TU->OnRuns = 0;
+        }
+        return pdt;
+    }
+    if(t > TU->TMax) TU->TMax = t;
+    if(t < TU->TMin) TU->TMin = t;
+    if(TU->Relay){
+        TU->OnRuns++;
+        if(t >= set + PID_TUNE_HYST) TU->Relay = 0;
+    }
+    else if(t <= set - PID_TUNE_HYST){
+        //relay on, cycle number Cycle ends (cycle 0 is the part before the first switch on)
+        if(TU->Cycle > PID_TUNE_SKIP){
+            TU->SumRuns += TU->Runs;
+            TU->SumOnRuns += TU->OnRuns;
+            TU->SumPP += TU->TMax - TU->TMin;
+        }
+        if(TU->Cycle == PID_TUNE_CYCLES){
+            //the PID goes on from the average relay duty, PIDTasks works out the coefficients
+            PV->PIDDutyI = ((UINT64)TU->High * TU->SumOnRuns) / TU->SumRuns;
+            TU->AVG = AVG;
+            TU->State = PID_TUNE_MEASURED;
+            return pdt;
+        }
+        TU->Cycle++;
+        TU->Relay = 1;
+        TU->Runs = 0;
+        TU->OnRuns = 0;
+        TU->TMax = TU->TMin = t;
+    }
+    PV->KeepOff = 0;
+    return TU->Relay ? TU->High : 0;
+}
+
+//feed-forward: distance to the set temperature (Delta units, degrees * 64) within which the integral term takes over after a
+//set temperature change, and temperature drop below it that is taken as a load step
+#define FF_BAND (5 << 6)
+
+//Normalized duty (PIDDutyFull, 0x00FFFFFF = PID_PMax) of mW milliwatts
+static INT32 PIDFFDuty(t_IronConfig * IC, INT32 mW){
+    INT64 d;
+    if(mW <= 0 || !IC->PID_PMax) return 0;
+    d = ((INT64)mW << 24) / ((INT32)IC->PID_PMax * 1000);
+    return (d > 0x00FFFFFF) ? 0x00FFFFFF : (INT32)d;
 }
 
 #define intshr(a,b) ((a < 0) ? (-((-a) >> (b))) : (a >> (b)))
@@ -56,28 +221,34 @@ void PID(int PIDStep) {
     INT32 dw, pdt;    
     t_PIDVars * PV;
     t_IronConfig * IC;
+    t_SensorLUT * LUT;
+    t_PIDOut * PO;
+    t_PIDHist * PH;
+    t_PIDTune * TU;
+    ADCDataS * ADC;
     int WSL;
     int dual = !!IronPars.Config[1].SensorConfig.Type;
     
-    AVG = ADCAVG;
+    AVG = PIDAVG();
+    ADC = (ADCDataS *)&PIDADC[PIDStep];
     PV =(t_PIDVars *)&PIDVars[PIDStep];
     IC =(t_IronConfig *)&IronPars.Config[PIDStep];
-    if(dual){
-        AVG--;
-    }
-    else{
+    LUT = &SensorLUT[PIDStep];
+    if(!dual){
         PV =(t_PIDVars *)&PIDVars[0];
         IC =(t_IronConfig *)&IronPars.Config[0];
+        LUT = &SensorLUT[0];
     }
     WSL = IC->WSLen;
-    if(WSL < 0) WSL = dual ? 4 : 8;
+    if(WSL < 0) WSL = (AVG < ADCAVG) ? 4 : 8;
     
     if(PV->NoHeater || PV->NoSensor || PV->Starting || PV->ShortCircuit || PV->LastTTemp != CTTemp)PV->DestinationReached = 0;
+    if(PV->Starting || PV->LastTTemp != CTTemp) PV->FFHold = 2;
     PV->LastTTemp = CTTemp;
 
 /**** GET ROOM TEMPERATURE **********************************************************/
-    if(PIDStep){
-        dw = ADCData.VRT;
+    if(PIDStep && ADC->VRT){       //0 when the room temperature samples of the window are not complete
+        dw = ADC->VRT;
         dw *= 147;
         dw >>= 8;
         dw -= 200;
@@ -126,7 +297,7 @@ void PID(int PIDStep) {
 /************************************************************************************/
     
     PV->ADCTemp[1]=PV->ADCTemp[0];
-    PV->ADCTemp[0] = ADCData.VTEMP[1];
+    PV->ADCTemp[0] = ADC->VTEMP[1];
 
 /**** WAVE SHAPING *****************************************************/
     PV->WSCorr = 0;
@@ -141,7 +312,7 @@ void PID(int PIDStep) {
         }
         else{
             //if(PV->DestinationReached == 0) for(i = 8; i--;) PV->WSDelta[i].cnt = 0;            
-            if(ADCData.HeaterOn){
+            if(ADC->HeaterOn){
                 if(PV->OffCnt > 1){
                     i = min(PV->OffCnt, 8);
                     w = PV->WSDelta[0].val;
@@ -219,7 +390,7 @@ void PID(int PIDStep) {
     w -= ((((INT32)IC->SensorConfig.Gain * (INT32)IC->HRCompCurrent * 20070L) >> 15) * (INT32)(PV->HRAvg >> AVG)) >> 11;
     
     
-    dw = GetSensorTemperature(w, &IC->SensorConfig);
+    dw = GetSensorTemperatureLUT(w, LUT);
 
     if(dw > 1023)dw = 1023;
     if(dw < 0)dw = 0;
@@ -316,6 +487,44 @@ void PID(int PIDStep) {
     
     
     PV->PIDDutyI += PV->Delta[0] * (int)IC->PID_KI;        
+
+/**** FEED-FORWARD ******************************************************************/
+    //Heat loss at the set temperature and thermal mass times the fall rate of a load step, from the instrument model,
+    //go into the integral term at once instead of being integrated there
+    if(IC->FF_Loss){
+        if(PV->FFHold == 2){
+            PV->FFHold = (PV->Delta[0] >= 0) ? 1 : -1;
+            PV->FFLoad = 0;
+        }
+        if(PV->FFHold && PV->FFHold * PV->Delta[0] <= FF_BAND){
+            //new set temperature reached, replace what the integral term collected on the way by the loss at it
+            PV->PIDDutyI = PIDFFDuty(IC, ((INT32)IC->FF_Loss * ((CTTemp << 2) - CRTemp)) >> 1);
+            PV->FFHold = 0;
+        }
+        //load steps are fed forward once the temperature has stayed within FF_BAND for (4 << AVG) runs, and again after
+        //the set temperature was reached, not on the ripple of a temperature that does not settle
+        if(PV->FFLoad < 0){
+            if(PV->Delta[0] <= 0) PV->FFLoad = 0;
+        }
+        else if(PV->Delta[0] < FF_BAND && PV->Delta[0] > -FF_BAND){
+            if(PV->FFLoad < (4 << AVG)) PV->FFLoad++;
+        }
+        else if(PV->FFLoad < (4 << AVG)){
+            PV->FFLoad = 0;
+        }
+        else if(PV->Delta[0] >= FF_BAND && PV->TSlope < 0){
+            //TSlope = 4 * (TAvg change over (1 << AVG) - 1 runs), TAvg = (1 << AVG) * degrees * 2
+            //mW = FF_Mass * degrees/s = FF_Mass * -TSlope * 500000 / (4 * (1 << AVG) * ((1 << AVG) - 1) * run period (us))
+            UINT64 r = (UINT64)IC->FF_Mass * (UINT64)(-PV->TSlope) * 500000;
+            r /= (UINT64)((4 << AVG) * ((1 << AVG) - 1)) * (MAINS_PER_US << (1 + ADCAVG - AVG));
+            PV->PIDDutyI += PIDFFDuty(IC, (r > 0x7FFFFFFF) ? 0x7FFFFFFF : (INT32)r);
+            PV->FFLoad = -1;
+        }
+    }
+    else{
+        PV->FFHold = 0;
+    }
+/************************************************************************************/
     if((PV->PIDDutyP = PV->Delta[0] * (int)IC->PID_KP) >= 0){
         dw = 0x00FFFFFF;
         if(PV->PIDDutyP > dw) PV->PIDDutyP = dw;
@@ -333,6 +542,9 @@ void PID(int PIDStep) {
     pdt = PV->PIDDutyP + PV->PIDDutyI;
     if(pdt < 0) pdt = 0;
     if((IC->SensorConfig.Type == SENSOR_UNDEFINED) || (IC->SensorConfig.Type == SENSOR_NONE) || PV->NoSensor) pdt = 0;
+
+    TU = (t_PIDTune *)&PIDTune[PV - (t_PIDVars *)PIDVars];
+    if(TU->State == PID_TUNE_SETTLE || TU->State == PID_TUNE_RELAY) pdt = PIDTuneStep(PV, IC, TU, AVG, pdt);
     
     PV->PIDDutyFull = pdt; //normalized duty
 
@@ -382,6 +594,25 @@ void PID(int PIDStep) {
         PV->PWM = 0;
     } 
     PV->PIDDuty = pdt;
+    if(PV->KeepOff) PV->KeepOff--;
+
+    //publish the results to the ISR
+    PO = &PV->Out[PV->OutSel ^ 1];
+    PO->Duty = PV->PIDDuty;
+    PO->Power = PV->Power;
+    PO->KeepOff = PV->KeepOff;
+    PV->OutSel ^= 1;
+
+    PH = (t_PIDHist *)&PIDHist[PIDHistCnt & (PID_HIST_SIZE - 1)];
+    PH->Ticks = ISRTicks;
+    PH->Ch = PV - (t_PIDVars *)PIDVars;
+    PH->Heater = ADC->HeaterOn;
+    PH->CTemp = PV->CTemp[0];
+    PH->ADCTemp = PV->ADCTemp[0];
+    PH->Duty = PV->PIDDuty >> 8;
+    PH->HR = PV->HRAvg >> AVG;
+    PH->HP = PV->HPAvg >> AVG;
+    PIDHistCnt++;
 }
 
 #undef _PID_C
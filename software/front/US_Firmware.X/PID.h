@@ -16,6 +16,8 @@ extern "C" {
 #endif
 
 #define ADCAVG 3 //Must be >=1
+//averaging depth (log2) of the PID filters, one less when a dual instrument runs each PID only every fourth half period
+#define PIDAVG() ((IronPars.Config[1].SensorConfig.Type && !IronDualScan) ? ADCAVG - 1 : ADCAVG)
     
 #ifndef _PID_C
 #define PID_H_EXTERN extern
@@ -28,6 +30,26 @@ extern "C" {
         int val;
     }t_WSDelta;
 
+    typedef struct {
+        UINT32 Duty;            //PIDDuty
+        int Power;              //Power
+        int KeepOff;            //KeepOff
+    }t_PIDOut;                  //PID results as seen by the ISR heater decision
+
+#define PID_HIST_SIZE 128       //PID run records kept in PIDHist, power of 2
+#define PID_HIST_MARGIN 8       //records PIDHistRead leaves to the PID runs during the copy
+
+    typedef struct {
+        UINT16 Ticks;           //ISRTicks of the run
+        UINT8 Ch;               //PIDVars index
+        UINT8 Heater;           //heater was on in the half period the temperature was read in
+        INT16 CTemp;            //CTemp[0]
+        UINT16 ADCTemp;         //ADCTemp[0]
+        UINT16 Duty;            //PIDDuty >> 8
+        INT16 HR;               //averaged heater resistance /10
+        UINT16 HP;              //averaged heater power
+    }t_PIDHist;
+
     typedef struct {
         UINT32 PWM;
         INT32 PIDDutyP;
@@ -76,6 +98,9 @@ extern "C" {
 
         int Delta[2];
 
+        int FFHold;             //feed-forward: 2 = new set temperature, 1/-1 = heating/cooling to it, 0 = reached
+        int FFLoad;             //feed-forward: runs within FF_BAND of the set temperature, -1 after a load step was fed forward
+
         int HInitData;          //1 when heater data is to be initialized, 0 otherwise
         int HNewData;           //1 when new data is written to HR,HP and HI, 0 otherwise
         int HR;                 //last heater resistance /10
@@ -88,9 +113,45 @@ extern "C" {
         int HI;                 //last heater current x42.55
         int HIAvg;              //averaged heater current x42.55
         float CPolyX;           //current temperature polynomial argument (millivolts for TC, resistance(ohms) for resistive)
+
+        t_PIDOut Out[2];        //double buffered PID results, PID() fills Out[OutSel ^ 1] and then flips OutSel
+        int OutSel;
     } t_PIDVars;
 
 
+//Relay auto-tune: the heater is switched between PIDTune.High and off at the set temperature +/- PID_TUNE_HYST,
+//the period and amplitude of the oscillation give the ultimate gain and period the coefficients are derived from
+#define PID_TUNE_CYCLES     6       //relay cycles of a run, the first PID_TUNE_SKIP are not measured
+#define PID_TUNE_SKIP       2
+#define PID_TUNE_HYST       2       //relay hysteresis (degrees * 2)
+#define PID_TUNE_BAND       6       //settling band before the relay starts (degrees * 2)
+#define PID_TUNE_TIMEOUT    60      //longest settling or relay cycle (seconds)
+
+    enum PID_TUNE_STATES{
+        PID_TUNE_OFF,
+        PID_TUNE_SETTLE,            //normal PID until the temperature stays at the set temperature
+        PID_TUNE_RELAY,             //relay oscillation
+        PID_TUNE_MEASURED,          //relay cycles measured, PIDTasks works out the coefficients
+        PID_TUNE_DONE,              //coefficients written to IronPars, to be saved
+        PID_TUNE_SAVED,             //coefficients saved in the EEPROM
+        PID_TUNE_FAILED
+    };
+
+    typedef struct {
+        int State;              //PID_TUNE_STATES
+        int Relay;              //relay output, 1 = heater on
+        int Cycle;              //relay cycles started
+        int Set;                //set temperature of the run (CTTemp)
+        UINT32 Runs;            //PID runs since the start of settling or of the relay cycle
+        UINT32 OnRuns;          //runs within the settling band, or with the relay on in the relay cycle
+        int TMax, TMin;         //temperature extremes of the relay cycle (degrees * 2)
+        INT32 High;             //relay on duty (normalized, 0x00FFFFFF = PID_PMax)
+        UINT32 SumRuns;         //sums over the measured cycles: runs,
+        UINT32 SumOnRuns;       //runs with the relay on
+        INT32 SumPP;            //and peak to peak temperature (degrees * 2)
+        int AVG;                //PIDAVG of the run
+    }t_PIDTune;
+
 PID_H_EXTERN volatile unsigned int PIDTicks;
 PID_H_EXTERN volatile int CRTemp;
 PID_H_EXTERN volatile int RTAvg;
@@ -98,8 +159,16 @@ PID_H_EXTERN volatile int CJTemp;
 PID_H_EXTERN volatile int CTTemp;
 
 PID_H_EXTERN volatile t_PIDVars PIDVars[2];
+PID_H_EXTERN volatile t_PIDTune PIDTune[2];
+
+PID_H_EXTERN volatile t_PIDHist PIDHist[PID_HIST_SIZE];    //ring of the last PID runs of both channels, in the RAM the 32 bit VBuff/TIBuff used
+PID_H_EXTERN volatile UINT32 PIDHistCnt;                   //number of records written, the next one goes to PIDHist[PIDHistCnt & (PID_HIST_SIZE - 1)]
+PID_H_EXTERN int PIDHistRead(UINT32 * seq, t_PIDHist * R, int n);
     
 PID_H_EXTERN void PIDInit();
+PID_H_EXTERN void PIDTuneStart();
+PID_H_EXTERN void PIDTuneStop();
+PID_H_EXTERN int PIDTuneState();
 
 PID_H_EXTERN void PIDTasks();
 
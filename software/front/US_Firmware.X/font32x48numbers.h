@@ -13,7 +13,7 @@ extern "C" {
 #endif
 
 const char numbers32x48[12][192]={
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -204,9 +204,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -397,9 +397,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -590,9 +590,9 @@ const char numbers32x48[12][192]={
 0b00000011,
 0b00000011,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -783,9 +783,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -976,9 +976,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -1169,9 +1169,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -1362,9 +1362,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b11000000,
@@ -1555,9 +1555,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -1748,9 +1748,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -1941,9 +1941,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b11000000,
@@ -2134,9 +2134,9 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b11000000,
@@ -2327,7 +2327,7 @@ const char numbers32x48[12][192]={
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000
+0b00000000}
 };
 
 
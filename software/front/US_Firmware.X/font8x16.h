@@ -11,19 +11,9 @@
 #ifdef	__cplusplus
 extern "C" {
 #endif
-const UINT8 degrees4x16[8] = {
-0b00000000,
-0b00001000,
-0b00010100,
-0b00001000,
-0b00000000,
-0b00000000,
-0b00000000,
-0b00000000,
-};
-
 const UINT8 font8x16[128][16] = {
 //0
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -38,10 +28,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
-0b00000000,
+0b00000000},
 //1 (Celsius)
-0b00000000,
+{0b00000000,
 0b00001100,
 0b11101100,
 0b11110000,
@@ -56,9 +45,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001110,
-0b00000110,
+0b00000110},
 //2 (Farenheit)
-0b00000000,
+{0b00000000,
 0b00001100,
 0b11101100,
 0b11110000,
@@ -73,10 +62,10 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000001,
 0b00000001,
-0b00000001,
+0b00000001},
 
 //3
-0b11000000,
+{0b11000000,
 0b11100000,
 0b11100000,
 0b11000000,
@@ -91,9 +80,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00000011,
 0b00000001,
-0b00000000,
+0b00000000},
 //4
-0b10000000,
+{0b10000000,
 0b11000000,
 0b11100000,
 0b11110000,
@@ -108,9 +97,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00000011,
 0b00000001,
-0b00000000,
+0b00000000},
 //5
-0b10000000,
+{0b10000000,
 0b11000000,
 0b10110000,
 0b11111000,
@@ -125,9 +114,9 @@ const UINT8 font8x16[128][16] = {
 0b00001101,
 0b00001011,
 0b00000011,
-0b00000001,
+0b00000001},
 //6
-0b10000000,
+{0b10000000,
 0b11000000,
 0b11100000,
 0b11110000,
@@ -142,9 +131,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00001001,
 0b00000011,
-0b00000001,
+0b00000001},
 //7
-0b00000000,
+{0b00000000,
 0b00000000,
 0b10000000,
 0b11000000,
@@ -159,9 +148,9 @@ const UINT8 font8x16[128][16] = {
 0b00000011,
 0b00000001,
 0b00000000,
-0b00000000,
+0b00000000},
 //8
-0b11111110,
+{0b11111110,
 0b11111110,
 0b01111110,
 0b00111110,
@@ -176,9 +165,9 @@ const UINT8 font8x16[128][16] = {
 0b01111100,
 0b01111110,
 0b01111111,
-0b01111111,
+0b01111111},
 //9
-0b00000000,
+{0b00000000,
 0b11000000,
 0b01100000,
 0b00100000,
@@ -193,9 +182,9 @@ const UINT8 font8x16[128][16] = {
 0b00000100,
 0b00000110,
 0b00000011,
-0b00000000,
+0b00000000},
 //10
-0b11111110,
+{0b11111110,
 0b00111110,
 0b10011110,
 0b11011110,
@@ -210,9 +199,9 @@ const UINT8 font8x16[128][16] = {
 0b01111011,
 0b01111001,
 0b01111100,
-0b01111111,
+0b01111111},
 //11
-0b00000000,
+{0b00000000,
 0b00000000,
 0b10000000,
 0b10000000,
@@ -227,9 +216,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001111,
 0b00000111,
-0b00000000,
+0b00000000},
 //12
-0b00000000,
+{0b00000000,
 0b01110000,
 0b11111000,
 0b10001000,
@@ -244,9 +233,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000010,
 0b00000010,
-0b00000000,
+0b00000000},
 //13
-0b00000000,
+{0b00000000,
 0b00000000,
 0b11111000,
 0b11111000,
@@ -261,9 +250,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //14
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b00101000,
@@ -278,9 +267,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00001110,
 0b00001111,
-0b00000111,
+0b00000111},
 //15
-0b10100000,
+{0b10100000,
 0b10100000,
 0b11000000,
 0b01110000,
@@ -295,9 +284,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00000001,
 0b00000010,
-0b00000010,
+0b00000010},
 //16
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11110000,
 0b11100000,
@@ -312,9 +301,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000001,
 0b00000000,
-0b00000000,
+0b00000000},
 //17
-0b00000000,
+{0b00000000,
 0b10000000,
 0b10000000,
 0b11000000,
@@ -329,9 +318,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000011,
 0b00000111,
-0b00001111,
+0b00001111},
 //18
-0b00000000,
+{0b00000000,
 0b00100000,
 0b00110000,
 0b11111000,
@@ -346,9 +335,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000110,
 0b00000010,
-0b00000000,
+0b00000000},
 //19
-0b00000000,
+{0b00000000,
 0b01110000,
 0b11111000,
 0b01110000,
@@ -363,9 +352,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00001101,
-0b00000000,
+0b00000000},
 //20
-0b01110000,
+{0b01110000,
 0b11111000,
 0b10001000,
 0b11111000,
@@ -380,9 +369,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000000,
 0b00001111,
-0b00001111,
+0b00001111},
 //21
-0b00000000,
+{0b00000000,
 0b10001000,
 0b11011100,
 0b01110100,
@@ -397,9 +386,9 @@ const UINT8 font8x16[128][16] = {
 0b00100100,
 0b00101110,
 0b00111011,
-0b00010001,
+0b00010001},
 //22
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -414,9 +403,9 @@ const UINT8 font8x16[128][16] = {
 0b00001110,
 0b00001110,
 0b00001110,
-0b00001110,
+0b00001110},
 //23
-0b00000000,
+{0b00000000,
 0b00100000,
 0b00110000,
 0b11111000,
@@ -431,9 +420,9 @@ const UINT8 font8x16[128][16] = {
 0b00011111,
 0b00010110,
 0b00010010,
-0b00000000,
+0b00000000},
 //24
-0b00000000,
+{0b00000000,
 0b00100000,
 0b00110000,
 0b11111000,
@@ -448,9 +437,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //25
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b11111000,
@@ -465,9 +454,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000110,
 0b00000010,
-0b00000000,
+0b00000000},
 //26
-0b10000000,
+{0b10000000,
 0b10000000,
 0b10000000,
 0b10000000,
@@ -482,9 +471,9 @@ const UINT8 font8x16[128][16] = {
 0b00000010,
 0b00000011,
 0b00000001,
-0b00000000,
+0b00000000},
 //27
-0b10000000,
+{0b10000000,
 0b11000000,
 0b11100000,
 0b10100000,
@@ -499,9 +488,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //28
-0b00000000,
+{0b00000000,
 0b11000000,
 0b11000000,
 0b00000000,
@@ -516,9 +505,9 @@ const UINT8 font8x16[128][16] = {
 0b00000010,
 0b00000010,
 0b00000010,
-0b00000010,
+0b00000010},
 //29
-0b10000000,
+{0b10000000,
 0b11000000,
 0b11100000,
 0b10000000,
@@ -533,9 +522,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000011,
 0b00000001,
-0b00000000,
+0b00000000},
 //30
-0b00000000,
+{0b00000000,
 0b00000000,
 0b10000000,
 0b11100000,
@@ -550,9 +539,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00000111,
 0b00000111,
-0b00000110,
+0b00000110},
 //31
-0b00000000,
+{0b00000000,
 0b00110000,
 0b11110000,
 0b11110000,
@@ -567,8 +556,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00000011,
 0b00000000,
-0b00000000,
+0b00000000},
 //32
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -583,10 +573,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
-0b00000000,
+0b00000000},
 //33
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00111000,
 0b11111100,
@@ -601,9 +590,9 @@ const UINT8 font8x16[128][16] = {
 0b00001101,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //34
-0b00000000,
+{0b00000000,
 0b00111100,
 0b00111100,
 0b00000000,
@@ -618,9 +607,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //35
-0b00000000,
+{0b00000000,
 0b00100000,
 0b11111000,
 0b11111000,
@@ -635,9 +624,9 @@ const UINT8 font8x16[128][16] = {
 0b00000010,
 0b00001111,
 0b00001111,
-0b00000010,
+0b00000010},
 //36
-0b00000000,
+{0b00000000,
 0b01110000,
 0b11111000,
 0b10001000,
@@ -652,9 +641,9 @@ const UINT8 font8x16[128][16] = {
 0b00111000,
 0b00111000,
 0b00001111,
-0b00000111,
+0b00000111},
 //37
-0b00000000,
+{0b00000000,
 0b00110000,
 0b00110000,
 0b00000000,
@@ -669,9 +658,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000000,
 0b00001100,
-0b00001100,
+0b00001100},
 //38
-0b00000000,
+{0b00000000,
 0b00000000,
 0b10110000,
 0b11111000,
@@ -686,9 +675,9 @@ const UINT8 font8x16[128][16] = {
 0b00001001,
 0b00000111,
 0b00001111,
-0b00001000,
+0b00001000},
 //39
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -703,9 +692,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //40
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b11100000,
@@ -720,9 +709,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00001100,
 0b00001000,
-0b00000000,
+0b00000000},
 //41
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00001000,
 0b00011000,
@@ -737,9 +726,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00000011,
 0b00000000,
-0b00000000,
+0b00000000},
 //42
-0b00000000,
+{0b00000000,
 0b10000000,
 0b10100000,
 0b11100000,
@@ -754,9 +743,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000011,
 0b00000010,
-0b00000000,
+0b00000000},
 //43
-0b10000000,
+{0b10000000,
 0b10000000,
 0b10000000,
 0b11110000,
@@ -771,9 +760,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //44
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -788,9 +777,9 @@ const UINT8 font8x16[128][16] = {
 0b00011110,
 0b00001110,
 0b00000000,
-0b00000000,
+0b00000000},
 //45
-0b00000000,
+{0b00000000,
 0b10000000,
 0b10000000,
 0b10000000,
@@ -805,9 +794,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //46
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -822,9 +811,9 @@ const UINT8 font8x16[128][16] = {
 0b00001100,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //47
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -839,9 +828,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //48
-0b00000000,
+{0b00000000,
 0b11100000,
 0b11110000,
 0b00011000,
@@ -856,9 +845,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001100,
 0b00000111,
-0b00000011,
+0b00000011},
 //49
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00100000,
 0b00110000,
@@ -873,9 +862,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00001111,
 0b00000000,
-0b00000000,
+0b00000000},
 //50
-0b00000000,
+{0b00000000,
 0b00010000,
 0b00011000,
 0b00001000,
@@ -890,9 +879,9 @@ const UINT8 font8x16[128][16] = {
 0b00001001,
 0b00001000,
 0b00001000,
-0b00001000,
+0b00001000},
 //51
-0b00000000,
+{0b00000000,
 0b00010000,
 0b00011000,
 0b10001000,
@@ -907,9 +896,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //52
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b00000000,
@@ -924,9 +913,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00001111,
 0b00001111,
-0b00000001,
+0b00000001},
 //53
-0b00000000,
+{0b00000000,
 0b01111000,
 0b01111000,
 0b01001000,
@@ -941,9 +930,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //54
-0b00000000,
+{0b00000000,
 0b11100000,
 0b11110000,
 0b10011000,
@@ -958,9 +947,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //55
-0b00000000,
+{0b00000000,
 0b00001000,
 0b00001000,
 0b00001000,
@@ -975,9 +964,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000011,
 0b00000000,
-0b00000000,
+0b00000000},
 //56
-0b00000000,
+{0b00000000,
 0b01110000,
 0b11111000,
 0b10001000,
@@ -992,9 +981,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //57
-0b00000000,
+{0b00000000,
 0b01110000,
 0b11111000,
 0b10001000,
@@ -1009,9 +998,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001100,
 0b00000111,
-0b00000011,
+0b00000011},
 //58
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00110000,
@@ -1026,9 +1015,9 @@ const UINT8 font8x16[128][16] = {
 0b00000110,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //59
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -1043,9 +1032,9 @@ const UINT8 font8x16[128][16] = {
 0b00011110,
 0b00001110,
 0b00000000,
-0b00000000,
+0b00000000},
 //60
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b01100000,
@@ -1060,9 +1049,9 @@ const UINT8 font8x16[128][16] = {
 0b00000110,
 0b00001100,
 0b00001000,
-0b00000000,
+0b00000000},
 //61
-0b00000000,
+{0b00000000,
 0b01000000,
 0b01000000,
 0b01000000,
@@ -1077,9 +1066,9 @@ const UINT8 font8x16[128][16] = {
 0b00000010,
 0b00000010,
 0b00000010,
-0b00000010,
+0b00000010},
 //62
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00001000,
 0b00011000,
@@ -1094,9 +1083,9 @@ const UINT8 font8x16[128][16] = {
 0b00000110,
 0b00000011,
 0b00000001,
-0b00000000,
+0b00000000},
 //63
-0b00000000,
+{0b00000000,
 0b00110000,
 0b00111000,
 0b00001000,
@@ -1111,9 +1100,9 @@ const UINT8 font8x16[128][16] = {
 0b00001101,
 0b00001101,
 0b00000000,
-0b00000000,
+0b00000000},
 //64
-0b00000000,
+{0b00000000,
 0b11110000,
 0b11111000,
 0b00001000,
@@ -1128,9 +1117,9 @@ const UINT8 font8x16[128][16] = {
 0b00001011,
 0b00001010,
 0b00001011,
-0b00000001,
+0b00000001},
 //65
-0b00000000,
+{0b00000000,
 0b11100000,
 0b11110000,
 0b00011000,
@@ -1145,9 +1134,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000001,
 0b00001111,
-0b00001111,
+0b00001111},
 //66
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b10001000,
@@ -1162,9 +1151,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //67
-0b00000000,
+{0b00000000,
 0b11110000,
 0b11111000,
 0b00001000,
@@ -1179,9 +1168,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001110,
-0b00000110,
+0b00000110},
 //68
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b00001000,
@@ -1196,9 +1185,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001100,
 0b00000111,
-0b00000011,
+0b00000011},
 //69
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b10001000,
@@ -1213,9 +1202,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 //70
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b10001000,
@@ -1230,9 +1219,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //71
-0b00000000,
+{0b00000000,
 0b11110000,
 0b11111000,
 0b00001000,
@@ -1247,9 +1236,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //72
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b10000000,
@@ -1264,9 +1253,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00001111,
-0b00001111,
+0b00001111},
 //73
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00001000,
 0b11111000,
@@ -1281,9 +1270,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00001000,
 0b00000000,
-0b00000000,
+0b00000000},
 //74
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -1298,9 +1287,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001111,
 0b00000111,
-0b00000000,
+0b00000000},
 //75
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b10000000,
@@ -1315,9 +1304,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000011,
 0b00001110,
-0b00001100,
+0b00001100},
 //76
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b00000000,
@@ -1332,9 +1321,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 //77
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b01110000,
@@ -1349,9 +1338,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00001111,
-0b00001111,
+0b00001111},
 //78
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b01110000,
@@ -1366,9 +1355,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000001,
 0b00001111,
-0b00001111,
+0b00001111},
 //79
-0b00000000,
+{0b00000000,
 0b11110000,
 0b11111000,
 0b00001000,
@@ -1383,9 +1372,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //80
-0b00000000,
+{0b00000000,
 0b11110000,
 0b11111000,
 0b00001000,
@@ -1400,9 +1389,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000001,
 0b00000001,
-0b00000000,
+0b00000000},
 //81
-0b00000000,
+{0b00000000,
 0b11110000,
 0b11111000,
 0b00001000,
@@ -1417,9 +1406,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00001110,
 0b00011111,
-0b00010011,
+0b00010011},
 //82
-0b00000000,
+{0b00000000,
 0b11110000,
 0b11111000,
 0b10001000,
@@ -1434,9 +1423,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000001,
 0b00001111,
-0b00001110,
+0b00001110},
 //83
-0b00000000,
+{0b00000000,
 0b00110000,
 0b01111000,
 0b11001000,
@@ -1451,9 +1440,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001001,
 0b00001111,
-0b00000110,
+0b00000110},
 //84
-0b00000000,
+{0b00000000,
 0b00001000,
 0b00001000,
 0b11111000,
@@ -1468,9 +1457,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //85
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b00000000,
@@ -1485,9 +1474,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //86
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b00000000,
@@ -1502,9 +1491,9 @@ const UINT8 font8x16[128][16] = {
 0b00001100,
 0b00000110,
 0b00000011,
-0b00000001,
+0b00000001},
 //87
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b00000000,
@@ -1519,9 +1508,9 @@ const UINT8 font8x16[128][16] = {
 0b00000011,
 0b00000111,
 0b00001111,
-0b00001111,
+0b00001111},
 //88
-0b00000000,
+{0b00000000,
 0b00011000,
 0b00111000,
 0b11100000,
@@ -1536,9 +1525,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000011,
 0b00001110,
-0b00001100,
+0b00001100},
 //89
-0b00000000,
+{0b00000000,
 0b01111000,
 0b11111000,
 0b10000000,
@@ -1553,9 +1542,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //90
-0b00000000,
+{0b00000000,
 0b00001000,
 0b00001000,
 0b10001000,
@@ -1570,9 +1559,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001000,
-0b00001000,
+0b00001000},
 //91
-0b00000000,
+{0b00000000,
 0b00000000,
 0b11111000,
 0b11111000,
@@ -1587,9 +1576,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00000000,
-0b00000000,
+0b00000000},
 //92
-0b00000000,
+{0b00000000,
 0b00110000,
 0b01100000,
 0b11000000,
@@ -1604,9 +1593,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000011,
 0b00000110,
-0b00001100,
+0b00001100},
 //93
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00001000,
@@ -1621,9 +1610,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001111,
 0b00001111,
-0b00000000,
+0b00000000},
 //94
-0b00000000,
+{0b00000000,
 0b11000000,
 0b01100000,
 0b00110000,
@@ -1638,8 +1627,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //95
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -1647,8 +1637,6 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
-0b00100000,
 0b00100000,
 0b00100000,
 0b00100000,
@@ -1656,8 +1644,9 @@ const UINT8 font8x16[128][16] = {
 0b00100000,
 0b00100000,
 0b00100000,
+0b00100000},
 //96
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00001100,
@@ -1672,9 +1661,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //97
-0b00000000,
+{0b00000000,
 0b00000000,
 0b01000000,
 0b01000000,
@@ -1689,9 +1678,9 @@ const UINT8 font8x16[128][16] = {
 0b00001001,
 0b00000001,
 0b00001111,
-0b00001111,
+0b00001111},
 //98
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b01000000,
@@ -1706,9 +1695,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //99
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b01000000,
@@ -1723,9 +1712,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001100,
-0b00000100,
+0b00000100},
 //100
-0b00000000,
+{0b00000000,
 0b00000000,
 0b10000000,
 0b11000000,
@@ -1740,9 +1729,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00000000,
 0b00001111,
-0b00001111,
+0b00001111},
 //101
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b01000000,
@@ -1757,9 +1746,9 @@ const UINT8 font8x16[128][16] = {
 0b00001001,
 0b00001001,
 0b00001101,
-0b00000101,
+0b00000101},
 //102
-0b00000000,
+{0b00000000,
 0b11110000,
 0b11111000,
 0b00001000,
@@ -1774,9 +1763,9 @@ const UINT8 font8x16[128][16] = {
 0b00000001,
 0b00000001,
 0b00000000,
-0b00000000,
+0b00000000},
 //103
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b01000000,
@@ -1791,9 +1780,9 @@ const UINT8 font8x16[128][16] = {
 0b00100100,
 0b00100100,
 0b00111111,
-0b00011111,
+0b00011111},
 //104
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b01000000,
@@ -1808,9 +1797,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00001111,
-0b00001111,
+0b00001111},
 //105
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b11011000,
@@ -1825,9 +1814,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //106
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
@@ -1842,9 +1831,9 @@ const UINT8 font8x16[128][16] = {
 0b00100000,
 0b00111111,
 0b00011111,
-0b00000000,
+0b00000000},
 //107
-0b00000000,
+{0b00000000,
 0b11111000,
 0b11111000,
 0b00000000,
@@ -1859,9 +1848,9 @@ const UINT8 font8x16[128][16] = {
 0b00000011,
 0b00000110,
 0b00001100,
-0b00001000,
+0b00001000},
 //108
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b11111000,
@@ -1876,9 +1865,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //109
-0b00000000,
+{0b00000000,
 0b11000000,
 0b11000000,
 0b11000000,
@@ -1893,9 +1882,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00000000,
 0b00001111,
-0b00001111,
+0b00001111},
 //110
-0b00000000,
+{0b00000000,
 0b11000000,
 0b11000000,
 0b01000000,
@@ -1910,9 +1899,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00001111,
-0b00001111,
+0b00001111},
 //111
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b01000000,
@@ -1927,9 +1916,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00000111,
+0b00000111},
 //112
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b01000000,
@@ -1944,9 +1933,9 @@ const UINT8 font8x16[128][16] = {
 0b00000100,
 0b00000100,
 0b00000111,
-0b00000011,
+0b00000011},
 //113
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b01000000,
@@ -1961,9 +1950,9 @@ const UINT8 font8x16[128][16] = {
 0b00000100,
 0b00000100,
 0b00111111,
-0b00111111,
+0b00111111},
 //114
-0b00000000,
+{0b00000000,
 0b11000000,
 0b11000000,
 0b10000000,
@@ -1978,9 +1967,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //115
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11000000,
 0b01000000,
@@ -1995,9 +1984,9 @@ const UINT8 font8x16[128][16] = {
 0b00001001,
 0b00001001,
 0b00001111,
-0b00000110,
+0b00000110},
 //116
-0b00000000,
+{0b00000000,
 0b01000000,
 0b11110000,
 0b11111000,
@@ -2012,9 +2001,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 //117
-0b00000000,
+{0b00000000,
 0b11000000,
 0b11000000,
 0b00000000,
@@ -2029,9 +2018,9 @@ const UINT8 font8x16[128][16] = {
 0b00001000,
 0b00001000,
 0b00001111,
-0b00001111,
+0b00001111},
 //118
-0b00000000,
+{0b00000000,
 0b11000000,
 0b11000000,
 0b00000000,
@@ -2046,9 +2035,9 @@ const UINT8 font8x16[128][16] = {
 0b00001100,
 0b00000110,
 0b00000011,
-0b00000001,
+0b00000001},
 //119
-0b00000000,
+{0b00000000,
 0b11000000,
 0b11000000,
 0b00000000,
@@ -2063,9 +2052,9 @@ const UINT8 font8x16[128][16] = {
 0b00000111,
 0b00001100,
 0b00001111,
-0b00000111,
+0b00000111},
 //120
-0b00000000,
+{0b00000000,
 0b01000000,
 0b11000000,
 0b10000000,
@@ -2080,9 +2069,9 @@ const UINT8 font8x16[128][16] = {
 0b00000011,
 0b00000111,
 0b00001100,
-0b00001000,
+0b00001000},
 //121
-0b00000000,
+{0b00000000,
 0b11000000,
 0b11000000,
 0b00000000,
@@ -2097,9 +2086,9 @@ const UINT8 font8x16[128][16] = {
 0b00100100,
 0b00110100,
 0b00011111,
-0b00001111,
+0b00001111},
 //122
-0b00000000,
+{0b00000000,
 0b01000000,
 0b01000000,
 0b01000000,
@@ -2114,9 +2103,9 @@ const UINT8 font8x16[128][16] = {
 0b00001011,
 0b00001001,
 0b00001000,
-0b00001000,
+0b00001000},
 //123
-0b00000000,
+{0b00000000,
 0b10000000,
 0b10000000,
 0b11110000,
@@ -2131,9 +2120,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 //124
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b01111000,
@@ -2148,9 +2137,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //125
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00001000,
 0b00001000,
@@ -2165,9 +2154,9 @@ const UINT8 font8x16[128][16] = {
 0b00001111,
 0b00000111,
 0b00000000,
-0b00000000,
+0b00000000},
 //126
-0b00110000,
+{0b00110000,
 0b00011000,
 0b00001000,
 0b00011000,
@@ -2182,9 +2171,9 @@ const UINT8 font8x16[128][16] = {
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //127
-0b00000000,
+{0b00000000,
 0b00000000,
 0b10000000,
 0b11000000,
@@ -2199,7 +2188,7 @@ const UINT8 font8x16[128][16] = {
 0b00000100,
 0b00000100,
 0b00000111,
-0b00000111
+0b00000111}
         
 };
 
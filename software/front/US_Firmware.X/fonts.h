@@ -22,1158 +22,1169 @@ const UINT8 degrees4x8[4] = {
 };
 
 
-const UINT8 font8x8[128][8]={
+const UINT8 degrees4x16[8] = {
+0b00000000,
+0b00001000,
+0b00010100,
+0b00001000,
 0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
+};
+
+const UINT8 font8x8[128][8]={
+{0b00000000,
+0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
+0b00000000,
+0b00000000},
 //1(Celsius)
-0b00000001,
+{0b00000001,
 0b00111101,
 0b01111110,
 0b01000010,
 0b01000010,
 0b01100110,
 0b00100100,
-0b00000000,
+0b00000000},
 //2(Farenheit)
-0b00000001,
+{0b00000001,
 0b01111101,
 0b01111110,
 0b00010010,
 0b00010010,
 0b00010010,
 0b00010010,
-0b00000000,
+0b00000000},
 //3(Power)
-0b00000000,
+{0b00000000,
 0b11100000,
 0b11000000,
 0b11101000,
 0b10111100,
 0b00010110,
 0b00000010,
-0b00000000,
+0b00000000},
 //4(Power
-0b00000000,
+{0b00000000,
 0b00011100,
 0b00100010,
 0b01000000,
 0b01001111,
 0b01000000,
 0b00100010,
-0b00011100,
+0b00011100},
 //5
-0b00011000,
+{0b00011000,
 0b10111010,
 0b11111111,
 0b11111111,
 0b11111111,
 0b10111010,
 0b00011000,
-0b00000000,
+0b00000000},
 
-0b00010000,
+{0b00010000,
 0b10111000,
 0b11111100,
 0b11111111,
 0b11111100,
 0b10111000,
 0b00010000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00011000,
 0b00111100,
 0b00111100,
 0b00011000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b11111111,
+{0b11111111,
 0b11111111,
 0b11100111,
 0b11000011,
 0b11000011,
 0b11100111,
 0b11111111,
-0b11111111,
+0b11111111},
 //9
-0b00000000,
+{0b00000000,
 0b00111100,
 0b01100110,
 0b01000010,
 0b01000010,
 0b01100110,
 0b00111100,
-0b00000000,
+0b00000000},
 
-0b11111111,
+{0b11111111,
 0b11000011,
 0b10011001,
 0b10111101,
 0b10111101,
 0b10011001,
 0b11000011,
-0b11111111,
+0b11111111},
 
-0b01110000,
+{0b01110000,
 0b11111000,
 0b10001000,
 0b10001000,
 0b11111101,
 0b01111111,
 0b00000111,
-0b00001111,
+0b00001111},
 
-0b00000000,
+{0b00000000,
 0b01001110,
 0b01011111,
 0b11110001,
 0b11110001,
 0b01011111,
 0b01001110,
-0b00000000,
+0b00000000},
 //12
-0b11000000,
+{0b11000000,
 0b11100000,
 0b11111111,
 0b01111111,
 0b00000101,
 0b00000101,
 0b00000111,
-0b00000111,
+0b00000111},
 
-0b11000000,
+{0b11000000,
 0b11111111,
 0b01111111,
 0b00000101,
 0b00000101,
 0b01100101,
 0b01111111,
-0b00111111,
+0b00111111},
 
-0b10011001,
+{0b10011001,
 0b01011010,
 0b00111100,
 0b11100111,
 0b11100111,
 0b00111100,
 0b01011010,
-0b10011001,
+0b10011001},
 
-0b01111111,
+{0b01111111,
 0b00111110,
 0b00111110,
 0b00011100,
 0b00011100,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 //16
-0b00001000,
+{0b00001000,
 0b00001000,
 0b00011100,
 0b00011100,
 0b00111110,
 0b00111110,
 0b01111111,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00100100,
 0b01100110,
 0b11111111,
 0b11111111,
 0b01100110,
 0b00100100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01011111,
 0b01011111,
 0b00000000,
 0b00000000,
 0b01011111,
 0b01011111,
-0b00000000,
+0b00000000},
 
-0b00000110,
+{0b00000110,
 0b00001111,
 0b00001001,
 0b01111111,
 0b01111111,
 0b00000001,
 0b01111111,
-0b01111111,
+0b01111111},
 //20
-0b01000000,
+{0b01000000,
 0b11011010,
 0b10111111,
 0b10100101,
 0b11111101,
 0b01011001,
 0b00000011,
-0b00000010,
+0b00000010},
 
-0b00000000,
+{0b00000000,
 0b01110000,
 0b01110000,
 0b01110000,
 0b01110000,
 0b01110000,
 0b01110000,
-0b00000000,
+0b00000000},
 
-0b10000000,
+{0b10000000,
 0b10010100,
 0b10110110,
 0b11111111,
 0b11111111,
 0b10110110,
 0b10010100,
-0b10000000,
+0b10000000},
 
-0b00000000,
+{0b00000000,
 0b00000100,
 0b00000110,
 0b01111111,
 0b01111111,
 0b00000110,
 0b00000100,
-0b00000000,
+0b00000000},
 //24
-0b00000000,
+{0b00000000,
 0b00010000,
 0b00110000,
 0b01111111,
 0b01111111,
 0b00110000,
 0b00010000,
-0b00000000,
+0b00000000},
 
-0b00001000,
+{0b00001000,
 0b00001000,
 0b00001000,
 0b00101010,
 0b00111110,
 0b00011100,
 0b00001000,
-0b00000000,
+0b00000000},
 
-0b00001000,
+{0b00001000,
 0b00011100,
 0b00111110,
 0b00101010,
 0b00001000,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 
-0b00111100,
+{0b00111100,
 0b00111100,
 0b00100000,
 0b00100000,
 0b00100000,
 0b00100000,
 0b00100000,
-0b00000000,
+0b00000000},
 //28
-0b00001000,
+{0b00001000,
 0b00011100,
 0b00111110,
 0b00001000,
 0b00001000,
 0b00111110,
 0b00011100,
-0b00001000,
+0b00001000},
 
-0b00110000,
+{0b00110000,
 0b00111000,
 0b00111100,
 0b00111110,
 0b00111110,
 0b00111100,
 0b00111000,
-0b00110000,
+0b00110000},
 
-0b00000110,
+{0b00000110,
 0b00001110,
 0b00011110,
 0b00111110,
 0b00111110,
 0b00011110,
 0b00001110,
-0b00000110,
+0b00000110},
 
+{0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
-0b00000000,
+0b00000000},
 //32
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000110,
 0b01011111,
 0b01011111,
 0b00000110,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000111,
 0b00000111,
 0b00000000,
 0b00000111,
 0b00000111,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00010100,
+{0b00010100,
 0b01111111,
 0b01111111,
 0b00010100,
 0b01111111,
 0b01111111,
 0b00010100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00100100,
 0b00101110,
 0b01101011,
 0b01101011,
 0b00111010,
 0b00010010,
-0b00000000,
+0b00000000},
 //36
-0b01000110,
+{0b01000110,
 0b01100110,
 0b00110000,
 0b00011000,
 0b00001100,
 0b01100110,
 0b01100010,
-0b00000000,
+0b00000000},
 
-0b00110000,
+{0b00110000,
 0b01111010,
 0b01001111,
 0b01011101,
 0b00110111,
 0b01111010,
 0b01001000,
-0b00000000,
+0b00000000},
 
-0b00000100,
+{0b00000100,
 0b00000111,
 0b00000011,
 0b00000000,
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00011100,
 0b00111110,
 0b01100011,
 0b01000001,
 0b00000000,
-0b00000000,
+0b00000000},
 //40
-0b00000000,
+{0b00000000,
 0b00000000,
 0b01000001,
 0b01100011,
 0b00111110,
 0b00011100,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00001000,
+{0b00001000,
 0b00101010,
 0b00111110,
 0b00011100,
 0b00011100,
 0b00111110,
 0b00101010,
-0b00001000,
+0b00001000},
 
-0b00000000,
+{0b00000000,
 0b00001000,
 0b00001000,
 0b00111110,
 0b00111110,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b10000000,
 0b11100000,
 0b01100000,
 0b00000000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 //44
-0b00000000,
+{0b00000000,
 0b00001000,
 0b00001000,
 0b00001000,
 0b00001000,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b01100000,
 0b01100000,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b01100000,
+{0b01100000,
 0b00110000,
 0b00011000,
 0b00001100,
 0b00000110,
 0b00000011,
 0b00000001,
-0b00000000,
+0b00000000},
 
-0b00111110,
+{0b00111110,
 0b01111111,
 0b01010001,
 0b01001001,
 0b01000101,
 0b01111111,
 0b00111110,
-0b00000000,
+0b00000000},
 //48
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000010,
 0b01111111,
 0b01111111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01100010,
 0b01110011,
 0b01011001,
 0b01001001,
 0b01001111,
 0b01000110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00100010,
 0b01100011,
 0b01001001,
 0b01001001,
 0b01111111,
 0b00110110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00011000,
 0b00011100,
 0b00010110,
 0b00010011,
 0b01111111,
 0b01111111,
-0b00000000,
+0b00000000},
 //52
-0b00000000,
+{0b00000000,
 0b00100111,
 0b01100111,
 0b01000101,
 0b01000101,
 0b01111101,
 0b00111001,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111100,
 0b01111110,
 0b01001011,
 0b01001001,
 0b01111001,
 0b00110000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01000001,
 0b01100001,
 0b00110001,
 0b00011001,
 0b00001111,
 0b00000111,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00110110,
 0b01111111,
 0b01001001,
 0b01001001,
 0b01111111,
 0b00110110,
-0b00000000,
+0b00000000},
 //56
-0b00000000,
+{0b00000000,
 0b00000110,
 0b01001111,
 0b01001001,
 0b01101001,
 0b00111111,
 0b00011110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b01100110,
 0b01100110,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b10000000,
 0b11100110,
 0b01100110,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00001000,
 0b00011100,
 0b00110110,
 0b01100011,
 0b01000001,
 0b00000000,
-0b00000000,
+0b00000000},
 //60
-0b00000000,
+{0b00000000,
 0b00100100,
 0b00100100,
 0b00100100,
 0b00100100,
 0b00100100,
 0b00100100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01000001,
 0b01100011,
 0b00110110,
 0b00011100,
 0b00001000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000010,
 0b00000011,
 0b01010001,
 0b01011001,
 0b00001111,
 0b00000110,
-0b00000000,
+0b00000000},
 
-0b00111110,
+{0b00111110,
 0b01111111,
 0b01000001,
 0b01011101,
 0b01011101,
 0b00011111,
 0b00011110,
-0b00000000,
+0b00000000},
 //64
-0b00000000,
+{0b00000000,
 0b01111100,
 0b01111110,
 0b00010011,
 0b00010001,
 0b01111111,
 0b01111110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b01001001,
 0b01001001,
 0b01111111,
 0b00110110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111110,
 0b01111111,
 0b01000001,
 0b01000001,
 0b01100011,
 0b00100010,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b01000001,
 0b01000001,
 0b01111111,
 0b00111110,
-0b00000000,
+0b00000000},
 //68
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b01001001,
 0b01001001,
 0b01001001,
 0b01000001,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b00001001,
 0b00001001,
 0b00001001,
 0b00000001,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111110,
 0b01111111,
 0b01000001,
 0b01010001,
 0b01110011,
 0b01110010,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b00001000,
 0b00001000,
 0b01111111,
 0b01111111,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b01111111,
 0b01111111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00110000,
 0b01110000,
 0b01000000,
 0b01000000,
 0b01111111,
 0b00111111,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b00001000,
 0b00011100,
 0b01110111,
 0b01100011,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b01000000,
 0b01000000,
 0b01000000,
 0b01000000,
-0b00000000,
+0b00000000},
 
-0b01111111,
+{0b01111111,
 0b01111111,
 0b00001110,
 0b00011100,
 0b00001110,
 0b01111111,
 0b01111111,
-0b00000000,
+0b00000000},
 
-0b01111111,
+{0b01111111,
 0b01111111,
 0b00000110,
 0b00001100,
 0b00011000,
 0b01111111,
 0b01111111,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111110,
 0b01111111,
 0b01000001,
 0b01000001,
 0b01111111,
 0b00111110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b00010001,
 0b00010001,
 0b00011111,
 0b00001110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00011110,
 0b00111111,
 0b00100001,
 0b01110001,
 0b01111111,
 0b01011110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b00001001,
 0b00011001,
 0b01111111,
 0b01100110,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00100110,
 0b01101111,
 0b01001101,
 0b01011001,
 0b01110011,
 0b00110010,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000001,
 0b00000001,
 0b01111111,
 0b01111111,
 0b00000001,
 0b00000001,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111111,
 0b01111111,
 0b01000000,
 0b01000000,
 0b01111111,
 0b00111111,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00011111,
 0b00111111,
 0b01100000,
 0b01100000,
 0b00111111,
 0b00011111,
-0b00000000,
+0b00000000},
 
-0b01111111,
+{0b01111111,
 0b01111111,
 0b00110000,
 0b00011000,
 0b00110000,
 0b01111111,
 0b01111111,
-0b00000000,
+0b00000000},
 
-0b01000011,
+{0b01000011,
 0b01100111,
 0b00111100,
 0b00011000,
 0b00111100,
 0b01100111,
 0b01000011,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000111,
 0b00001111,
 0b01111000,
 0b01111000,
 0b00001111,
 0b00000111,
-0b00000000,
+0b00000000},
 
-0b01000001,
+{0b01000001,
 0b01100001,
 0b01110001,
 0b01011001,
 0b01001101,
 0b01000111,
 0b01000011,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b01111111,
 0b01111111,
 0b01000001,
 0b01000001,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000001,
+{0b00000001,
 0b00000011,
 0b00000110,
 0b00001100,
 0b00011000,
 0b00110000,
 0b01100000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b01000001,
 0b01000001,
 0b01111111,
 0b01111111,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00001000,
+{0b00001000,
 0b00001100,
 0b00000110,
 0b00000011,
 0b00000110,
 0b00001100,
 0b00001000,
-0b00000000,
+0b00000000},
 
+{0b10000000,
 0b10000000,
 0b10000000,
 0b10000000,
 0b10000000,
 0b10000000,
 0b10000000,
-0b10000000,
-0b10000000,
+0b10000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000011,
 0b00000111,
 0b00000100,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01100000,
 0b01110100,
 0b01010100,
 0b00010100,
 0b01111100,
 0b01111000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b01000100,
 0b01001100,
 0b01111000,
 0b00110000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111000,
 0b01111100,
 0b01000100,
 0b01000100,
 0b01101100,
 0b00101000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00110000,
 0b01111000,
 0b01001100,
 0b01000100,
 0b01111111,
 0b01111111,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111000,
 0b01111100,
 0b01010100,
 0b01010100,
 0b01011100,
 0b00011000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111110,
 0b01111111,
 0b00001001,
 0b00001001,
 0b00000011,
 0b00000010,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b10011000,
 0b10111100,
 0b10100100,
 0b10100100,
 0b11111100,
 0b01111100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b00001000,
 0b00000100,
 0b01111100,
 0b01111000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b01111101,
 0b01111101,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01100000,
 0b11100000,
 0b10000000,
 0b10000000,
 0b11111101,
 0b01111101,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111111,
 0b01111111,
 0b00010000,
 0b00111000,
 0b01101100,
 0b01000100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b01111111,
 0b01111111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b01111100,
+{0b01111100,
 0b01111100,
 0b00011000,
 0b00111000,
 0b00011100,
 0b01111100,
 0b01111000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111100,
 0b01111100,
 0b00000100,
 0b00000100,
 0b01111100,
 0b01111000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111000,
 0b01111100,
 0b01000100,
 0b01000100,
 0b01111100,
 0b00111000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b11111100,
 0b11111100,
 0b00100100,
 0b00100100,
 0b00111100,
 0b00011000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00011000,
 0b00111100,
 0b00100100,
 0b00100100,
 0b11111100,
 0b11111100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01111100,
 0b01111100,
 0b00001000,
 0b00001100,
 0b00000100,
 0b00000100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01001000,
 0b01011100,
 0b01010100,
 0b01010100,
 0b01110100,
 0b00100100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111110,
 0b01111111,
 0b01000100,
 0b01100100,
 0b00100100,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00111100,
 0b01111100,
 0b01000000,
 0b01000000,
 0b01111100,
 0b01111100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00011100,
 0b00111100,
 0b01100000,
 0b01100000,
 0b00111100,
 0b00011100,
-0b00000000,
+0b00000000},
 
-0b00111100,
+{0b00111100,
 0b01111100,
 0b01110000,
 0b00111000,
 0b01110000,
 0b01111100,
 0b00111100,
-0b00000000,
+0b00000000},
 
-0b01000100,
+{0b01000100,
 0b01101100,
 0b00111000,
 0b00010000,
 0b00111000,
 0b01101100,
 0b01000100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b10011100,
 0b10111100,
 0b10100000,
 0b10100000,
 0b11111100,
 0b01111100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01000100,
 0b01100100,
 0b01110100,
 0b01011100,
 0b01001100,
 0b01000100,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00001000,
 0b00001000,
 0b00111110,
 0b01110111,
 0b01000001,
 0b01000001,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b00000000,
 0b00000000,
 0b01110111,
 0b01110111,
 0b00000000,
 0b00000000,
-0b00000000,
+0b00000000},
 
-0b00000000,
+{0b00000000,
 0b01000001,
 0b01000001,
 0b01110111,
 0b00111110,
 0b00001000,
 0b00001000,
-0b00000000,
+0b00000000},
 
-0b00000010,
+{0b00000010,
 0b00000011,
 0b00000001,
 0b00000011,
 0b00000010,
 0b00000011,
 0b00000001,
-0b00000000,
+0b00000000},
 
-0b01110000,
+{0b01110000,
 0b01111000,
 0b01001100,
 0b01000110,
 0b01001100,
 0b01111000,
 0b01110000,
-0b00000000
+0b00000000}
         
 };
 
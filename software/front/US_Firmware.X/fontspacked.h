@@ -0,0 +1,259 @@
+/*
+ * File:   fontspacked.h
+ *
+ * Generated by US_Simulator/fontpack (make fonts) from font32x48numbers.h, font8x16.h and logo.h, do not edit.
+ */
+
+#ifndef FONTSPACKED_H
+#define	FONTSPACKED_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+//font32x48numbers.h: 12 glyphs of 32x48, 2304 bytes packed to 1019
+static const UINT16 numbers32x48Base[6] = {
+    0x0000, 0x0090, 0x0143, 0x01DA, 0x0286, 0x0351,
+};
+
+static const UINT8 numbers32x48Offs[12] = {
+    0x00, 0x58, 0x00, 0x58, 0x00, 0x4A, 0x00, 0x5E, 0x00, 0x6D, 0x00, 0x54,
+};
+
+static const UINT8 numbers32x48Data[995] = {
+    0x00, 0xC0, 0x80, 0xAE, 0xC0, 0xAB, 0xE0, 0xAA, 0xEB, 0xC0, 0x80, 0x02, 0x00, 0xC0, 0xE0, 0x5F,
+    0xF8, 0xFE, 0x55, 0xBF, 0x3F, 0x1F, 0x0F, 0xFA, 0x1F, 0x3F, 0x55, 0xF5, 0xFE, 0xF8, 0x03, 0xE0,
+    0x70, 0xFE, 0x55, 0xD5, 0x01, 0x00, 0x00, 0x57, 0x01, 0x55, 0x0D, 0xFE, 0x70, 0x7F, 0x55, 0xD5,
+    0x80, 0x00, 0x00, 0x57, 0x80, 0x55, 0x0D, 0x7F, 0xC0, 0x07, 0x5F, 0x1F, 0x7F, 0x55, 0xBF, 0xFC,
+    0xF8, 0xF0, 0xFA, 0xF8, 0xFC, 0x55, 0xF5, 0x7F, 0x1F, 0x03, 0x07, 0x00, 0xC0, 0x01, 0xAE, 0x03,
+    0xAB, 0x07, 0xAA, 0xEB, 0x03, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0xAC, 0xC0, 0xAA, 0x02, 0x00,
+    0x00, 0x00, 0xAB, 0xF8, 0xEE, 0xFC, 0xFE, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0xAB, 0x01, 0xAA,
+    0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55, 0x01, 0x00, 0x00, 0x00, 0xAB, 0xF0,
+    0xAA, 0x55, 0x55, 0xAD, 0xF0, 0xAA, 0x00, 0x00, 0xAB, 0x03, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x00,
+    0x00, 0xBB, 0x80, 0xC0, 0xBA, 0xE0, 0xAA, 0xAA, 0xEB, 0xC0, 0x80, 0x00, 0x00, 0x00, 0xFB, 0x7F,
+    0x3F, 0x1F, 0xBA, 0x0F, 0xAA, 0x7B, 0x1F, 0x7F, 0x55, 0xFD, 0xFE, 0xFC, 0xF0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x7F, 0x80, 0xC0, 0xF0, 0x55, 0xF5, 0x3F, 0x0F, 0x00, 0x00, 0x00, 0xFB, 0x80, 0xC0,
+    0xE0, 0xFF, 0xF0, 0xF8, 0xFC, 0xFE, 0xD5, 0x7F, 0xFF, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x01, 0x00,
+    0xC0, 0xF0, 0x7F, 0xF8, 0xFC, 0xFE, 0x55, 0xD5, 0xFB, 0xAF, 0xF9, 0xF8, 0xAA, 0xAA, 0x0A, 0xC0,
+    0x03, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x0A, 0x00, 0xBB, 0x80, 0xC0, 0xBA, 0xE0, 0xAA, 0xAA,
+    0xAE, 0xC0, 0x0B, 0x80, 0x00, 0x00, 0xBB, 0x7F, 0x3F, 0xEB, 0x1F, 0x0F, 0xAA, 0xFA, 0x1F, 0x3F,
+    0x55, 0xD5, 0xFE, 0x03, 0xF8, 0x00, 0x00, 0xC0, 0xF0, 0xAA, 0xEE, 0xF8, 0xFC, 0xD5, 0xBF, 0xFE,
+    0x1F, 0x0F, 0x07, 0x03, 0x01, 0x00, 0x00, 0xC0, 0x03, 0xAA, 0xBA, 0x07, 0x57, 0x0F, 0xD5, 0xFE,
+    0x0F, 0xFC, 0xF0, 0xC0, 0xFE, 0xEE, 0xFC, 0xF8, 0xBA, 0xF0, 0xAA, 0xFA, 0xF8, 0xFC, 0x57, 0xFE,
+    0xF5, 0x7F, 0x3F, 0x0F, 0x1F, 0x07, 0xC0, 0x01, 0xAE, 0x03, 0xAE, 0x07, 0xAA, 0xAA, 0xEB, 0x03,
+    0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0xAB, 0xC0, 0xAA, 0x0A, 0x00, 0x00, 0x00, 0xF0, 0xC0,
+    0xE0, 0x7F, 0xF0, 0xFC, 0xFE, 0x55, 0x55, 0x05, 0x00, 0xC0, 0x80, 0xFF, 0xC0, 0xE0, 0xF8, 0xFC,
+    0xD7, 0xFE, 0x3F, 0xFF, 0x1F, 0x0F, 0x07, 0x01, 0x54, 0x55, 0x05, 0x00, 0x7C, 0xFC, 0xFE, 0x55,
+    0xBF, 0xFB, 0xF9, 0xF8, 0xAA, 0x56, 0x55, 0xB5, 0xF8, 0x2A, 0xAC, 0x03, 0xAA, 0xAA, 0xAA, 0x56,
+    0x55, 0xB5, 0x03, 0x2A, 0x00, 0x00, 0x00, 0x00, 0xAC, 0x03, 0xAA, 0x0A, 0x00, 0x00, 0xAC, 0xC0,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x02, 0x00, 0x54, 0x55, 0xB5, 0x1F, 0xAA, 0xAA, 0xAA, 0x02, 0x00,
+    0x54, 0x55, 0xB5, 0xF8, 0xAA, 0xBA, 0xF0, 0xFE, 0xE0, 0xC0, 0x80, 0x00, 0x00, 0xAC, 0x07, 0xAB,
+    0x03, 0xAA, 0xEE, 0x07, 0x0F, 0x57, 0x1F, 0x55, 0x0D, 0xFC, 0xC0, 0xFE, 0xEE, 0xFC, 0xF8, 0xBA,
+    0xF0, 0xAA, 0xEE, 0xF8, 0xFC, 0x57, 0xFE, 0xF5, 0x7F, 0x3F, 0x0F, 0x0F, 0x03, 0xC0, 0x01, 0xAE,
+    0x03, 0xAE, 0x07, 0xAA, 0xAA, 0xEB, 0x03, 0x01, 0x02, 0x00, 0x00, 0x00, 0xB0, 0x80, 0xAB, 0xC0,
+    0xAB, 0xE0, 0xAA, 0x3A, 0xC0, 0x00, 0x00, 0xFF, 0xC0, 0xF0, 0xF8, 0xFC, 0x57, 0xFE, 0xFD, 0x7F,
+    0x3F, 0x1F, 0xAE, 0x0F, 0xAA, 0x2E, 0x1F, 0x00, 0x70, 0xF0, 0x55, 0xD5, 0xF7, 0xEF, 0xF0, 0xF8,
+    0xFC, 0xAA, 0xEA, 0xF8, 0xFE, 0xF0, 0xE0, 0xC0, 0x03, 0x80, 0x50, 0x55, 0xD5, 0x01, 0x00, 0xB0,
+    0x01, 0x57, 0x07, 0x55, 0x0D, 0xFC, 0xC0, 0x07, 0x5F, 0x1F, 0x3F, 0x55, 0xBF, 0xF8, 0xF0, 0xE0,
+    0xFA, 0xF0, 0xF8, 0x57, 0xFC, 0xF5, 0x7F, 0x3F, 0x0F, 0x0F, 0x03, 0x00, 0x00, 0xAF, 0x01, 0x03,
+    0xAB, 0x07, 0xAA, 0xEE, 0x03, 0x01, 0x02, 0x00, 0xC0, 0xC0, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0x0A, 0xC0, 0x1F, 0xAA, 0xAA, 0xAA, 0xEA, 0xDF, 0x55, 0x55, 0x0D, 0x3F, 0x00, 0x00, 0x00, 0xF0,
+    0x80, 0xE0, 0x5F, 0xF8, 0xFC, 0x55, 0xFF, 0x7F, 0x3F, 0x0F, 0x03, 0x00, 0x00, 0x00, 0xF0, 0xC0,
+    0xF0, 0x5F, 0xF8, 0xFE, 0x55, 0xFF, 0x7F, 0x1F, 0x07, 0x01, 0x00, 0x00, 0x00, 0xFC, 0x80, 0xE0,
+    0xF0, 0x57, 0xFC, 0x55, 0x3F, 0x3F, 0x0F, 0x03, 0x00, 0x00, 0x00, 0x00, 0xAF, 0x02, 0x03, 0xAA,
+    0x3A, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x80, 0xAE, 0xC0, 0xAB, 0xE0, 0xAA, 0xAE, 0xC0,
+    0x0B, 0x80, 0x00, 0xC0, 0xF0, 0x5F, 0xFC, 0xFE, 0x55, 0xBF, 0x1F, 0x0F, 0x07, 0xFA, 0x0F, 0x1F,
+    0x55, 0xD5, 0xFE, 0x03, 0xF8, 0xC0, 0x03, 0xFF, 0x0F, 0x1F, 0x3F, 0x7F, 0x55, 0xBF, 0xFE, 0xFC,
+    0xF8, 0xEE, 0xF0, 0xFC, 0xD5, 0xBF, 0xFE, 0x1F, 0x0F, 0x07, 0x03, 0x01, 0xF0, 0xE0, 0xF8, 0x6F,
+    0xFC, 0xFE, 0xD5, 0x1F, 0xEF, 0x07, 0x03, 0x07, 0xEE, 0x0F, 0x1F, 0x57, 0x3F, 0xD5, 0xFE, 0x0F,
+    0xF8, 0xE0, 0xF0, 0x0F, 0x3F, 0x57, 0x7F, 0xD5, 0xFC, 0xBF, 0xF8, 0xF0, 0xE0, 0xEA, 0xF0, 0x57,
+    0xF8, 0xD5, 0x7F, 0x0F, 0x1F, 0x07, 0x00, 0xB0, 0x01, 0xEB, 0x03, 0x07, 0xAA, 0xAA, 0xAE, 0x03,
+    0x03, 0x01, 0x00, 0x00, 0xC0, 0x80, 0xAE, 0xC0, 0xAB, 0xE0, 0xAA, 0xEB, 0xC0, 0x80, 0x02, 0x00,
+    0xF0, 0xC0, 0xF0, 0x5F, 0xFC, 0xFE, 0xD5, 0x7F, 0xBF, 0x1F, 0x0F, 0x07, 0xFA, 0x0F, 0x1F, 0x55,
+    0xF5, 0xFE, 0xF8, 0x03, 0xE0, 0x70, 0x3F, 0x55, 0xD5, 0xE0, 0x0B, 0x80, 0x00, 0x57, 0x80, 0x55,
+    0x05, 0xC0, 0x01, 0xFF, 0x03, 0x07, 0x0F, 0x1F, 0xAE, 0x3F, 0xAA, 0xEE, 0x1F, 0x0F, 0x57, 0xEF,
+    0x55, 0x0D, 0x0F, 0x00, 0xEC, 0xF8, 0xF0, 0xAA, 0xEA, 0xF8, 0x7E, 0xFC, 0xFE, 0xD5, 0x7F, 0xFF,
+    0x3F, 0x1F, 0x0F, 0x03, 0x00, 0x00, 0xBC, 0x03, 0x07, 0xAA, 0xAA, 0xAB, 0x03, 0x0B, 0x01, 0x00,
+    0x00, 0xBC, 0x80, 0xC0, 0x3A, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x0F, 0x1F, 0x39,
+    0x30, 0xFE, 0x39, 0x1F, 0x8F, 0xAB, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xE0, 0xF8, 0xFF,
+    0xFE, 0x3F, 0x0F, 0x07, 0xEB, 0x03, 0x07, 0xFF, 0x0F, 0x1F, 0x1E, 0x18, 0x00, 0x00, 0x00, 0x00,
+    0xF0, 0x0F, 0x3F, 0xFD, 0xF8, 0xE0, 0xC0, 0xEB, 0x80, 0xC0, 0xEF, 0xE0, 0xF8, 0x38, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xEC, 0x01, 0x03, 0xAA, 0x0B, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xBC, 0x80, 0xC0, 0x3A, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0x0F, 0x1F, 0x39, 0x30, 0xFE, 0x39, 0x1F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xD5, 0x87, 0xAA, 0x3A, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0xD5, 0x03, 0xAA, 0x0A, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x2B, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00,
+};
+
+const t_OLEDPacked numbers32x48Packed = {32, 6, 1, numbers32x48Base, numbers32x48Offs, numbers32x48Data};
+
+//font8x16.h: 128 glyphs of 8x16, 2048 bytes packed to 1635
+static const UINT16 font8x16Base[8] = {
+    0x0000, 0x00D7, 0x0194, 0x0235, 0x02F5, 0x03B3, 0x046D, 0x051B,
+};
+
+static const UINT8 font8x16Offs[128] = {
+    0x00, 0x04, 0x13, 0x1D, 0x2B, 0x3B, 0x4D, 0x5F, 0x69, 0x77, 0x85, 0x97, 0xA5, 0xB1, 0xBC, 0xC9,
+    0x00, 0x0D, 0x1A, 0x28, 0x34, 0x40, 0x52, 0x57, 0x65, 0x6F, 0x79, 0x85, 0x91, 0x98, 0xA7, 0xB3,
+    0x00, 0x04, 0x0C, 0x12, 0x20, 0x30, 0x3E, 0x4F, 0x54, 0x60, 0x6C, 0x7C, 0x84, 0x8B, 0x90, 0x95,
+    0x00, 0x12, 0x1A, 0x2A, 0x38, 0x41, 0x4E, 0x5C, 0x67, 0x75, 0x82, 0x88, 0x90, 0x9F, 0xA5, 0xB4,
+    0x00, 0x12, 0x1F, 0x2B, 0x39, 0x46, 0x4F, 0x57, 0x66, 0x6F, 0x79, 0x83, 0x92, 0x99, 0xA4, 0xB0,
+    0x00, 0x0B, 0x1B, 0x28, 0x38, 0x40, 0x4B, 0x57, 0x63, 0x75, 0x80, 0x8E, 0x96, 0xA2, 0xAA, 0xB5,
+    0x00, 0x07, 0x13, 0x1F, 0x2D, 0x38, 0x46, 0x51, 0x5E, 0x68, 0x6E, 0x77, 0x85, 0x8B, 0x96, 0xA0,
+    0x00, 0x0D, 0x19, 0x22, 0x2D, 0x38, 0x42, 0x4E, 0x5A, 0x6B, 0x77, 0x84, 0x8F, 0x95, 0xA0, 0xAC,
+};
+
+static const UINT8 font8x16Data[1491] = {
+    0x00, 0x00, 0x00, 0x00, 0xFC, 0x0C, 0xEC, 0xF0, 0xFB, 0x10, 0x70, 0x60, 0xF0, 0x07, 0x0F, 0xFB,
+    0x08, 0x0E, 0x06, 0xFC, 0x0C, 0xEC, 0xF0, 0xAB, 0x10, 0xB0, 0x0F, 0xAB, 0x01, 0xEF, 0xC0, 0xE0,
+    0xC0, 0xEE, 0xE0, 0xC0, 0xFC, 0x01, 0x03, 0x07, 0x3E, 0x03, 0x01, 0xFF, 0x80, 0xC0, 0xE0, 0xF0,
+    0xFE, 0xE0, 0xC0, 0x80, 0xFC, 0x01, 0x03, 0x07, 0x3E, 0x03, 0x01, 0xFF, 0x80, 0xC0, 0xB0, 0xF8,
+    0xFE, 0xB0, 0xC0, 0x80, 0xFF, 0x01, 0x03, 0x0B, 0x0D, 0xFE, 0x0B, 0x03, 0x01, 0xFF, 0x80, 0xC0,
+    0xE0, 0xF0, 0xFE, 0xE0, 0xC0, 0x80, 0xFF, 0x01, 0x03, 0x09, 0x0F, 0xFE, 0x09, 0x03, 0x01, 0xF0,
+    0x80, 0xC0, 0x0E, 0x80, 0xF0, 0x01, 0x03, 0x0E, 0x01, 0xFB, 0xFE, 0x7E, 0x3E, 0xBE, 0x7E, 0xFE,
+    0xFB, 0x7F, 0x7E, 0x7C, 0xBE, 0x7E, 0x7F, 0xFC, 0xC0, 0x60, 0x20, 0x3E, 0x60, 0xC0, 0xFC, 0x03,
+    0x06, 0x04, 0x3E, 0x06, 0x03, 0xFF, 0xFE, 0x3E, 0x9E, 0xDE, 0xFE, 0x9E, 0x3E, 0xFE, 0xFF, 0x7F,
+    0x7C, 0x79, 0x7B, 0xFE, 0x79, 0x7C, 0x7F, 0xB0, 0x80, 0xFF, 0xC8, 0xF8, 0x38, 0x78, 0xFC, 0x07,
+    0x0F, 0x08, 0x3E, 0x0F, 0x07, 0xFC, 0x70, 0xF8, 0x88, 0x3E, 0xF8, 0x70, 0xEC, 0x02, 0x0F, 0x2E,
+    0x02, 0xB0, 0xF8, 0xBB, 0x28, 0x38, 0xFF, 0x0C, 0x0E, 0x0F, 0x07, 0x00, 0xEC, 0xF8, 0x28, 0xBA,
+    0xF8, 0x3F, 0x1C, 0x1F, 0x0F, 0xFC, 0x0E, 0x0F, 0x07, 0xFB, 0xA0, 0xC0, 0x70, 0xBE, 0xC0, 0xA0,
+    0xFB, 0x02, 0x01, 0x07, 0xBE, 0x01, 0x02, 0xFC, 0xF8, 0xF0, 0xE0, 0xBB, 0xC0, 0x80, 0xFC, 0x0F,
+    0x07, 0x03, 0x0B, 0x01, 0xEC, 0x80, 0xC0, 0xFE, 0xE0, 0xF0, 0xF8, 0xC0, 0x01, 0xFE, 0x03, 0x07,
+    0x0F, 0xFC, 0x20, 0x30, 0xF8, 0x3E, 0x30, 0x20, 0xFC, 0x02, 0x06, 0x0F, 0x3E, 0x06, 0x02, 0xFC,
+    0x70, 0xF8, 0x70, 0xFC, 0x70, 0xF8, 0x70, 0x30, 0x0D, 0x30, 0x0D, 0xFF, 0x70, 0xF8, 0x88, 0xF8,
+    0xBE, 0x08, 0xF8, 0xC0, 0x0F, 0xB2, 0x0F, 0xFC, 0x88, 0xDC, 0x74, 0xFF, 0x24, 0x64, 0xCC, 0x88,
+    0xFC, 0x11, 0x33, 0x26, 0xFF, 0x24, 0x2E, 0x3B, 0x11, 0x00, 0x00, 0xAC, 0x0E, 0xAA, 0xFC, 0x20,
+    0x30, 0xF8, 0x3E, 0x30, 0x20, 0xFC, 0x12, 0x16, 0x1F, 0x3E, 0x16, 0x12, 0xFC, 0x20, 0x30, 0xF8,
+    0x3E, 0x30, 0x20, 0xC0, 0x0F, 0x02, 0xC0, 0xF8, 0x02, 0xFC, 0x02, 0x06, 0x0F, 0x3E, 0x06, 0x02,
+    0xAB, 0x80, 0xFF, 0xA0, 0xE0, 0xC0, 0x80, 0x00, 0x3F, 0x02, 0x03, 0x01, 0xFF, 0x80, 0xC0, 0xE0,
+    0xA0, 0xAB, 0x80, 0xFC, 0x01, 0x03, 0x02, 0x00, 0x2C, 0xC0, 0x00, 0xEC, 0x03, 0x02, 0xAA, 0xFF,
+    0x80, 0xC0, 0xE0, 0x80, 0xFE, 0xE0, 0xC0, 0x80, 0x3C, 0x01, 0x03, 0x3C, 0x03, 0x01, 0xF0, 0x80,
+    0xE0, 0x3F, 0xF0, 0xE0, 0x80, 0xBC, 0x06, 0x07, 0xEA, 0x06, 0xBC, 0x30, 0xF0, 0xEA, 0x30, 0xC0,
+    0x03, 0x0F, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x38, 0xFC, 0x0E, 0x38, 0xC0, 0x0D, 0x02,
+    0x2C, 0x3C, 0x2C, 0x3C, 0x00, 0x00, 0xBC, 0x20, 0xF8, 0xEF, 0x20, 0xF8, 0x20, 0xBC, 0x02, 0x0F,
+    0xEF, 0x02, 0x0F, 0x02, 0xFC, 0x70, 0xF8, 0x88, 0xFB, 0x8E, 0x98, 0x30, 0xFC, 0x06, 0x0C, 0x08,
+    0xFB, 0x38, 0x0F, 0x07, 0x2C, 0x30, 0xFF, 0x80, 0xC0, 0x60, 0x30, 0xFC, 0x0C, 0x06, 0x03, 0xB3,
+    0x01, 0x0C, 0xF0, 0xB0, 0xF8, 0xFF, 0xC8, 0x78, 0xB0, 0x80, 0xFC, 0x07, 0x0F, 0x08, 0xFF, 0x09,
+    0x07, 0x0F, 0x08, 0x00, 0x0B, 0x3C, 0x00, 0x00, 0xC0, 0xE0, 0x3F, 0xF0, 0x18, 0x08, 0xC0, 0x03,
+    0x3F, 0x07, 0x0C, 0x08, 0xF0, 0x08, 0x18, 0x0F, 0xF0, 0xE0, 0xF0, 0x08, 0x0C, 0x0F, 0x07, 0x03,
+    0xFC, 0x80, 0xA0, 0xE0, 0xFF, 0xC0, 0xE0, 0xA0, 0x80, 0xF0, 0x02, 0x03, 0x3F, 0x01, 0x03, 0x02,
+    0xEB, 0x80, 0xF0, 0xAE, 0x80, 0xC0, 0x07, 0x02, 0x00, 0x00, 0xC0, 0x10, 0x0F, 0x1E, 0x0E, 0xAC,
+    0x80, 0xAA, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x0C, 0x02, 0x00, 0xFF, 0x80, 0xC0, 0x60, 0x30, 0xFC,
+    0x0C, 0x06, 0x03, 0x03, 0x01, 0xFC, 0xE0, 0xF0, 0x18, 0xFF, 0x08, 0x18, 0xF0, 0xE0, 0xFC, 0x03,
+    0x07, 0x0C, 0xFF, 0x08, 0x0C, 0x07, 0x03, 0xF0, 0x20, 0x30, 0x0B, 0xF8, 0x00, 0x0B, 0x0F, 0xFC,
+    0x10, 0x18, 0x08, 0xFF, 0x88, 0xC8, 0x78, 0x30, 0xFC, 0x0C, 0x0E, 0x0B, 0xAF, 0x09, 0x08, 0xFC,
+    0x10, 0x18, 0x88, 0xFA, 0xF8, 0x70, 0xFC, 0x04, 0x0C, 0x08, 0xFA, 0x0F, 0x07, 0x2C, 0xF8, 0x2C,
+    0xF8, 0xAC, 0x01, 0xEE, 0x0F, 0x01, 0xEC, 0x78, 0x48, 0xFA, 0xC8, 0x88, 0xFC, 0x04, 0x0C, 0x08,
+    0xFA, 0x0F, 0x07, 0xFC, 0xE0, 0xF0, 0x98, 0x3B, 0x88, 0x80, 0xFC, 0x07, 0x0F, 0x08, 0xFA, 0x0F,
+    0x07, 0xAC, 0x08, 0xFE, 0xC8, 0xF8, 0x38, 0xC0, 0x0C, 0x0F, 0x0F, 0x03, 0xFC, 0x70, 0xF8, 0x88,
+    0xFA, 0xF8, 0x70, 0xFC, 0x07, 0x0F, 0x08, 0xFA, 0x0F, 0x07, 0xFC, 0x70, 0xF8, 0x88, 0xFA, 0xF8,
+    0xF0, 0xB0, 0x08, 0xFE, 0x0C, 0x07, 0x03, 0xC0, 0x30, 0x02, 0xC0, 0x06, 0x02, 0x00, 0x0B, 0x30,
+    0xC0, 0x10, 0x0F, 0x1E, 0x0E, 0xFC, 0x80, 0xC0, 0x60, 0x3F, 0x30, 0x18, 0x08, 0xF0, 0x01, 0x03,
+    0x3F, 0x06, 0x0C, 0x08, 0xAC, 0x40, 0xAA, 0xAC, 0x02, 0xAA, 0xF0, 0x08, 0x18, 0xFF, 0x30, 0x60,
+    0xC0, 0x80, 0xF0, 0x08, 0x0C, 0x3F, 0x06, 0x03, 0x01, 0xFC, 0x30, 0x38, 0x08, 0xFF, 0x88, 0xC8,
+    0x78, 0x30, 0x00, 0x0B, 0x0D, 0xFC, 0xF0, 0xF8, 0x08, 0xFF, 0xC8, 0x68, 0xC8, 0xF0, 0xFC, 0x07,
+    0x0F, 0x08, 0xFF, 0x0B, 0x0A, 0x0B, 0x01, 0xFC, 0xE0, 0xF0, 0x18, 0xFB, 0x08, 0xF8, 0xF0, 0xEC,
+    0x0F, 0x01, 0xBA, 0x0F, 0xEC, 0xF8, 0x88, 0xFA, 0xF8, 0x70, 0xEC, 0x0F, 0x08, 0xFA, 0x0F, 0x07,
+    0xFC, 0xF0, 0xF8, 0x08, 0xFA, 0x38, 0x30, 0xFC, 0x07, 0x0F, 0x08, 0xFA, 0x0E, 0x06, 0xEC, 0xF8,
+    0x08, 0xFA, 0xF8, 0xF0, 0xEC, 0x0F, 0x08, 0xFE, 0x0C, 0x07, 0x03, 0xEC, 0xF8, 0x88, 0x3A, 0x08,
+    0xEC, 0x0F, 0x08, 0x2A, 0xEC, 0xF8, 0x88, 0x3A, 0x08, 0x2C, 0x0F, 0x00, 0xFC, 0xF0, 0xF8, 0x08,
+    0xFE, 0x88, 0x98, 0x90, 0xFC, 0x07, 0x0F, 0x08, 0xFA, 0x0F, 0x07, 0xEC, 0xF8, 0x80, 0xBA, 0xF8,
+    0x2C, 0x0F, 0xB0, 0x0F, 0xF0, 0x08, 0xF8, 0x0E, 0x08, 0xF0, 0x08, 0x0F, 0x0E, 0x08, 0x00, 0x2C,
+    0xF8, 0xFC, 0x06, 0x0E, 0x08, 0x3E, 0x0F, 0x07, 0xEC, 0xF8, 0x80, 0xFF, 0xC0, 0x60, 0x38, 0x18,
+    0x2C, 0x0F, 0xFF, 0x01, 0x03, 0x0E, 0x0C, 0x2C, 0xF8, 0x00, 0xEC, 0x0F, 0x08, 0x2A, 0xEC, 0xF8,
+    0x70, 0xBF, 0xE0, 0x70, 0xF8, 0x2C, 0x0F, 0xB0, 0x0F, 0xEC, 0xF8, 0x70, 0xBF, 0xE0, 0xC0, 0xF8,
+    0x2C, 0x0F, 0xBC, 0x01, 0x0F, 0xFC, 0xF0, 0xF8, 0x08, 0xFA, 0xF8, 0xF0, 0xFC, 0x07, 0x0F, 0x08,
+    0xFA, 0x0F, 0x07, 0xFC, 0xF0, 0xF8, 0x08, 0xFA, 0xF8, 0xF0, 0xEC, 0x0F, 0x01, 0x2A, 0xFC, 0xF0,
+    0xF8, 0x08, 0xFA, 0xF8, 0xF0, 0xFC, 0x03, 0x07, 0x04, 0xFF, 0x07, 0x0E, 0x1F, 0x13, 0xFC, 0xF0,
+    0xF8, 0x88, 0xFA, 0xF8, 0x70, 0x2C, 0x0F, 0xFC, 0x01, 0x0F, 0x0E, 0xFC, 0x30, 0x78, 0xC8, 0xFB,
+    0x88, 0x18, 0x10, 0xFC, 0x04, 0x0C, 0x08, 0xFE, 0x09, 0x0F, 0x06, 0xEC, 0x08, 0xF8, 0x2E, 0x08,
+    0xC0, 0x0F, 0x02, 0x2C, 0xF8, 0xB0, 0xF8, 0xFC, 0x07, 0x0F, 0x08, 0xFA, 0x0F, 0x07, 0x2C, 0xF8,
+    0xB0, 0xF8, 0xFC, 0x07, 0x0F, 0x0C, 0xFE, 0x06, 0x03, 0x01, 0x2C, 0xF8, 0xB3, 0x80, 0xF8, 0xEC,
+    0x0F, 0x07, 0xBF, 0x03, 0x07, 0x0F, 0xFC, 0x18, 0x38, 0xE0, 0xFF, 0xC0, 0xE0, 0x38, 0x18, 0xFC,
+    0x0C, 0x0E, 0x03, 0xFF, 0x01, 0x03, 0x0E, 0x0C, 0xFC, 0x78, 0xF8, 0x80, 0xFE, 0xC0, 0x78, 0x38,
+    0xC0, 0x0F, 0x02, 0xEC, 0x08, 0x88, 0xFF, 0xC8, 0x68, 0x38, 0x18, 0xFC, 0x0E, 0x0F, 0x09, 0xAB,
+    0x08, 0xB0, 0xF8, 0x0B, 0x08, 0xB0, 0x0F, 0x0B, 0x08, 0xFC, 0x30, 0x60, 0xC0, 0x03, 0x80, 0x00,
+    0xFF, 0x01, 0x03, 0x06, 0x0C, 0xC0, 0x08, 0x2E, 0xF8, 0xC0, 0x08, 0x2E, 0x0F, 0xFC, 0xC0, 0x60,
+    0x30, 0xFF, 0x18, 0x30, 0x60, 0xC0, 0x00, 0x00, 0x00, 0x00, 0xAB, 0x20, 0xAA, 0xC0, 0x0C, 0x0F,
+    0x3C, 0x30, 0x00, 0x00, 0xB0, 0x40, 0xFA, 0xC0, 0x80, 0xFC, 0x0E, 0x0F, 0x09, 0xBE, 0x01, 0x0F,
+    0xEC, 0xF8, 0x40, 0x3E, 0xC0, 0x80, 0xEC, 0x0F, 0x08, 0xFA, 0x0F, 0x07, 0xFC, 0x80, 0xC0, 0x40,
+    0xFA, 0xC0, 0x80, 0xFC, 0x07, 0x0F, 0x08, 0xFA, 0x0C, 0x04, 0xF0, 0x80, 0xC0, 0xBB, 0x40, 0xF8,
+    0xEC, 0x0F, 0x08, 0xB2, 0x0F, 0xFC, 0x80, 0xC0, 0x40, 0xFA, 0xC0, 0x80, 0xFC, 0x07, 0x0F, 0x09,
+    0xFA, 0x0D, 0x05, 0xFC, 0xF0, 0xF8, 0x08, 0x3E, 0x38, 0x30, 0xEC, 0x0F, 0x01, 0x0A, 0xFC, 0x80,
+    0xC0, 0x40, 0xBA, 0xC0, 0xFC, 0x33, 0x37, 0x24, 0xFA, 0x3F, 0x1F, 0xEC, 0xF8, 0x40, 0x3E, 0xC0,
+    0x80, 0x2C, 0x0F, 0xB0, 0x0F, 0xC0, 0xD8, 0x02, 0xC0, 0x0F, 0x02, 0x00, 0x2C, 0xD8, 0xEC, 0x38,
+    0x20, 0x3E, 0x3F, 0x1F, 0x2C, 0xF8, 0x3F, 0x80, 0xC0, 0x40, 0xEC, 0x0F, 0x01, 0xFF, 0x03, 0x06,
+    0x0C, 0x08, 0xC0, 0xF8, 0x02, 0xC0, 0x0F, 0x02, 0xAC, 0xC0, 0xEF, 0x80, 0xC0, 0x80, 0x2C, 0x0F,
+    0xB3, 0x07, 0x0F, 0xEC, 0xC0, 0x40, 0xFA, 0xC0, 0x80, 0x2C, 0x0F, 0xB0, 0x0F, 0xFC, 0x80, 0xC0,
+    0x40, 0xFA, 0xC0, 0x80, 0xFC, 0x07, 0x0F, 0x08, 0xFA, 0x0F, 0x07, 0xFC, 0x80, 0xC0, 0x40, 0xFA,
+    0xC0, 0x80, 0xEC, 0x3F, 0x04, 0xFA, 0x07, 0x03, 0xFC, 0x80, 0xC0, 0x40, 0xBA, 0xC0, 0xFC, 0x03,
+    0x07, 0x04, 0xBA, 0x3F, 0xEC, 0xC0, 0x80, 0xAF, 0xC0, 0x40, 0x2C, 0x0F, 0x00, 0xFC, 0x80, 0xC0,
+    0x40, 0x2A, 0xBC, 0x08, 0x09, 0xFA, 0x0F, 0x06, 0xFC, 0x40, 0xF0, 0xF8, 0x2B, 0x40, 0xF0, 0x07,
+    0x0F, 0x2B, 0x08, 0x2C, 0xC0, 0xB0, 0xC0, 0xFC, 0x07, 0x0F, 0x08, 0xBA, 0x0F, 0x2C, 0xC0, 0xB0,
+    0xC0, 0xFC, 0x03, 0x07, 0x0C, 0xFE, 0x06, 0x03, 0x01, 0x2C, 0xC0, 0xB0, 0xC0, 0xEC, 0x0F, 0x04,
+    0xFF, 0x07, 0x0C, 0x0F, 0x07, 0xFC, 0x40, 0xC0, 0x80, 0xFC, 0x80, 0xC0, 0x40, 0xFC, 0x08, 0x0C,
+    0x07, 0xFF, 0x03, 0x07, 0x0C, 0x08, 0x2C, 0xC0, 0xB0, 0xC0, 0xFC, 0x03, 0x27, 0x24, 0xFE, 0x34,
+    0x1F, 0x0F, 0xAC, 0x40, 0xEE, 0xC0, 0x40, 0xFC, 0x08, 0x0C, 0x0E, 0xBF, 0x0B, 0x09, 0x08, 0xEC,
+    0x80, 0xF0, 0x2F, 0x78, 0x08, 0xC0, 0x07, 0x2F, 0x0F, 0x08, 0xC0, 0x78, 0x02, 0xC0, 0x0F, 0x02,
+    0xB0, 0x08, 0xBF, 0x78, 0xF0, 0x80, 0xB0, 0x08, 0x0F, 0x0F, 0x07, 0xFF, 0x30, 0x18, 0x08, 0x18,
+    0xFF, 0x30, 0x20, 0x30, 0x18, 0x00, 0x00, 0xF0, 0x80, 0xC0, 0x3F, 0x60, 0xC0, 0x80, 0xEC, 0x07,
+    0x04, 0xBA, 0x07,
+};
+
+const t_OLEDPacked font8x16Packed = {8, 2, 4, font8x16Base, font8x16Offs, font8x16Data};
+
+//logo.h: 1 glyph of 128x64, 1024 bytes packed to 548
+static const UINT16 logoBase[1] = {
+    0x0000,
+};
+
+static const UINT8 logoOffs[1] = {
+    0x00,
+};
+
+static const UINT8 logoData[545] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x80, 0xF0, 0x02, 0x01, 0x00, 0xF0,
+    0x08, 0x14, 0x3F, 0x0C, 0x02, 0x01, 0x00, 0xF0, 0x80, 0x40, 0xFF, 0x20, 0x10, 0x08, 0x04, 0xAA,
+    0xAA, 0xEA, 0x84, 0xEB, 0x04, 0x0A, 0x03, 0x04, 0xB0, 0x80, 0xFF, 0x40, 0x20, 0x10, 0x08, 0x3F,
+    0x06, 0x05, 0x02, 0xC0, 0x80, 0xFF, 0x40, 0x20, 0x10, 0x08, 0x3F, 0x04, 0x02, 0x01, 0xFC, 0x80,
+    0x40, 0x10, 0x00, 0x03, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x20, 0xB0,
+    0x20, 0xF0, 0x01, 0x02, 0xAB, 0x01, 0xAB, 0x11, 0xAA, 0xAF, 0x91, 0x11, 0xAA, 0xBA, 0x10, 0xEA,
+    0x08, 0xBF, 0x04, 0x02, 0x01, 0xAA, 0xEA, 0x02, 0x3F, 0xC1, 0xA0, 0x40, 0x00, 0xFC, 0x01, 0x02,
+    0x01, 0x00, 0xFF, 0xC0, 0x20, 0x10, 0x08, 0x3F, 0x04, 0x02, 0x01, 0xFF, 0x80, 0x40, 0xC0, 0x20,
+    0xFF, 0x10, 0x08, 0x04, 0x02, 0x03, 0x01, 0xC0, 0x10, 0x0C, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0x14, 0x30, 0x08, 0xCC, 0x08, 0x08, 0x3E, 0x14, 0x08, 0x00, 0xFC, 0x18, 0x14,
+    0x08, 0xC0, 0x01, 0x0F, 0x3E, 0x01, 0xFC, 0x08, 0x14, 0x08, 0xAA, 0xAA, 0x3E, 0x14, 0x08, 0xF0,
+    0x20, 0x10, 0xFF, 0x08, 0x04, 0x02, 0x01, 0x00, 0xFC, 0x20, 0x10, 0x08, 0x3F, 0x06, 0x05, 0x02,
+    0x00, 0x03, 0x1F, 0x00, 0x0C, 0x01, 0xC0, 0x40, 0x30, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xAC, 0xFE, 0x02, 0xC0, 0xFE, 0x2A, 0xF0, 0xC0, 0xC2, 0xFB, 0xC0, 0x82, 0xC0, 0xEB, 0xC2, 0xC0,
+    0x03, 0x80, 0xEF, 0xCE, 0xCF, 0xCE, 0xF0, 0xF0, 0xF8, 0xFF, 0xFC, 0xFE, 0xDE, 0x8E, 0xEB, 0x0E,
+    0x1E, 0x03, 0x1C, 0xBC, 0x80, 0xC0, 0xAA, 0x3E, 0x84, 0x02, 0x50, 0x0D, 0xFE, 0xBC, 0x80, 0xC0,
+    0xAA, 0x57, 0xFE, 0x00, 0xAF, 0x80, 0xC0, 0xEA, 0x84, 0x0F, 0x02, 0x01, 0xEB, 0xC0, 0x80, 0x2B,
+    0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5C, 0x3F, 0xFD, 0xE0, 0xC0, 0x80, 0x7E, 0xC0, 0xE0, 0x35,
+    0x1F, 0x50, 0xB5, 0x01, 0x56, 0x01, 0x55, 0xF0, 0xC0, 0xC1, 0xAF, 0xC3, 0x87, 0xB7, 0x8F, 0xFE,
+    0xC3, 0xFC, 0x7E, 0xD5, 0xC1, 0xEB, 0x81, 0xC3, 0xD5, 0x3C, 0x50, 0x05, 0x57, 0x7E, 0xEF, 0xC1,
+    0x81, 0xC1, 0x55, 0x70, 0x3C, 0xF5, 0xD9, 0x98, 0xBE, 0x99, 0x9F, 0x0E, 0x1C, 0xD5, 0x07, 0x2B,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x40, 0x01, 0xAE, 0x03, 0xEA, 0x01, 0x02, 0xB0, 0x03,
+    0xCE, 0x01, 0x80, 0xBF, 0x40, 0x81, 0x83, 0xAE, 0x80, 0xFF, 0x83, 0x43, 0x23, 0x03, 0xF0, 0x01,
+    0x03, 0xFF, 0x83, 0x43, 0x23, 0x03, 0xBA, 0x01, 0xBF, 0x40, 0xA0, 0x40, 0xFE, 0x41, 0xA3, 0x43,
+    0xAB, 0x03, 0xFB, 0x01, 0x80, 0x40, 0xB3, 0x20, 0x03, 0x0A, 0xEC, 0x01, 0x03, 0xEA, 0x01, 0xAB,
+    0x03, 0x00, 0xBF, 0x81, 0x01, 0x03, 0xAA, 0x03, 0x01, 0x2B, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x30, 0x80, 0x00, 0x00, 0x03, 0xA0, 0x0F, 0x40, 0x80, 0x00, 0xAF, 0xA0, 0x40, 0xAF, 0x41, 0x40,
+    0xAA, 0xFA, 0x20, 0x10, 0xFF, 0x08, 0x04, 0x02, 0x01, 0xC0, 0x80, 0x3F, 0x60, 0x50, 0x20, 0x00,
+    0x0C, 0x80, 0xC0, 0x02, 0x0F, 0x05, 0x03, 0x00, 0x00, 0xFC, 0x02, 0xFD, 0x02, 0x00, 0xF0, 0x40,
+    0x20, 0x3C, 0x08, 0x04, 0x0B, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x80,
+    0x40, 0x20, 0x10, 0x0F, 0x08, 0x0A, 0x00, 0x00, 0xF0, 0x01, 0x02, 0xBF, 0x04, 0x08, 0x10, 0x00,
+    0xC0, 0x80, 0xAB, 0x40, 0xAA, 0xFE, 0x20, 0x10, 0x08, 0x3F, 0x04, 0x02, 0x01, 0xEC, 0x80, 0x40,
+    0xFF, 0x20, 0x10, 0x08, 0x04, 0x3F, 0x03, 0x02, 0x01, 0xC0, 0x80, 0xFF, 0x40, 0x20, 0x10, 0x0A,
+    0x0F, 0x05, 0x02, 0x00, 0x10, 0xC0, 0x02, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00,
+};
+
+const t_OLEDPacked logoPacked = {128, 8, 7, logoBase, logoOffs, logoData};
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* FONTSPACKED_H */
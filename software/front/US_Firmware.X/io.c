@@ -9,9 +9,11 @@
 #include "PID.h"
 #include "isr.h"
 #include "iron.h"
+#ifndef HOST_BUILD
 #include "usb/usb.h"
 #include "usb/usb_driver.h"
 #include "usb/usb_function_hid.h"
+#endif
 
 //#define TXP (*((USBPacket *)USBTxBuffer))
 //#define RXP (*((USBPacket *)USBRxBuffer))
@@ -22,13 +24,28 @@
 static unsigned int IO_TICKS;
 static unsigned int IO_BUSY;
 
-static unsigned int BuffPos;
+//Live record stream: the PIDHist records from IORecSeq on are sent IO_RECS to a report. A report with fewer records
+//goes when its first record is IO_RECS_WAIT ISR ticks old
+#define IO_RECS_WAIT 4
+static UINT32 IORecSeq;
+
+//Capture stream: a complete capture is sent from word IOCapPos on, the state goes back to CAP_OFF after the last word
+#define IO_CAP_STATUS 0x10
+#define IO_CAP_RESEND 0x11
+static UINT32 IOCapPos;
+
+static const UINT8 TlmDesc[TLM_FIELDS] = TLM_DESC;
+static UINT32 TlmMask;              //fields of the telemetry frames, 0 for the LiveData reports
+static UINT16 TlmSeq;
 
 void ProcessIO();
 
 void IOInit(){
     IO_TICKS = ISRTicks;
     IO_BUSY = 1;
+    IORecSeq = PIDHistCnt;
+    TlmMask = 0;
+    IOCapPos = 0;
     USBDriverInit();
     RXP.Command = 0;
 }
@@ -39,6 +56,116 @@ void IOTasks(){
     ProcessIO();   // This is where all the actual bootloader related data transfer/self programming takes place
 }
 
+//Send the next live record report if it is due, returns 1 if it was sent. The IN endpoint must be free
+static int IOSendRecs(){
+    t_PIDHist R[IO_RECS];
+    UINT32 seq = IORecSeq;
+    int i, n = PIDHistRead(&seq, R, IO_RECS);
+    IORecSeq = seq;
+    if(!n || ((n < IO_RECS) && ((UINT16)(ISRTicks - R[0].Ticks) < IO_RECS_WAIT))) return 0;
+    for(i = 0; i < n; i++) TXP.LiveRecs.Rec[i] = R[i];     //TXP is packed, Rec may not be aligned
+    TXP.Command = 8;
+    TXP.LiveRecs.Seq = seq;
+    TXP.LiveRecs.Count = n;
+    USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
+    IORecSeq = seq + n;
+    return 1;
+}
+
+//Fields of mask m which fit in a frame with two channels, in the order of their bits
+static UINT32 TlmFit(UINT32 m){
+    int f, n = 0;
+    UINT32 a = 0;
+    for(f = 0; f < TLM_FIELDS; f++){
+        if(!(m & (1UL << f))) continue;
+        n += TLM_SIZE(TlmDesc[f]) * TLM_COUNT(TlmDesc[f]) * ((TlmDesc[f] & TLM_PERCH) ? 2 : 1);
+        if(n > TLM_PAYLOAD) break;
+        a |= 1UL << f;
+    }
+    return a;
+}
+
+//Element k of field f of channel ch
+static INT32 TlmValue(int f, int ch, int k){
+    volatile t_PIDVars * PV = &PIDVars[ch];
+    int i, AVG = PIDAVG();
+    UINT32 t;
+    switch(f){
+        case TLM_CTTEMP: return CTTemp;
+        case TLM_HEATER: return PHEATER;
+        case TLM_CJTEMP: return CJTemp;
+        case TLM_ISRTIME:
+            for(i = 0, t = 0; i < ISR_STEPS; i++) t += ISRProf[i].Last;
+            return min(t, 0xFFFF);
+        case TLM_PIDTIME: return min(ISRProf[ISR_PROF_PID].Last, 0xFFFF);
+        case TLM_CTEMP: return PV->CTemp[0];
+        case TLM_ADCTEMP: return PV->ADCTemp[0];
+        case TLM_TAVGF: return PV->TAvgF[0] >> AVG;
+        case TLM_TAVGP: return PV->TAvgP[0];
+        case TLM_DUTY: return PV->PIDDuty >> 8;
+        case TLM_HR: return PV->HRAvg >> AVG;
+        case TLM_HP: return PV->HPAvg >> AVG;
+        case TLM_HI: return PV->HIAvg >> AVG;
+        case TLM_HV: return PV->HVAvg >> AVG;
+        case TLM_OFFDELAY: return PV->OffDelay;
+        case TLM_POWER: return PV->Power;
+        case TLM_DEST: return PV->DestinationReached;
+        case TLM_WSDELTA: return PV->WSDelta[k].val;
+    }
+    return 0;
+}
+
+//Telemetry frame of the TlmMask fields into TXP
+static void TlmFrame(){
+    int f, ch, chs, k, b;
+    UINT8 * p = (UINT8 *)TXP.Tlm.Data;
+    INT32 v;
+    chs = IronPars.Config[1].SensorConfig.Type ? 2 : 1;
+    TXP.Command = 10;
+    TXP.Tlm.Version = TLM_VERSION;
+    TXP.Tlm.Chs = chs;
+    TXP.Tlm.Seq = TlmSeq++;
+    TXP.Tlm.Ticks = ISRTicks;
+    TXP.Tlm.Mask = TlmMask;
+    for(f = 0; f < TLM_FIELDS; f++){
+        if(!(TlmMask & (1UL << f))) continue;
+        for(ch = 0; ch < ((TlmDesc[f] & TLM_PERCH) ? chs : 1); ch++){
+            for(k = 0; k < TLM_COUNT(TlmDesc[f]); k++){
+                v = TlmValue(f, ch, k);
+                for(b = 0; b < TLM_SIZE(TlmDesc[f]); b++, v >>= 8) *p++ = v;    //little endian
+            }
+        }
+    }
+}
+
+#ifdef HOST_BUILD
+//Telemetry frame of the fields of m which fit into TXP, for the simulator checks, returns the fields accepted
+UINT32 IOTlmFrame(UINT32 m){
+    TlmMask = TlmFit(m);
+    TlmFrame();
+    return TlmMask;
+}
+#endif
+
+//Send the next capture report if a capture is complete, returns 1 if it was sent. The IN endpoint must be free
+static int IOSendCap(){
+    int i, n;
+    if(CapState != CAP_DONE) return 0;
+    if(IOCapPos >= VICap.Len){
+        CapState = CAP_OFF;
+        return 0;
+    }
+    n = min(VICap.Len - IOCapPos, IO_CAP_WORDS);
+    TXP.Command = 12;
+    TXP.Cap.Offset = IOCapPos;
+    TXP.Cap.Len = VICap.Len;
+    TXP.Cap.Count = n;
+    for(i = 0; i < n; i++) TXP.Cap.Data[i] = VICap.Buf[IOCapPos + i];
+    USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
+    IOCapPos += n;
+    return 1;
+}
+
 void ProcessIO(){
     static UINT16 _IronID=0; 
 
@@ -49,13 +176,13 @@ void ProcessIO(){
             TXP.Data16[0] = IronID;
             USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
         }
-        else if(IO_TICKS != ADCStep && !HIDTxHandleBusy(USBInHandle)){
+        else if(!IOSendCap() && !IOSendRecs() && IO_TICKS != ADCStep && !HIDTxHandleBusy(USBInHandle)){
             IO_TICKS = ADCStep;
-            if(IO_TICKS & 1){
-                BuffPos++;
-                if(BuffPos>127){
-                    BuffPos &= 127;
-                }
+            if((IO_TICKS & 1) && TlmMask){
+                TlmFrame();
+                USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
+            }
+            else if(IO_TICKS & 1){
                 TXP.Command=3;
                 TXP.LiveData.Ticks=IO_TICKS;
                 TXP.LiveData.CTTemp=CTTemp;                                 //
@@ -105,12 +232,14 @@ void ProcessIO(){
                         IO_BUSY=0;
                     }
                     break;
-                case 3: //Set current iron PID parameters
+                case 3: //Set current iron PID parameters, the feed-forward (FF_Loss, FF_Mass) is kept, it is only set by the auto-tune
                     IronPars.Config[0].SensorConfig.Gain = RXP.IronPars.Gain;
                     IronPars.Config[0].PID_KP = RXP.IronPars.PID_KP;
                     IronPars.Config[0].PID_KI = RXP.IronPars.PID_KI;
                     IronPars.Config[0].PID_DGain = RXP.IronPars.PID_DGain;
                     IronPars.Config[0].PID_OVSGain = RXP.IronPars.PID_OVSGain;
+                    IronLUTUpdate();
+                    IronOvrSave(IRON_OVR_GAIN | IRON_OVR_PID, 0);
                     IO_BUSY = 0;
                     break;
                 case 4: //Get current iron PID parameters
@@ -123,6 +252,89 @@ void ProcessIO(){
                         TXP.IronPars.PID_KI = IronPars.Config[0].PID_KI;
                         TXP.IronPars.PID_DGain = IronPars.Config[0].PID_DGain;
                         TXP.IronPars.PID_OVSGain = IronPars.Config[0].PID_OVSGain;
+                        TXP.IronPars.FF_Loss = IronPars.Config[0].FF_Loss;
+                        TXP.IronPars.FF_Mass = IronPars.Config[0].FF_Mass;
+                        USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
+                        IO_BUSY = 0;
+                    }
+                    break;
+                case 5: //Get ISR step profile, Data[0] = first step, Data[1] = reset profile after reading
+                    if(!HIDTxHandleBusy(USBInHandle)){
+                        int i, n = RXP.Data[0];
+                        if(n > ISR_PROF_N) n = ISR_PROF_N;
+                        TXP.Command = 5;
+                        TXP.ISRProf.First = n;
+                        TXP.ISRProf.Steps = ISR_PROF_N;
+                        TXP.ISRProf.ACPower = mainFlags.ACPower;
+                        TXP.ISRProf.MainsPer = MAINS_PER_US;
+                        for(i = 0; i < 5 && n < ISR_PROF_N; i++, n++){
+                            volatile ISRProfS * P = &ISRProf[n];
+                            UINT32 cnt = P->Cnt;
+                            UINT32 avg = cnt ? P->Sum / cnt : 0;
+                            TXP.ISRProf.Step[i].Min = cnt ? min(P->Min, 0xFFFF) : 0;
+                            TXP.ISRProf.Step[i].Avg = min(avg, 0xFFFF);
+                            TXP.ISRProf.Step[i].Max = min(P->Max, 0xFFFF);
+                            TXP.ISRProf.Step[i].Budget = min(P->Budget, 0xFFFF);
+                            TXP.ISRProf.Step[i].Over = min(P->Over, 0xFFFF);
+                        }
+                        TXP.ISRProf.Count = i;
+                        if(RXP.Data[1]) ISRProfReset = 1;
+                        USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
+                        IO_BUSY = 0;
+                    }
+                    break;
+                case 6: //Clear the stored parameters of the current iron
+                    IronOvrClear();
+                    IronID = 0x1919;    //identify it again with the Irons[] parameters
+                    IO_BUSY = 0;
+                    break;
+                case 7: //Get I2C bus utilisation, the counters are free running: the utilisation is the difference of two reads
+                    if(!HIDTxHandleBusy(USBInHandle)){
+                        TXP.Command = 7;
+                        TXP.I2CStats.Time = mcuReadCoreTimer();
+                        TXP.I2CStats.BusyTicks = I2CStats.BusyTicks;
+                        TXP.I2CStats.Bytes = I2CStats.Bytes;
+                        TXP.I2CStats.Starts = I2CStats.Starts;
+                        TXP.I2CStats.Polls = I2CStats.Polls;
+                        TXP.I2CStats.Cmds = I2CStats.Cmds;
+                        TXP.I2CStats.Skipped = I2CStats.Skipped;
+                        TXP.I2CStats.Late = I2CStats.Late;
+                        USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
+                        IO_BUSY = 0;
+                    }
+                    break;
+                case 9: //Set the telemetry fields, returns the fields accepted and the descriptors of all the fields
+                    if(!HIDTxHandleBusy(USBInHandle)){
+                        int f;
+                        TlmMask = TlmFit(RXP.TlmSet.Mask);
+                        TlmSeq = 0;
+                        TXP.Command = 9;
+                        TXP.TlmInfo.Version = TLM_VERSION;
+                        TXP.TlmInfo.Fields = TLM_FIELDS;
+                        TXP.TlmInfo.Mask = TlmMask;
+                        TXP.TlmInfo.Payload = TLM_PAYLOAD;
+                        for(f = 0; f < TLM_FIELDS; f++) TXP.TlmInfo.Desc[f] = TlmDesc[f];
+                        USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
+                        IO_BUSY = 0;
+                    }
+                    break;
+                case 11: //Raw capture: start one, get the status or send a complete one again from a word. Returns the status
+                    if(!HIDTxHandleBusy(USBInHandle)){
+                        if(RXP.CapSet.Op == IO_CAP_RESEND){
+                            if(VICap.Len && CapState != CAP_ARMED && CapState != CAP_RUN){
+                                IOCapPos = RXP.CapSet.Offset;
+                                CapState = CAP_DONE;
+                            }
+                        }
+                        else if(RXP.CapSet.Op != IO_CAP_STATUS){
+                            IOCapPos = 0;
+                            CapArm(RXP.CapSet.Op, RXP.CapSet.Halves);
+                        }
+                        TXP.Command = 11;
+                        TXP.CapStatus.State = CapState;
+                        TXP.CapStatus.Len = VICap.Len;
+                        TXP.CapStatus.Size = CAP_WORDS;
+                        TXP.CapStatus.Lost = min(VICap.Lost, 0xFFFF);
                         USBInHandle = HIDTxPacket(HID_EP, (BYTE *)&TXP, 64);
                         IO_BUSY = 0;
                     }
@@ -14,6 +14,48 @@ extern "C" {
 
 #include <xc.h>
 #include "iron.h"
+#include "PID.h"
+
+#define IO_RECS 4       //PIDHist records in a live record report
+#define IO_CAP_WORDS 14 //VICap words in a capture report
+
+//Telemetry frames (report 10) carry the fields of the mask set by command 9 instead of the LiveData reports.
+//The fields follow the header in the order of their bits, the per channel ones for each channel of the instrument.
+//TLM_DESC is the descriptor of each field, command 9 returns them with the accepted mask
+#define TLM_VERSION 1
+#define TLM_PAYLOAD 52  //bytes of fields in a frame, the accepted mask fits with two channels
+#define TLM_SIZE(d) ((d) & 7)               //bytes of an element
+#define TLM_COUNT(d) ((((d) >> 3) & 7) + 1) //elements
+#define TLM_SIGNED 0x40
+#define TLM_PERCH 0x80                      //one for each channel
+
+enum TLM_FIELDS{
+    TLM_CTTEMP,         //set temperature (degrees / 2)
+    TLM_HEATER,         //PHEATER
+    TLM_CJTEMP,         //cold junction temperature (degrees * 2)
+    TLM_ISRTIME,        //run time of the ISR steps of the last half period (core timer ticks)
+    TLM_PIDTIME,        //run time of the last deferred PID task (core timer ticks)
+    TLM_CTEMP,          //per channel: temperature (degrees * 2)
+    TLM_ADCTEMP,
+    TLM_TAVGF,
+    TLM_TAVGP,
+    TLM_DUTY,           //PIDDuty >> 8
+    TLM_HR,             //averaged heater resistance /10
+    TLM_HP,             //averaged heater power
+    TLM_HI,             //averaged heater current x42.55
+    TLM_HV,             //averaged heater voltage x12.19
+    TLM_OFFDELAY,       //comparator threshold to zero cross (us)
+    TLM_POWER,          //0 = full power, 1 = 1/2, 2 = 1/4, 3 = 1/8
+    TLM_DEST,           //DestinationReached
+    TLM_WSDELTA,        //8 WSDelta values
+    TLM_FIELDS
+};
+
+#define TLM_DESC { \
+    1, 1, 2 | TLM_SIGNED, 2, 2, \
+    2 | TLM_SIGNED | TLM_PERCH, 2 | TLM_PERCH, 2 | TLM_PERCH, 2 | TLM_PERCH, 2 | TLM_PERCH, 2 | TLM_SIGNED | TLM_PERCH, \
+    2 | TLM_PERCH, 2 | TLM_PERCH, 2 | TLM_PERCH, 2 | TLM_PERCH, 1 | TLM_PERCH, 1 | TLM_PERCH, \
+    2 | (7 << 3) | TLM_SIGNED | TLM_PERCH}
 
 #ifndef _IO_C
 #define IOC_EXTERN extern
@@ -40,6 +82,8 @@ typedef union {
                 UINT16 PID_KI;
                 UINT16 PID_DGain;
                 UINT16 PID_OVSGain;
+                UINT16 FF_Loss;         //feed-forward, reported by command 4, ignored by command 3
+                UINT16 FF_Mass;
             }IronPars;
             struct __PACKED {
                 UINT16 Ticks;
@@ -54,6 +98,70 @@ typedef union {
                 UINT8 DestinationReached;
                 UINT16 Duty;
             }LiveData;
+            struct __PACKED {
+                UINT8 First;            //first ISR step in the packet
+                UINT8 Count;            //number of steps in the packet
+                UINT8 Steps;            //number of profile entries: the ISR steps, then the deferred PID task runs of step 5 and of the dual scan
+                UINT8 ACPower;
+                UINT16 MainsPer;        //mains half period (us)
+                struct __PACKED {
+                    UINT16 Min;         //step run time (core timer ticks, 25ns)
+                    UINT16 Avg;
+                    UINT16 Max;
+                    UINT16 Budget;      //timer period to the next step (us), 0 if started by ADC or comparator
+                    UINT16 Over;        //number of runs longer than Budget
+                }Step[5];
+            }ISRProf;
+            struct __PACKED {
+                UINT32 Mask;            //fields requested, 0 for the LiveData reports
+            }TlmSet;
+            struct __PACKED {
+                UINT8 Version;          //TLM_VERSION
+                UINT8 Fields;           //TLM_FIELDS
+                UINT32 Mask;            //fields accepted
+                UINT8 Payload;          //TLM_PAYLOAD
+                UINT8 Desc[TLM_FIELDS]; //TLM_DESC
+            }TlmInfo;
+            struct __PACKED {
+                UINT8 Version;
+                UINT8 Chs;              //channels of the per channel fields
+                UINT16 Seq;             //frame number, a gap means lost frames
+                UINT16 Ticks;           //ISRTicks
+                UINT32 Mask;
+                UINT8 Data[TLM_PAYLOAD];
+            }Tlm;
+            struct __PACKED {
+                UINT8 Op;               //CAP_TRIGGERS to start a capture, IO_CAP_STATUS or IO_CAP_RESEND
+                UINT8 Halves;           //half periods to capture, 0 = as many as fit
+                UINT16 Offset;          //IO_CAP_RESEND: word to send again from
+            }CapSet;
+            struct __PACKED {
+                UINT8 State;            //CAP_STATES
+                UINT16 Len;             //words captured
+                UINT16 Size;            //CAP_WORDS
+                UINT16 Lost;            //sample pairs which did not fit
+            }CapStatus;
+            struct __PACKED {
+                UINT16 Offset;          //word of Data[0] in VICap
+                UINT16 Len;             //words of the capture
+                UINT8 Count;
+                UINT32 Data[IO_CAP_WORDS];
+            }Cap;
+            struct __PACKED {
+                UINT32 Seq;             //PIDHistCnt of Rec[0], the next report goes on from Seq + Count unless records were lost
+                UINT8 Count;
+                t_PIDHist Rec[IO_RECS];
+            }LiveRecs;
+            struct __PACKED {
+                UINT32 Time;            //core timer (25ns ticks) when the counters were read
+                UINT32 BusyTicks;       //core timer ticks with a command on the bus
+                UINT32 Bytes;           //bytes sent or received, with the device addresses
+                UINT32 Starts;          //start and repeated start conditions
+                UINT32 Polls;           //EEPROM addressings not acknowledged during its write cycle
+                UINT32 Cmds;            //commands run
+                UINT32 Skipped;         //pot and DAC writes skipped, the device has the values
+                UINT32 Late;            //pot and DAC writes complete after their deadline
+            }I2CStats;
         };
     };
 }USBPacket;
@@ -65,6 +173,9 @@ IOC_EXTERN volatile USBPacket RXP;
 IOC_EXTERN volatile USBPacket TXP;
 
 IOC_EXTERN void IOInit();
+#ifdef HOST_BUILD
+IOC_EXTERN UINT32 IOTlmFrame(UINT32 m);
+#endif
 IOC_EXTERN void IOTasks();
 
 IOC_EXTERN int BuffEmpty;
@@ -1,9 +1,12 @@
 #define _IRON_C
+#include <string.h>
 #include "iron.h"
 #include "isr.h"
 #include "mcu.h"
 #include "PID.h"
 #include "main.h"
+#include "sensorMath.h"
+#include "EEP.h"
 //ID       1    2    3    4    5    6    7    8    9   10   11   12   13   14   15   16   17   18   19   20   21   22   23   24   25
 //ID(HEX) 01   02   03   04   05   06   07   08   09   0A   0B   0C   0D   0E   0F   10   11   12   13   14   15   16   17   18   19
 //R      100  110  120  130  150  180  200  220  240  270  300  330  390  430  470  560  680  820   1K  1.2K 1.5k  2k   3k  5.6k inf.
@@ -888,8 +891,215 @@ const t_IronPars Irons[] = {
 	}
 };
 
+#ifdef HOST_BUILD
+const int IronsNum = sizeof(Irons) / sizeof(Irons[0]);    //instrument table size for the simulator
+#endif
+
 volatile int IronTicks;
 
+//Both sensors of a dual instrument can be read in the same window if they are on different inputs and one front end
+//setup serves both: the same gain and offset, and each current source used by at most one of them (or the same way by both)
+static int IronScanSetup(t_SensorConfig * S) {
+	t_SensorConfig * A = (t_SensorConfig *)&IronPars.Config[0].SensorConfig;
+	t_SensorConfig * B = (t_SensorConfig *)&IronPars.Config[1].SensorConfig;
+	if (A->Type == SENSOR_UNDEFINED || A->Type == SENSOR_NONE || B->Type == SENSOR_UNDEFINED || B->Type == SENSOR_NONE) return 0;
+	if (A->InputP == B->InputP && A->InputN == B->InputN) return 0;
+	if (A->Gain != B->Gain || A->Offset != B->Offset) return 0;
+	if (A->CurrentA && B->CurrentA && (A->CurrentA != B->CurrentA || A->CBandA != B->CBandA)) return 0;
+	if (A->CurrentB && B->CurrentB && (A->CurrentB != B->CurrentB || A->CBandB != B->CBandB)) return 0;
+	*S = *A;
+	if (!A->CurrentA) {
+		S->CurrentA = B->CurrentA;
+		S->CBandA = B->CBandA;
+	}
+	if (!A->CurrentB) {
+		S->CurrentB = B->CurrentB;
+		S->CBandB = B->CBandB;
+	}
+	return 1;
+}
+
+void IronLUTUpdate() {
+	t_SensorLUT LUT;
+	t_SensorConfig S;
+	int i, d, scan;
+	for (i = 0; i < 3; i++) {
+		SensorLUTBuild(&LUT, (i == SENSOR_LUT_CJ) ? (t_SensorConfig *)IronPars.ColdJunctionSensorConfig : (t_SensorConfig *)&IronPars.Config[i].SensorConfig);
+		d = mcuDisableInterrupts();
+		SensorLUT[i] = LUT;
+		mcuRestoreInterrupts(d);
+	}
+	scan = IronScanSetup(&S);
+	d = mcuDisableInterrupts();
+	if (scan) IronScanConfig = S;
+	if (scan != IronDualScan) {
+		IronDualScan = scan;
+		for (i = 2; i--; ) {	//PID averaging depth changes with the PID rate, restart the filters
+			PIDVars[i].Starting = 1;
+			PIDVars[i].HInitData = 1;
+		}
+	}
+	mcuRestoreInterrupts(d);
+}
+
+//Instruments of the override store slots, read at power-up, 0xFFFF = free slot. The record of the current instrument is read
+//into IronOvrRec when it is identified and applied by IronTasks
+static UINT16 IronOvrID[IRON_OVR_SLOTS];
+static UINT8 IronOvrAge[IRON_OVR_SLOTS];	//number of records saved later, the record with the highest age is replaced first
+static UINT16 IronOvrSeq;					//Seq of the last record saved
+static t_IronOvr IronOvrRec;
+static t_EEPReq IronOvrReq;
+static UINT8 IronOvrLoading;
+
+static UINT8 IronOvrSum(t_IronOvr * O) {
+	UINT8 * b = (UINT8 *)O;
+	UINT8 s = 0;
+	int i;
+	for (i = sizeof(t_IronOvr) - 1; i--; ) s += b[i];
+	return -s;
+}
+
+static int IronOvrValid(t_IronOvr * O) {
+	return O->Version == IRON_OVR_VERSION && O->Sum == IronOvrSum(O);
+}
+
+void IronOvrInit() {
+	UINT16 seq[IRON_OVR_SLOTS];
+	int i, j;
+	IronOvrSeq = 0;
+	for (i = 0; i < IRON_OVR_SLOTS; i++) {
+		EEPRead(IRON_OVR_EEP + i * 32, (UINT8 *)&IronOvrRec, sizeof(t_IronOvr));
+		IronOvrID[i] = IronOvrValid(&IronOvrRec) ? IronOvrRec.ID : 0xFFFF;
+		seq[i] = IronOvrRec.Seq;
+		if (IronOvrID[i] != 0xFFFF && (INT16)(seq[i] - IronOvrSeq) > 0) IronOvrSeq = seq[i];
+	}
+	for (i = 0; i < IRON_OVR_SLOTS; i++) {
+		IronOvrAge[i] = 0;
+		for (j = 0; j < IRON_OVR_SLOTS; j++) {
+			if (IronOvrID[j] != 0xFFFF && (INT16)(seq[j] - seq[i]) > 0) IronOvrAge[i]++;
+		}
+	}
+	IronOvrRec.ID = 0xFFFF;
+	IronOvrLoading = 0;
+}
+
+//Slot of the record of instrument ID, or -1 - (first free slot, or the slot saved least recently if all are taken) if there is none
+static int IronOvrFind(UINT16 ID) {
+	int i, f = -1, o = 0;
+	for (i = 0; i < IRON_OVR_SLOTS; i++) {
+		if (IronOvrID[i] == ID) return i;
+		if (IronOvrID[i] == 0xFFFF && f < 0) f = i;
+		if (IronOvrAge[i] > IronOvrAge[o]) o = i;
+	}
+	return -1 - ((f < 0) ? o : f);
+}
+
+//Queue the transfer of the first c bytes of IronOvrRec to or from slot
+static void IronOvrXfer(int slot, int c, int write) {
+	IronOvrReq.Addr = IRON_OVR_EEP + slot * 32;
+	IronOvrReq.Data = (UINT8 *)&IronOvrRec;
+	IronOvrReq.Cnt = c;
+	IronOvrReq.Write = write;
+	EEPSubmit(&IronOvrReq);
+}
+
+//Queue the read of the record of the just identified instrument
+static void IronOvrLoad() {
+	int slot;
+	EEPWait(&IronOvrReq);	//IronOvrRec is the data of the previous transfer
+	IronOvrRec.ID = 0xFFFF;
+	IronOvrLoading = 0;
+	if ((slot = IronOvrFind(IronID)) < 0) return;
+	IronOvrXfer(slot, sizeof(t_IronOvr), 0);
+	IronOvrLoading = 1;
+}
+
+//Overrides of the loaded record over the Irons[] parameters, once its read is complete
+static void IronOvrApply() {
+	int i;
+	if (!IronOvrLoading || IronOvrReq.Busy) return;
+	IronOvrLoading = 0;
+	if (IronOvrRec.ID != IronID || !IronOvrValid(&IronOvrRec)) {
+		IronOvrRec.ID = 0xFFFF;
+		return;
+	}
+	for (i = 2; i--; ) {
+		t_IronConfig * IC = (t_IronConfig *)&IronPars.Config[i];
+		t_IronOvrCh * C = &IronOvrRec.Ch[i];
+		if (C->Mask & IRON_OVR_GAIN) IC->SensorConfig.Gain = C->Gain;
+		if (C->Mask & IRON_OVR_KP) IC->PID_KP = C->PID_KP;
+		if (C->Mask & IRON_OVR_KI) IC->PID_KI = C->PID_KI;
+		if (C->Mask & IRON_OVR_DGAIN) IC->PID_DGain = C->PID_DGain;
+		if (C->Mask & IRON_OVR_OVSGAIN) IC->PID_OVSGain = C->PID_OVSGain;
+		if (C->Mask & IRON_OVR_FF) {
+			IC->FF_Loss = C->FF_Loss;
+			IC->FF_Mass = C->FF_Mass;
+		}
+	}
+	IronLUTUpdate();
+}
+
+//Store the mask0/mask1 fields of the current IronPars.Config[0]/[1] as overrides of the current instrument, the other fields of its
+//record are kept. Returns before the record is written
+void IronOvrSave(int mask0, int mask1) {
+	int i, slot, mask, age;
+	if (IronID == 0x1919 || IronPars.ID.Val != IronID) return;
+	EEPWait(&IronOvrReq);	//IronOvrRec is the data of the write, a record still to be applied is applied with the saved fields
+	slot = IronOvrFind(IronID);
+	if (slot < 0 || IronOvrRec.ID != IronID || !IronOvrValid(&IronOvrRec)) {
+		if (slot < 0) slot = -1 - slot;
+		memset(&IronOvrRec, 0, sizeof(t_IronOvr));
+		IronOvrRec.ID = IronID;
+	}
+	for (i = 2; i--; ) {
+		t_IronConfig * IC = (t_IronConfig *)&IronPars.Config[i];
+		t_IronOvrCh * C = &IronOvrRec.Ch[i];
+		mask = i ? mask1 : mask0;
+		C->Mask |= mask;
+		if (mask & IRON_OVR_GAIN) C->Gain = IC->SensorConfig.Gain;
+		if (mask & IRON_OVR_KP) C->PID_KP = IC->PID_KP;
+		if (mask & IRON_OVR_KI) C->PID_KI = IC->PID_KI;
+		if (mask & IRON_OVR_DGAIN) C->PID_DGain = IC->PID_DGain;
+		if (mask & IRON_OVR_OVSGAIN) C->PID_OVSGain = (UINT8)IC->PID_OVSGain;
+		if (mask & IRON_OVR_FF) {
+			C->FF_Loss = IC->FF_Loss;
+			C->FF_Mass = IC->FF_Mass;
+		}
+	}
+	IronOvrRec.Version = IRON_OVR_VERSION;
+	IronOvrRec.Seq = ++IronOvrSeq;
+	IronOvrRec.Sum = IronOvrSum(&IronOvrRec);
+	age = (IronOvrID[slot] == IronID) ? IronOvrAge[slot] : 0xFF;	//a new record makes all others one save older
+	for (i = 0; i < IRON_OVR_SLOTS; i++) {
+		if (IronOvrID[i] != 0xFFFF && IronOvrAge[i] < age) IronOvrAge[i]++;
+	}
+	IronOvrID[slot] = IronID;
+	IronOvrAge[slot] = 0;
+	IronOvrXfer(slot, sizeof(t_IronOvr), 1);
+}
+
+//Back to the Irons[] parameters for the current instrument from the next identification on
+void IronOvrClear() {
+	int slot;
+	EEPWait(&IronOvrReq);
+	IronOvrLoading = 0;
+	if ((slot = IronOvrFind(IronID)) < 0) return;
+	IronOvrID[slot] = 0xFFFF;
+	IronOvrRec.ID = 0xFFFF;
+	IronOvrXfer(slot, 2, 1);
+}
+
+//Save the coefficients of the current instrument after an auto-tune run
+void IronTuneSave() {
+	int i, mask[2] = {0, 0};
+	for (i = 2; i--; ) {
+		if (PIDTune[i].State != PID_TUNE_DONE) continue;
+		mask[i] = IRON_OVR_PID | IRON_OVR_FF;
+		PIDTune[i].State = PID_TUNE_SAVED;
+	}
+	IronOvrSave(mask[0], mask[1]);
+}
+
 void IronIdentify() {
 	static UINT16_VAL OID;
 	static UINT8 IDCnt;
@@ -905,7 +1115,7 @@ void IronIdentify() {
 	I2CAddCommands(I2C_SET_CPOT);
 	CBANDA = 1;
 	CBANDB = 1;
-	while (!I2CIdle);
+	while (!I2CIdle) mcuI2CIdle();
 
 	HCH = 0;
 	ID_3S = 1;
@@ -957,11 +1167,17 @@ void IronIdentify() {
 					break;
 				}
 			}
+			IronID = NewIronID.Val;
+			IronOvrLoad();
+			IronLUTUpdate();
 			PIDInit();
 		}
 	}
 	else {
-		if (IronID != 0x1919)IronPars = NoIronPars;
+		if (IronID != 0x1919) {
+			IronPars = NoIronPars;
+			IronLUTUpdate();
+		}
 		for (i = 2; i--; ) {
 			PIDVars[i].HInitData = 1;
 			PIDVars[i].HP = 0;
@@ -981,10 +1197,13 @@ void IronIdentify() {
 void IronInit() {
 	IronID = 0x1919;
 	IronPars = NoIronPars;
+	IronLUTUpdate();
 }
 
 void IronTasks() {
 	int i;
+	IronOvrApply();
+	if (PIDTuneState() == PID_TUNE_DONE) IronTuneSave();
 	if (IronTicks != ISRTicks) {
 		IronTicks = ISRTicks;
 		if (!mainFlags.Calibration && (IronTicks & 15) == 15) {
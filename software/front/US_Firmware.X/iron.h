@@ -42,6 +42,9 @@ typedef struct __PACKED {
     UINT16  PID_OVSGain;    //Positive overshoot prevention gain (0 - 32)
     UINT16  PID_PMax;       //maximum rated power (watts)
     UINT16  PID_PNom;       //nominal power for which PID coefficients are calculated
+    UINT16  FF_Loss;        //feed-forward heat loss (mW per degree above room temperature), 0 = no feed-forward (all Irons[] entries,
+                            //the coefficients are measured by the auto-tune and applied from the instrument overrides)
+    UINT16  FF_Mass;        //feed-forward thermal mass (mJ per degree)
 } t_IronConfig;
 
 typedef struct __PACKED {
@@ -52,6 +55,40 @@ typedef struct __PACKED {
     const t_SensorConfig * ColdJunctionSensorConfig;
 } t_IronPars;
 
+//Instrument parameter overrides (set over USB or by the auto-tune) in the EEPROM, one record per 32 byte page from IRON_OVR_EEP on,
+//keyed by IronID. The fields flagged in the channel Mask replace the Irons[] ones when the instrument is identified. When all slots
+//are taken, a new instrument replaces the record saved least recently
+#define IRON_OVR_EEP        128
+#define IRON_OVR_SLOTS      16
+#define IRON_OVR_VERSION    2       //record layout, records of other layouts are ignored
+
+#define IRON_OVR_GAIN       1       //SensorConfig.Gain
+#define IRON_OVR_KP         2
+#define IRON_OVR_KI         4
+#define IRON_OVR_DGAIN      8
+#define IRON_OVR_OVSGAIN    16
+#define IRON_OVR_FF         32      //FF_Loss and FF_Mass
+#define IRON_OVR_PID        (IRON_OVR_KP | IRON_OVR_KI | IRON_OVR_DGAIN | IRON_OVR_OVSGAIN)
+
+typedef struct __PACKED {
+    UINT8   Mask;           //IRON_OVR_xxx of the fields that are set
+    UINT16  Gain;
+    UINT16  PID_KP;
+    UINT16  PID_KI;
+    UINT8   PID_DGain;
+    UINT8   PID_OVSGain;
+    UINT16  FF_Loss;
+    UINT16  FF_Mass;
+} t_IronOvrCh;
+
+typedef struct __PACKED {
+    UINT16  ID;             //IronID, 0xFFFF = free slot
+    UINT8   Version;        //IRON_OVR_VERSION
+    t_IronOvrCh Ch[2];
+    UINT16  Seq;            //save count of the store when the record was written
+    UINT8   Sum;            //record bytes add up to 0
+} t_IronOvr;
+
 /* Iron temperature sensor types definition */
 #define SENSOR_UNDEFINED  0
 #define SENSOR_TC         1
@@ -66,8 +103,15 @@ typedef struct __PACKED {
 
 IRON_H_EXTERN UINT16 IronID;
 IRON_H_EXTERN volatile t_IronPars IronPars;
+IRON_H_EXTERN volatile UINT8 IronDualScan;                  //1 if both sensors of a dual instrument are read in every temperature window
+IRON_H_EXTERN volatile t_SensorConfig IronScanConfig;       //front end setup (currents, bands, gain, offset) both sensors are read with then
 IRON_H_EXTERN void IronInit();
 IRON_H_EXTERN void IronTasks();
+IRON_H_EXTERN void IronLUTUpdate();
+IRON_H_EXTERN void IronOvrInit();
+IRON_H_EXTERN void IronOvrSave(int mask0, int mask1);
+IRON_H_EXTERN void IronOvrClear();
+IRON_H_EXTERN void IronTuneSave();
 
 #undef IRON_H_EXTERN
 
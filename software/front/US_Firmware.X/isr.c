@@ -10,11 +10,55 @@
 #include "iron.h"
 #include "PID.h"
 #include "io.h"
+#include "EEP.h"
 
 volatile unsigned int ISRComplete = 0;
 
-volatile int I2CCommands;
-volatile int I2CCCommand;
+static UINT32 ISRBudget;
+static t_VIAcc VIAcc;   //heater voltage and current of the heated half period, accumulated at every ring half the DMA completes
+static UINT32 VILatch;  //sample pair latched at the 1/4 power point, for the power lost check of step 2
+static int ScanCh;      //dual scan: channel whose sensor step 6 reads, -1 if none
+#define SCAN_CONV 2     //ScanCh flag: the conversion of the sensor is running, its ADC interrupt completes step 6
+static volatile int PIDScan;    //bit n: the pending PID(n) is the dual scan run of step 6
+
+static UINT32 CapBuf[CAP_WORDS];
+static int CapTrig;
+static int CapHalves;   //half periods still to capture, 0 until the buffer is full
+static int CapOn;       //the half period being sampled is captured
+
+//Start the timer for the next step and keep its period as the time budget of the current step
+#define ISRStartTimer_us(us) {ISRBudget = (us); mcuStartISRTimer_us(ISRBudget);}
+
+//Core timer deadline us from now, for I2CSetPots
+#define ISRDue_us(us) (mcuReadCoreTimer() + (us) * (CORETIMER_FREQ / 1000000))
+
+static void ISRProfile(int step, UINT32 t, UINT32 budget){
+    volatile ISRProfS * P;
+    int i;
+    if(ISRProfReset){
+        for(i = ISR_PROF_N; i--;){
+            ISRProf[i].Min = 0xFFFFFFFF;
+            ISRProf[i].Max = 0;
+            ISRProf[i].Sum = 0;
+            ISRProf[i].Cnt = 0;
+            ISRProf[i].Over = 0;
+        }
+        ISRProfReset = 0;
+    }
+    if(step >= ISR_PROF_N) return;
+    P = &ISRProf[step];
+    if(t < P->Min) P->Min = t;
+    if(t > P->Max) P->Max = t;
+    if(P->Cnt >= 65536){
+        P->Sum >>= 1;
+        P->Cnt >>= 1;
+    }
+    P->Sum += t;
+    P->Cnt++;
+    P->Last = t;
+    P->Budget = budget;
+    if(budget && t > budget * (CORETIMER_FREQ / 1000000)) P->Over++;
+}
 
 void ISRInit(){
     int i;
@@ -23,17 +67,8 @@ void ISRInit(){
     ISRTicks = 1;
     CJTicks = 0;
     PHEATER = 0;
-    I2CStep = 0;
-    I2CCommands = 0;
-    I2CCCommand = 0;
-    I2CIdle = 1;
+    I2CInit();
     ISRStopped = 0;
-    EEPAddrR = 0xFFFF;
-    EEPDataR = 0;
-    EEPCntR = 0;
-    EEPAddrW = 0xFFFF;
-    EEPDataW = 0;
-    EEPCntW = 0;
     for(i = 2; i--;){
         PIDVars[i].NoHeater = 255;
         PIDVars[i].NoSensor = 255;
@@ -46,12 +81,29 @@ void ISRInit(){
     mainFlags.Calibration = 0;
     mainFlags.PowerLost = 0;    
     ISRComplete = 0;
+    ISRProfReset = 1;
+    PIDPending = 0;
+    PIDScan = 0;
+    ScanCh = -1;
+    CapState = CAP_OFF;
+    CapOn = 0;
+}
+
+//Capture n half periods (0 = as many as fit) from the trigger on, a capture in progress is dropped
+void CapArm(int trig, int n){
+    int i = mcuDisableInterrupts();
+    CapOn = 0;
+    VICapInit(&VICap, CapBuf, CAP_WORDS);
+    CapTrig = trig;
+    CapHalves = n;
+    CapState = CAP_ARMED;
+    mcuRestoreInterrupts(i);
 }
 
 void ISRStop(){
     ISRStopped = 1;
     while(!(ISRStopped & 2));
-    while(!I2CIdle);
+    while(!I2CIdle) mcuI2CIdle();
     mcuADCStop();
     mcuStopISRTimer();
     mcuCompDisable();
@@ -71,19 +123,12 @@ void ISRStart(){
     mcuDCTimerReset();
     mcuCompEnableH2L();
     VTIBuffCnt = 0;
+    ScanCh = -1;
     ISRStopped = 0;
     mainFlags.PowerLost = 0;
     mcuEnableInterrupts();
 }
 
-void I2CAddCommands(int c){
-    int i;
-    i=mcuDisableInterrupts();
-    I2CCommands |= c;
-    if(I2CIdle)mcuI2CWakeUp();
-    mcuRestoreInterrupts(i);
-}
-
 void OnPowerLost(){
     if(!mainFlags.PowerLost){
         mainFlags.PowerLost = 1;
@@ -99,9 +144,14 @@ void OnPowerLost(){
 
 void ISRHigh(int src){
     static int OldHeater;
+    static int HPower;      //power point of the heater in the current half period, latched in step 6
+    volatile t_PIDOut * PO;
     t_PIDVars *PV;
     t_IronConfig *IC;
+    t_SensorConfig *SC;
     UINT32 dw;
+    int s;
+    UINT32 ProfStart = mcuReadCoreTimer();
 
     switch(src){
         case CompH2L:
@@ -114,6 +164,7 @@ void ISRHigh(int src){
             return;
     }
 
+    ISRBudget = 0;
     PV = (t_PIDVars *)&PIDVars[1];
     IC = (t_IronConfig *)&IronPars.Config[1];
     if((ADCStep < 2) || (IC->SensorConfig.Type == SENSOR_UNDEFINED)){
@@ -141,21 +192,26 @@ void ISRHigh(int src){
                 d-=300; //260us before zero cross + 40us to compensate group delay of R46-R43-C60 6367Hz R-C filter (25us) + interrupt latency (around 15us)
                 if(d < 10) d = 10;
                 if(d > 1000) d = 1000;
-                mcuStartISRTimer_us(d);
+                ISRStartTimer_us(d);
             }
             break;
         case 1: //260us before AC zero cross - turn off power, prepare ADC, Voltage reference, calculate heater resistance, input voltage, current and power.
             PGD = 1;
-            mcuStartISRTimer_us(50);
+            ISRStartTimer_us(50);
             HEATER = 0;
             mcuADCStartManualVRef();
             break;
-        case 2: //210us before AC zero cross - setup channels, calculate voltage, current, power and heater resistance
+        case 2: //210us before AC zero cross - setup channels, finish voltage, current, power and heater resistance
+            if(CapOn){
+                if(VTIBuffCnt) VICapAdd(&VICap, (const UINT32 *)VIRing, VIRingEnd);
+                CapOn = 0;
+                if(VICap.Lost || !--CapHalves) CapState = CAP_DONE;
+            }
             if(mainFlags.ACPower){
-                mcuStartISRTimer_us(250);
+                ISRStartTimer_us(250);
             }
             else{
-                mcuStartISRTimer_us(550);
+                ISRStartTimer_us(550);
             }
             
             if(mainFlags.Calibration){
@@ -170,7 +226,7 @@ void ISRHigh(int src){
             }                        
             
             if(ISRComplete){
-                if((dw = VTIBuffCnt >> 2) && (VBuff[dw] < 90) && OldHeater && (TIBuff[dw] < 16)){ //power lost if <0.5A and <7.4V
+                if(VTIBuffCnt && (VIACC_V(VILatch) < 90) && OldHeater && (VIACC_I(VILatch) < 16)){ //power lost if <0.5A and <7.4V
                     OnPowerLost();
                     ISRStep = 0;
                     return;
@@ -182,7 +238,7 @@ void ISRHigh(int src){
                         dw -= dw >> 4;
                         dw += CompLowTime;
 
-                        if(OldHeater && PV->Power && CompLowTimeOn && CompLowTimeOff && CompLowTimeOn > CompLowTimeOff){
+                        if(OldHeater && HPower && CompLowTimeOn && CompLowTimeOff && CompLowTimeOn > CompLowTimeOff){
                             dw += CompLowTimeOn - CompLowTimeOff; //when heater was on 1/2 or 1/4 power, comp low time is shorter then on full power - compensate for it;
                         }
 
@@ -202,48 +258,15 @@ void ISRHigh(int src){
                 }
                 else{
                     if(OldHeater){
-                        UINT32 i, l;
-                        if((i = l = VTIBuffCnt) > 1){
-                            UINT32 sv = 0, si = 0, sp = 0, ri = 0, rv = 0, r = 0;
-                            for(i--, l--; i--;){
-                                UINT32 ci = TIBuff[i];
-                                UINT32 cv = VBuff[i] + VBuff[i + 1];
-                                if(ci < 1023){
-                                    if(ri < ci && VBuff[i] < 1023 && VBuff[i + 1] < 1023){
-                                        ri = ci;
-                                        rv = cv;
-                                        r = 0;
-                                    }
-                                }
-                                else{
-                                    if(!r && ri) r = ((rv * 6738) / ri) >> 9;
-                                    if(r) ci = ((cv * 6738) / r) >> 9;
-                                }
-                                sv += cv * cv;
-                                si += ci * ci;
-                                sp += ci * cv;
-                            }                            
-
-                            r = (ri ? (((rv * 6738) / ri) + 256) >> 9 : 0x7FFF);
-                            // 6738 = 10 * 256 * (((Rs1 * (R48 / R42)) / VRef) * 1024) / (((R51 / (R47 + R51)) / VRef) * 1024)
-                            //      = 10 * 256 * (((0.003 * (47K / 1.5K)) / 3.0V) *1024) / (((1K / (27K + 1K)) / 3.0V) * 1024)
-                            //      = 6737.92
-
-                            sv = (sv + (l >> 1)) / l;
-                            si = (si + (l >> 1)) / l;
-                            l *= (UINT32)(391 * 2);
-                            sp = (sp + (l >> 1)) / l;
-                            // 391 = (((R51 / (R47 + R51)) / VRef) * 1024) * (((Rs1 * (R48 / R42)) / VRef) * 1024)
-                            //     = (((1K / (27K + 1K)) / 3.0V) * 1024) * (((0.003 * (47K / 1.5K)) /3.0V) * 1024)
-                            //     = 391,13549206349206349206349206349
-
+                        VIAccAdd(&VIAcc, (const UINT32 *)VIRing, VIRingEnd);   //samples after the last completed ring half
+                        if(VIAcc.Cnt){
                             dw = POWER_DUTY;
                             if(IronPars.Config[1].SensorConfig.Type) dw >>= 1;
-                            PV->HV = (mcuSqrt(sv * dw) + 31) >> 6;
-                            PV->HI = (mcuSqrt(si * dw) + 15) >> 5;
-                            PV->HP = ((sp * dw) + 511) >> 10;
-                            PV->HR = r;                             
-
+                            VIAccFinish(&VIAcc, dw);
+                            PV->HV = VIAcc.HV;
+                            PV->HI = VIAcc.HI;
+                            PV->HP = VIAcc.HP;
+                            PV->HR = VIAcc.HR;
                             PV->HNewData = 1;
                         }
                     }
@@ -281,7 +304,7 @@ void ISRHigh(int src){
             }
             break;
         case 5: //125us after zero cross - check for sensor open, heater open, perform PID and wait to 1/2 power point (AC voltage point just between 2 adjacent zero crosses)
-            mcuStartISRTimer_us(125);
+            ISRStartTimer_us(125);
             if(ISRComplete && !(ADCStep & 1)) mcuCompEnableL2H();
             ISRComplete = 0;
             if(!mainFlags.Calibration){
@@ -292,7 +315,6 @@ void ISRHigh(int src){
             ADCData.VTEMP[ADCStep & 1] = mcuADCRES >> 2;
             
             if(ADCStep & 1) {
-                PGC=1;
                 if(PV->HR > 3000) {
                     if(PV->NoHeater < 255) PV->NoHeater++;
                 }
@@ -311,9 +333,21 @@ void ISRHigh(int src){
                 else{
                     PV->NoSensor = 0;
                 }
-                PID(ADCStep >> 1);
-                if(PV->KeepOff)PV->KeepOff--;
-                PGC=0;
+                //latch the samples and leave sensor conversion and PID to the IPL5 PID interrupt
+                s = ADCStep >> 1;
+                PIDADC[s].HeaterOn = ADCData.HeaterOn;
+                PIDADC[s].VRT = ADCData.VRT;
+                PIDADC[s].VTEMP[1] = ADCData.VTEMP[1];
+                PIDPending |= 1 << s;
+                mcuPIDWakeUp();
+                if(IronDualScan && !mainFlags.Calibration){
+                    //dual scan: select the other sensor, step 6 reads it. Its heater was off in the last two half periods
+                    ScanCh = s ^ 1;
+                    SC = (t_SensorConfig *)&IronPars.Config[ScanCh].SensorConfig;
+                    CHSEL1 = SC->InputP;
+                    CHSEL2 = SC->InputN;
+                    CHPOL = SC->InputInv;
+                }
             }
 
             ADCStep = (ADCStep + 1) & 3;
@@ -327,18 +361,64 @@ void ISRHigh(int src){
             HCH = IC->SensorConfig.HChannel;
             break;
         case 6: //250us (or 550us on  DC) after zero cross - turn on power if needed, setup channels for handle sensor if present and wait to 1/2 power point at the middle of half period
-            dw = MAINS_PER_H_US - 250;
-            mcuStartISRTimer_us(dw); //next step will be at the center of mains half period
+            if(ScanCh < 0 || !(ScanCh & SCAN_CONV)){
+                dw = MAINS_PER_H_US - 250;
+                ISRStartTimer_us(dw); //next step will be at the center of mains half period
+            }
+            if(ScanCh >= 0 && !(ScanCh & SCAN_CONV)){   //dual scan: convert the sensor selected in step 5 before any heater is turned on,
+                ScanCh |= SCAN_CONV;                    //the ADC interrupt of the conversion enters step 6 again
+                mcuADCRead(ADCH_TEMP, 4);
+                ISRProfile(ISRStep, mcuReadCoreTimer() - ProfStart, ISRBudget);
+                return;
+            }
+            if(ScanCh >= 0){                            //second entry, the timer runs since the first one
+                ISRBudget = MAINS_PER_H_US - 250;
+                s = ScanCh & ~SCAN_CONV;
+                ScanCh = -1;
+                dw = mcuADCRES >> 2;
+                CHSEL1 = 0;
+                CHSEL2 = 0;
+                if(dw >= 1023){
+                    if(PIDVars[s].NoSensor < 255) PIDVars[s].NoSensor++;
+                }
+                else{
+                    PIDVars[s].NoSensor = 0;
+                }
+                PIDADC[s].HeaterOn = 0;
+                PIDADC[s].VRT = 0;      //room temperature is left to the PID step of step 5
+                PIDADC[s].VTEMP[1] = dw;
+                PIDPending |= 1 << s;
+                PIDScan |= 1 << s;
+                mcuPIDWakeUp();
+            }
+            PO = &PV->Out[PV->OutSel];   //last complete PID result, even if the PID task is still running
+            HPower = PO->Power;
             if(!(ADCStep & 1)){
-                PV->PWM += PV->PIDDuty;
+                PV->PWM += PO->Duty;
                 PHEATER = ((PV->PWM>>24)!=0);
                 PV->PWM &= 0x00FFFFFF;
             }            
-            if(mainFlags.PowerLost || PV->KeepOff || mainFlags.Calibration || IC->SensorConfig.Type == SENSOR_UNDEFINED || IC->SensorConfig.Type == SENSOR_NONE ) PHEATER = 0;
-            if(!PV->Power) HEATER = PHEATER;  //Turn on heater if on full power    
+            if(mainFlags.PowerLost || PO->KeepOff || mainFlags.Calibration || IC->SensorConfig.Type == SENSOR_UNDEFINED || IC->SensorConfig.Type == SENSOR_NONE ) PHEATER = 0;
+            if(!HPower) HEATER = PHEATER;  //Turn on heater if on full power    
             PGD = 0;
 
             mcuADCStartAutoVRef(PHEATER?0:1);                        
+            VIAccInit(&VIAcc);
+            if(CapState == CAP_ARMED && (CapTrig == CAP_TRIG_NOW || PHEATER)) CapState = CAP_RUN;
+            if(CapState == CAP_RUN){
+                t_VICapHdr H;
+                H.Ticks = ISRTicks;
+                H.Cnt = 0;
+                H.VTemp = ADCData.VTEMP[(ADCStep & 1) ^ 1];    //read in step 4, before ADCStep moved on
+                H.OffDelay = (PV->OffDelay > 0xFFFF) ? 0xFFFF : PV->OffDelay;
+                H.Heater = PHEATER;
+                H.Ch = PV - (t_PIDVars *)PIDVars;
+                H.Power = HPower;
+                H.ADCStep = ADCStep;
+                CapOn = VICapStart(&VICap, &H);
+                if(!CapOn) CapState = CAP_DONE;
+            }
+            VILatch = 1023 | (1023UL << 16);
             if(!mainFlags.Calibration && !PHEATER && !CJTicks && IronPars.ColdJunctionSensorConfig && IronPars.ColdJunctionSensorConfig->HChannel == IC->SensorConfig.HChannel){
                 CHSEL1 = IronPars.ColdJunctionSensorConfig->InputP;
                 CHSEL2 = IronPars.ColdJunctionSensorConfig->InputN;
@@ -349,7 +429,7 @@ void ISRHigh(int src){
                 I2CData.CurrentB.ui16 = IronPars.ColdJunctionSensorConfig->CurrentB;
                 I2CData.Gain.ui16 = IronPars.ColdJunctionSensorConfig->Gain;
                 I2CData.Offset.ui16 = IronPars.ColdJunctionSensorConfig->Offset;
-                if(!mainFlags.PowerLost)I2CAddCommands(I2C_SET_CPOT | I2C_SET_GAINPOT | I2C_SET_OFFSET);
+                if(!mainFlags.PowerLost)I2CSetPots(ISRDue_us(MAINS_PER_H_US - 250));    //cold junction sample of step 7
             }
             
             if(ADCStep == 0){
@@ -362,27 +442,29 @@ void ISRHigh(int src){
             }
             break;
         case 7:  //1/2 power point, AC voltage highest point (center of half period) - check for power lost and turn on heater if 1/2 power and wait for 1/4 power point
-            mcuStartISRTimer_us(MAINS_PER_Q_US); //Next step will be at 1/4 power point in the mains period
-            if(!MAINS || ((VBuff[dw = (mcuTIBuffPos() >> 2) - 1] < 90) && PHEATER && (TIBuff[dw] < 16))){ //power lost if <0.5A and <7.4V
+            ISRStartTimer_us(MAINS_PER_Q_US); //Next step will be at 1/4 power point in the mains period
+            dw = VIRing[(mcuVIRingPos() - 1) & VIACC_RING_MASK];  //last sample pair
+            if(!MAINS || ((VIACC_V(dw) < 90) && PHEATER && (VIACC_I(dw) < 16))){ //power lost if <0.5A and <7.4V
                 OnPowerLost();
                 return;
             }
-            if(PV->Power < 2) HEATER = PHEATER;                
+            if(HPower < 2) HEATER = PHEATER;                
             if(!mainFlags.Calibration){
                 CHSEL1 = 0;
                 CHSEL2 = 0;  
             }
             CHPOL = IC->SensorConfig.InputInv;
-            CBANDA = IC->SensorConfig.CBandA;
-            CBANDB = IC->SensorConfig.CBandB;
-            I2CData.CurrentA.ui16 = IC->SensorConfig.CurrentA;
-            I2CData.CurrentB.ui16 = IC->SensorConfig.CurrentB;
-            I2CData.Gain.ui16 = IC->SensorConfig.Gain;
-            I2CData.Offset.ui16 = IC->SensorConfig.Offset;
-            if(!mainFlags.PowerLost)I2CAddCommands(I2C_SET_CPOT | I2C_SET_GAINPOT | I2C_SET_OFFSET);
+            SC = (IronDualScan && !mainFlags.Calibration) ? (t_SensorConfig *)&IronScanConfig : &IC->SensorConfig;  //dual scan: setup for both sensors
+            CBANDA = SC->CBandA;
+            CBANDB = SC->CBandB;
+            I2CData.CurrentA.ui16 = SC->CurrentA;
+            I2CData.CurrentB.ui16 = SC->CurrentB;
+            I2CData.Gain.ui16 = SC->Gain;
+            I2CData.Offset.ui16 = SC->Offset;
+            if(!mainFlags.PowerLost)I2CSetPots(ISRDue_us(MAINS_PER_H_US));             //zero cross, before the temperature read of step 4
             
             if(!mainFlags.Calibration && !PHEATER && !CJTicks && IronPars.ColdJunctionSensorConfig && IronPars.ColdJunctionSensorConfig->HChannel == IC->SensorConfig.HChannel){
-                ADCData.VCJ = TIBuff[(mcuTIBuffPos() >> 2) - 1];
+                ADCData.VCJ = VIACC_I(dw);
                 CJTicks = CJ_PERIOD;
             }
             else{
@@ -391,11 +473,12 @@ void ISRHigh(int src){
             }
             break;
         case 8: //1/4 power point - turn on heater if needed
-            mcuStartISRTimer_us(MAINS_PER_E_US); //Next step will be at 1/8 power point in the mains period
-            if(PV->Power < 3) HEATER = PHEATER;                
+            ISRStartTimer_us(MAINS_PER_E_US); //Next step will be at 1/8 power point in the mains period
+            if(HPower < 3) HEATER = PHEATER;                
+            VILatch = VIRing[(mcuVIRingPos() - 1) & VIACC_RING_MASK];
             break;
         case 9: //1/8 power point - turn on heater if needed
-            mcuStartISRTimer_us(200);
+            ISRStartTimer_us(200);
             HEATER = PHEATER;
             break;
         case 10: //at least 200uS after power was turned on - enable high-to-low comparator event in order to start new cycle.
@@ -405,214 +488,38 @@ void ISRHigh(int src){
             ISRComplete = 1;
             break;
     }
+    //steps past the half period are idle, ISR_PROF_PID and ISR_PROF_SCAN are left to PIDISRTasks
+    if(ISRStep < ISR_STEPS) ISRProfile(ISRStep, mcuReadCoreTimer() - ProfStart, ISRBudget);
     if(ISRStep<255)ISRStep++;    
 }
 
-void I2CISRTasks(){
-    
-    int i;
-    UINT16 ui;
-    BOOL CmdOK;
-
-    if(I2CCCommand){
-        I2CStep++;
-    }
-    else{
-        I2CStep=0;
-        i=mcuDisableInterrupts();
-        if(I2CCommands &= 0xFF){
-            I2CCCommand = 1;
-            while(I2CCCommand &= 0xFF){
-                if(I2CCommands & I2CCCommand){
-                    I2CCommands -= I2CCCommand;
-                    I2CIdle=0;
-                    break;
-                }
-                I2CCCommand <<= 1;
-            }
-        }
-        else{
-            I2CIdle=1;
-        }
+//Deferred part of ISRHigh steps 5 and 6, run by the IPL5 PID interrupt: sensor conversion and PID of the latched samples.
+//PID() publishes its results through t_PIDVars.Out, so step 6 never sees a half updated set.
+void PIDISRTasks(){
+    UINT32 ProfStart = mcuReadCoreTimer();
+    int i, s;
+    while(PIDPending){
+        s = (PIDPending & 1) ? 0 : 1;
+        PGC = 1;
+        PID(s);
+        PGC = 0;
+        i = mcuDisableInterrupts();
+        PIDPending &= ~(1 << s);
+        //each run against the time to the step which uses it: step 6 for the one of step 5, step 7 for the dual scan one of step 6
+        if(PIDScan & (1 << s)) ISRProfile(ISR_PROF_SCAN, mcuReadCoreTimer() - ProfStart, ISRProf[6].Budget);
+        else ISRProfile(ISR_PROF_PID, mcuReadCoreTimer() - ProfStart, ISRProf[5].Budget);
+        PIDScan &= ~(1 << s);
         mcuRestoreInterrupts(i);
+        ProfStart = mcuReadCoreTimer();
     }
-    
-    CmdOK = TRUE;
-    switch(I2CCCommand){
-        case I2C_SET_CPOT:
-            switch(I2CStep){
-                case 0:
-                    mcuI2CStart();
-                    break;
-                case 1:
-                    mcuI2CSendAddrW(CPOT);
-                    break;
-                case 2:
-                    mcuI2CSendByte(0x40); //write to TCON, disable general ca??
-                    break;
-                case 3:
-                    ui=0xFF;
-                    if(I2CData.CurrentA.ui16 == 0) ui &= 0xF0;      //disconnect R0A when currentA is 0
-                    if(I2CData.CurrentA.ui16 >= 256) ui &= 0xFE;    //disconnect R0B when currentA is MAX
-                    if(I2CData.CurrentB.ui16 == 0) ui &= 0x0F;      //disconnect R1A when currentB is 0
-                    if(I2CData.CurrentB.ui16 >= 256) ui &=0xEF;     //disconnect R1B when currentB is MAX
-                    mcuI2CSendByte(ui); //write to TCON
-                    break;
-                case 4:
-                    mcuI2CSendByte(I2CData.CurrentA.ui16 >> 8); //Wiper0
-                    break;
-                case 5:
-                    mcuI2CSendByte(I2CData.CurrentA.ui16 & 0xFF);
-                    break;
-                case 6:
-                    mcuI2CSendByte((I2CData.CurrentB.ui16 >> 8) | 0x10); //Wiper1
-                    break;
-                case 7:
-                    mcuI2CSendByte(I2CData.CurrentB.ui16 & 0xFF);
-                    break;
-                case 8:
-                    I2CCCommand=0;
-                    mcuI2CStop();
-                    break;
-            }
-            break;
-        case I2C_SET_GAINPOT:
-            switch(I2CStep){
-                case 0:
-                    mcuI2CStart();
-                    break;
-                case 1:
-                    mcuI2CSendAddrW(GAINPOT);
-                    break;
-                case 2:
-                    mcuI2CSendByte(I2CData.Gain.ui16 >> 8);
-                    break;
-                case 3:
-                    mcuI2CSendByte(I2CData.Gain.ui16 & 0xFF);
-                    break;
-                case 4:
-                    I2CCCommand=0;
-                    mcuI2CStop();
-                    break;
-            }
-            break;
-        case I2C_SET_OFFSET:
-            switch(I2CStep){
-                case 0:
-                    mcuI2CStart();
-                    break;
-                case 1:
-                    mcuI2CSendAddrW(OFFADC);
-                    break;
-                case 2:
-                    mcuI2CSendByte(0b01011000);
-                    break;
-                case 3:
-                    mcuI2CSendByte(I2CData.Offset.ui16 >> 2);
-                    break;
-                case 4:
-                    mcuI2CSendByte((I2CData.Offset.ui16 << 6) & 0xFF);
-                    break;
-                case 5:
-                    I2CCCommand=0;
-                    mcuI2CStop();
-                    break;
-            }
-            break;
-        case I2C_EEPWRITE:
-            switch(I2CStep){
-                case 0:
-                    mcuI2CStart();
-                    break;
-                case 1:
-                    mcuI2CSendAddrW(EEP);
-                    break;
-                case 2:
-                    if((CmdOK = mcuI2CIsACK()))mcuI2CSendByte(EEPAddrW >> 8);
-                    break;
-                case 3:
-                    mcuI2CSendByte(EEPAddrW & 0xFF);
-                    break;
-                case 4:
-                    mcuI2CSendByte(*EEPDataW);
-                    break;
-                case 5:
-                    EEPCntW--;
-                    if(EEPCntW){
-                        EEPDataW++;
-                        EEPAddrW++;
-                        if(((EEPAddrW & 31) == 0) || (I2CCommands & (I2CCCommand-1))){ //Abort if EEPROM page boundary is crossed, or if there is pending higher priority command
-                            CmdOK = FALSE;
-                        }
-                        else {
-                            I2CStep = 4;
-                            mcuI2CSendByte(*EEPDataW);
-                        }
-                    }
-                    else{
-                        EEPAddrW=0xFFFF;
-                        I2CCCommand=0;
-                        mcuI2CStop();
-                    }
-                    break;
-            }
-            break;
-        case I2C_EEPREAD:
-            switch(I2CStep){
-                case 0:
-                    mcuI2CStart();
-                    break;
-                case 1:
-                    mcuI2CSendAddrW(EEP);
-                    break;
-                case 2:
-                    if((CmdOK = mcuI2CIsACK()))mcuI2CSendByte(EEPAddrR >> 8);
-                    break;
-                case 3:
-                    mcuI2CSendByte(EEPAddrR & 0xFF);
-                    break;
-                case 4:
-                    mcuI2CStart();
-                    break;
-                case 5:
-                    mcuI2CSendAddrR(EEP);
-                    break;
-                case 6:
-                    mcuI2CReceiverEnable();
-                    break;
-                case 7:
-                    *EEPDataR = mcuI2CGetByte();
-                    EEPCntR--;
-                    if(EEPCntR){
-                        EEPDataR++;
-                        EEPAddrR++;
-                        if(((EEPAddrR & 31) == 0) || (I2CCommands & (I2CCCommand - 1))){ //Abort if EEPROM page boundary is crossed, or if there is pending higher priority command
-                            mcuI2CReceiverDisable();
-                            CmdOK = FALSE;                            
-                        }
-                        else{
-                            mcuI2CACK();
-                            I2CStep = 5;
-                        }
-                    }
-                    else{
-                        mcuI2CReceiverDisable();
-                        EEPAddrR = 0xFFFF;
-                        I2CCCommand=0;
-                        mcuI2CStop();
-                    }
-                    break;
-            }
-            break;
-        default:
-            I2CCCommand=0;
-            break;
-    }
-    if(CmdOK == FALSE){
-        I2CCommands |= I2CCCommand;
-        I2CCCommand=0;
-        mcuI2CStop();
-    }    
+}
+
+//DMA channel 0 completed a ring half (IPL7, like ISRHigh): add the samples of the heated half period converted so far.
+//After the capture is stopped step 2 adds the rest, at most one ring half and a part of the next one
+void VIRingISRTasks(){
+    VIRingCnt += VIACC_RING_HALF;
+    if(PHEATER) VIAccAdd(&VIAcc, (const UINT32 *)VIRing, mcuVIRingPos());
+    if(CapOn) VICapAdd(&VICap, (const UINT32 *)VIRing, mcuVIRingPos());
 }
 
 #undef _ISR_C
@@ -16,6 +16,7 @@ extern "C" {
 #include <GenericTypeDefs.h>
 #include "typedefs.h"
 #include "mcu.h"
+#include "sensorMath.h"
     
 #define CJ_PERIOD 500;  //Period in ticks of measurement of cold junction sensor temperature, if present.    
 
@@ -37,6 +38,21 @@ typedef struct {
     SUINT16 Offset;
 }I2CDataS;
 
+#define ISR_STEPS 11    //number of ISRHigh steps in a mains half period
+#define ISR_PROF_PID ISR_STEPS      //profile entry of the deferred PID task run of step 5
+#define ISR_PROF_SCAN (ISR_STEPS + 1)   //profile entry of the deferred PID task run of the dual scan in step 6
+#define ISR_PROF_N (ISR_STEPS + 2)  //number of profile entries
+
+typedef struct {
+    UINT32 Min;         //shortest step run time (core timer ticks)
+    UINT32 Max;         //longest step run time (core timer ticks)
+    UINT32 Sum;         //sum of the run times of the last Cnt runs (core timer ticks)
+    UINT32 Cnt;
+    UINT32 Budget;      //timer period to the next step (us), 0 if the next step is started by ADC or comparator
+    UINT32 Over;        //number of runs longer than Budget
+    UINT32 Last;        //run time of the last run (core timer ticks)
+}ISRProfS;
+
 #ifndef _ISR_C
 #define ISRC_EXTERN extern
 #else
@@ -52,18 +68,41 @@ ISRC_EXTERN volatile unsigned int CJTicks;
 ISRC_EXTERN volatile int ISRStopped;
 
 ISRC_EXTERN volatile ADCDataS ADCData;
-ISRC_EXTERN volatile UINT32 VBuff[256];
-ISRC_EXTERN volatile UINT32 TIBuff[256];
-ISRC_EXTERN volatile unsigned int VTIBuffCnt;
+ISRC_EXTERN volatile ADCDataS PIDADC[2];  //ADC samples latched for the deferred PID task, per PID step
+ISRC_EXTERN volatile int PIDPending;     //PID steps waiting for the deferred task, bit n = PID(n), 0 if none
+ISRC_EXTERN volatile UINT32 VIRing[VIACC_RING];    //heater voltage and current (or cold junction) sample pairs, 16 bits each,
+                                                    //written by DMA channel 0 in a ring. 128 bytes instead of the 2 KB of VBuff/TIBuff
+ISRC_EXTERN volatile unsigned int VIRingCnt;       //samples of the completed ring halves since the capture started
+ISRC_EXTERN volatile unsigned int VIRingEnd;       //ring index of the next sample when the capture was stopped
+ISRC_EXTERN volatile unsigned int VTIBuffCnt;      //number of samples of the stopped capture, 0 if none
 
 ISRC_EXTERN UINT32 OffDelayOff;
 
+//Raw capture: half periods of VIRing samples from the one after the trigger on, see t_VICap. 8 KB, the data memory
+//used was 4.9 KB of 32 KB
+#define CAP_WORDS 2048
+enum CAP_STATES{
+    CAP_OFF,
+    CAP_ARMED,          //waiting for the trigger
+    CAP_RUN,
+    CAP_DONE            //VICap is complete, to be read
+};
+enum CAP_TRIGGERS{
+    CAP_TRIG_NOW,       //the next half period
+    CAP_TRIG_HEATER     //the next heated half period
+};
+ISRC_EXTERN volatile int CapState;
+ISRC_EXTERN t_VICap VICap;
+
 ISRC_EXTERN volatile UINT32 CompLowTime;
 ISRC_EXTERN volatile UINT32 CompLowTimeOn;
 ISRC_EXTERN volatile UINT32 CompLowTimeOff;
 
 ISRC_EXTERN volatile I2CDataS I2CData;
 
+ISRC_EXTERN volatile ISRProfS ISRProf[ISR_PROF_N];
+ISRC_EXTERN volatile int ISRProfReset;
+
 ISRC_EXTERN volatile UINT8 PHEATER;
 
 ISRC_EXTERN volatile int ADCStep;
@@ -91,6 +130,18 @@ enum I2C_FLAGS{
     I2C_EEPWRITE = 8,
     I2C_EEPREAD = 16
 };
+#define I2C_CMDS 5      //number of I2C_FLAGS
+#define I2C_POTS (I2C_SET_CPOT | I2C_SET_GAINPOT | I2C_SET_OFFSET)
+
+typedef struct {
+    UINT32 Cmds;        //commands run
+    UINT32 Skipped;     //pot and DAC writes skipped by I2CSetPots, the device has the value
+    UINT32 Late;        //pot and DAC writes complete after their deadline
+    UINT32 Bytes;       //bus utilisation: bytes sent or received, with the device addresses
+    UINT32 Starts;      //start and repeated start conditions
+    UINT32 Polls;       //EEPROM addressings not acknowledged during its write cycle
+    UINT32 BusyTicks;   //core timer ticks with a command on the bus
+}I2CStatsS;
 
 enum IntSrc{
     CompH2L=1,
@@ -101,15 +152,21 @@ enum IntSrc{
 
 ISRC_EXTERN volatile int I2CStep;
 ISRC_EXTERN volatile unsigned char I2CIdle;
+ISRC_EXTERN volatile I2CStatsS I2CStats;
 
 
 ISRC_EXTERN void ISRInit();
 ISRC_EXTERN void ISRStop();
 ISRC_EXTERN void ISRStart();
+ISRC_EXTERN void I2CInit();               //I2C engine, in EEP.c
 ISRC_EXTERN void I2CAddCommands(int c);
+ISRC_EXTERN void I2CSetPots(UINT32 due);
 ISRC_EXTERN void OnPowerLost();
 ISRC_EXTERN void ISRHigh(int src);
-ISRC_EXTERN void I2CISRTasks();
+ISRC_EXTERN void I2CISRTasks();           //in EEP.c
+ISRC_EXTERN void PIDISRTasks();
+ISRC_EXTERN void VIRingISRTasks();
+ISRC_EXTERN void CapArm(int trig, int n);
 
 
 #undef ISRC_EXTERN
@@ -22,7 +22,6 @@
 #include "EEP.h"
 #include "OLED.h"
 #include "pars.h"
-#include "logo.h"
 
 volatile T_BOARD_VERSION BoardVersion;
 
@@ -56,15 +55,7 @@ int main(void){
 
     OLEDInit();
     
-    {
-        int i, x, y;          
-        i = 1023;
-        for(x = 0; x < 128; x++){
-            for(y = 0; y < 8; y++){
-                OLEDBUFF.B[y][x] = ~logo[i--];
-            }
-        }
-    }
+    OLEDWritePacked(0, 128, 0, 8, &logoPacked, 0);
     OLEDPrintNum68(0, 0, 1, 0);
     OLEDUpdate();
     
@@ -160,6 +151,7 @@ int main(void){
     OLEDUpdate();
 
     LoadPars();
+    IronOvrInit();
     OLEDPrintNum68(0, 0, 2, 46);
     OLEDUpdate();
 
@@ -185,6 +177,7 @@ int main(void){
             OLED_VCC = 0; //Turn on OLED's power
             MenuTasks(1);
             _delay_ms(1000);
+            while(EEPBusy()) mcuI2CIdle();  //the last page is written when EEPBusy is cleared
             mcuReset();
             while(1);
         }
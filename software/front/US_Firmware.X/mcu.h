@@ -12,8 +12,12 @@
 extern "C" {
 #endif
     
+#ifndef HOST_BUILD
 #include <xc.h>
 #include "PIC32MX564F128H.h"
+#else
+#include "hal.h"    //host build (US_Simulator) - MCU peripherals are replaced by the simulator HAL
+#endif
 
 #ifdef	__cplusplus
 }
@@ -13,9 +13,6 @@
 #include "pars.h"
 #include "iron.h"
 #include "EEP.h"
-#include "usb/usb.h"
-#include "usb/usb_driver.h"
-#include "usb/usb_function_hid.h"
 
 #define intshr(a,b) ((a < 0) ? (-((-a) >> b)) : (a >> b))
 
@@ -35,6 +32,7 @@ static int ModeTicks;
 static int DoExit;
 static int DispTemp;
 static int CalRes;
+static int CalPage;
 static UINT8 OldNAP;
 static int NapTicks;
 static int TipChangeTicks;
@@ -57,6 +55,7 @@ static union {
         int Debug:1;
         int Input:1;
         int Version:1;
+        int ISRProf:1;
     }f;
 }OLEDFlags;
 
@@ -102,9 +101,19 @@ void MenuInit(){
     NapTicks = pars.NapFilterTicks + 1;
     TipChangeTicks = 0;
     CalCh = 0;
+    CalPage = 0;
     Enc = LastEnc = 0;
 }
 
+#ifdef HOST_BUILD
+//Menu screen the next OLEDTasks draws, for the simulator benchmarks
+void MenuSetMode(T_MENU_MODE mode, int dispTemp){
+    CMode = mode;
+    ModeTicks = 255;
+    DispTemp = dispTemp;
+}
+#endif
+
 void OLEDTasks(int powerLost){
     int dual = IronPars.Config[1].SensorConfig.Type;
     t_PIDVars * PV1 = (t_PIDVars *)&PIDVars[0];
@@ -257,6 +266,10 @@ void OLEDTasks(int powerLost){
                                 case 19: //Version info
                                     CMode=VERSION_INFO;
                                     break;
+                                case 20: //PID auto-tune
+                                    CMode=AUTO_TUNE;
+                                    PIDTuneStart();
+                                    break;
                                 default:
                                     CMode=SET_PARAMS;
                                     break;
@@ -271,7 +284,7 @@ void OLEDTasks(int powerLost){
                         int p = MenuOrder[CPar];
                         if(BTicks[1].n || EncDiff) ModeTicks = 250;
                         if(BTicks[1].o && (BTicks[1].n == 0)){
-                            pars.b[p] = CParVal;
+                            ParsSet(p, CParVal);
                             CMode = MENU;
                         }
                         else {
@@ -280,7 +293,7 @@ void OLEDTasks(int powerLost){
                             EncDiff=0;
                             if((CParVal < ParDef[p].Min))CParVal = ParDef[p].Max;
                             if((CParVal > ParDef[p].Max))CParVal = ParDef[p].Min;
-                            if(ParDef[p].Immediate)pars.b[p] = CParVal;
+                            if(ParDef[p].Immediate)ParsSet(p, CParVal);
                         }
                         OLEDFlags.f.Pars = 1;
                     }
@@ -290,14 +303,33 @@ void OLEDTasks(int powerLost){
                     if(BTicks[1].o && !BTicks[1].n){
                         if((BTicks[1].o<100)){
                             mainFlags.Calibration = 0;
+                            CalPage = 0;
                             CMode = DEFAULT_MENU;
                             break;
                         }
                         else{
-                            CalCh = CalCh ? 0 : 1;
+                            //long press: channel A, channel B, ISR step profile
+                            if(CalPage){
+                                CalPage = 0;
+                            }
+                            else if(CalCh){
+                                CalCh = 0;
+                                CalPage = 1;
+                            }
+                            else{
+                                CalCh = 1;
+                            }
                         }
                     }
+                    if(CalPage){
+                        mainFlags.Calibration = 0;  //profile the normal operation, heater on
+                        if(EncDiff) ISRProfReset = 1;
+                        EncDiff = 0;
+                        OLEDFlags.f.ISRProf = 1;
+                        break;
+                    }
                     UINT16 Current = CalCh ? IronPars.Config[0].SensorConfig.CurrentB : IronPars.Config[0].SensorConfig.CurrentA;                                        
+                    UINT16 OldCurrent = Current;
                     if(EncDiff > 0 && Current < 256) Current++;
                     if(EncDiff < 0 && Current > 0) Current--;
                     EncDiff = 0;                    
@@ -307,6 +339,7 @@ void OLEDTasks(int powerLost){
                     else{
                         IronPars.Config[0].SensorConfig.CurrentA = Current;                            
                     }
+                    if(Current != OldCurrent) IronLUTUpdate();  //PTC resistance depends on the sensor current
                     OLEDFlags.f.Cal = 1;
                     mainFlags.Calibration = 1;
                     break;
@@ -322,8 +355,7 @@ void OLEDTasks(int powerLost){
                     if(!BTicks[1].o && BTicks[1].n){
                         ModeTicks = 250;
                         EncDiff = 0;
-                        pars.Input++;
-                        if(pars.Input>ParDef[15].Max) pars.Input = 0;
+                        ParsSet(15, (pars.Input < ParDef[15].Max) ? pars.Input + 1 : 0);
                     }
                     OLEDFlags.f.Input = 1;
                     break;
@@ -351,6 +383,34 @@ void OLEDTasks(int powerLost){
                     }
                     OLEDFlags.f.Version = 1;
                     break;
+                case AUTO_TUNE: //PID auto-tune at the set temperature, a key press stops it
+                    ModeTicks = 250;
+                    if(BTicks[1].o && !BTicks[1].n){
+                        PIDTuneStop();
+                        CMode = DEFAULT_MENU;
+                        break;
+                    }
+                    OLEDFlags.f.Header = 1;
+                    OLEDFlags.f.Footer = 1;
+                    OLEDFlags.f.Message = 1;
+                    OLEDMsg1 = "      AUTO-TUNE";
+                    switch(PIDTuneState()){
+                        case PID_TUNE_SETTLE:
+                            OLEDMsg2 = "     HEATING UP";
+                            break;
+                        case PID_TUNE_RELAY:
+                        case PID_TUNE_MEASURED:
+                        case PID_TUNE_DONE:
+                            OLEDMsg2 = "     MEASURING";
+                            break;
+                        case PID_TUNE_SAVED:
+                            OLEDMsg2 = "       SAVED";
+                            break;
+                        default:
+                            OLEDMsg2 = "       FAILED";
+                            break;
+                    }
+                    break;
                 case STANDBY: //stand-by
                     if(((pars.WakeUp & 1) && BTicks[1].o <= 50 && BTicks[1].n > 50) ||
                        ((pars.WakeUp & 2) && mainFlags.HolderPresent && FNAP && OldNAP != FNAP)){ //exit from stand-by
@@ -402,7 +462,7 @@ void OLEDTasks(int powerLost){
     if(OLEDFlags.f.Footer){
         UINT8 b;
         int i, p, df, 
-            AVG = ADCAVG;
+            AVG = PIDAVG();
 
         OLEDPrint68(0, 7, mainFlags.ACPower ? "AC" : "DC", 2);
         OLEDPrint68(12, 7, &("FHQE")[PIDVars[0].Power], 1);// PIDVars[0].Power ? (PIDVars[0].Power == 1 ? "H": "Q"): "F", 1);
@@ -412,7 +472,6 @@ void OLEDTasks(int powerLost){
             p = 0;
         }
         else{
-            if(dual) AVG--;
             df = PV1->PIDDutyFull; 
             p = ((PV1->PIDDuty + 0x7FL) >> 8) * (PV1->HPAvg >> AVG);
             if(dual){
@@ -547,10 +606,37 @@ void OLEDTasks(int powerLost){
         OLEDPrintNum68(56, 7, 9, MAINS_PER_US);
     }
     
-    if(OLEDFlags.f.Debug){        
-        int AVG = ADCAVG;
-        if(IronPars.Config[1].SensorConfig.Type) AVG--;
+    if(OLEDFlags.f.ISRProf){
+        //steps 0-5, 6-10 + PID task and the dual scan PID task alternate every 2 seconds, times in us, the budget of steps which
+        //overran it is inverted
+        int i, n = ((LISRTicks % 600) / 200) * 6;
+        OLEDPrint68(0, 0, "ISR PROFILE", 0);
+        OLEDPrint68(72, 0, mainFlags.ACPower ? "AC" : "DC", 2);
+        OLEDPrintNum68(90, 0, 5, MAINS_PER_US);
+        OLEDPrint68(0, 1, "S  MIN  AVG  MAX BUDG", 0);
+        for(i = 2; i < 8 && n < ISR_PROF_N; i++, n++){
+            volatile ISRProfS * P = &ISRProf[n];
+            UINT32 cnt = P->Cnt;
+            if(n == ISR_PROF_PID){
+                OLEDPrint68(0, i, "P", 1);
+            }
+            else if(n == ISR_PROF_SCAN){
+                OLEDPrint68(0, i, "S", 1);
+            }
+            else{
+                OLEDPrintNum68(0, i, 2, n);
+            }
+            if(cnt){
+                OLEDPrintNum68(12, i, 4, P->Min / (CORETIMER_FREQ / 1000000));
+                OLEDPrintNum68(42, i, 4, (P->Sum / cnt) / (CORETIMER_FREQ / 1000000));
+                OLEDPrintNum68(72, i, 4, P->Max / (CORETIMER_FREQ / 1000000));
+            }
+            if(P->Budget) OLEDPrintNum68(102, i, 4, P->Budget);
+            if(P->Over) OLEDInvert(102, 24, i, 1);
+        }
+    }
 
+    if(OLEDFlags.f.Debug){        
         OLEDPrint68(0,0,"INSTRUMENT INFO", 0);
         
         OLEDPrint68(0, 2, "    ID:", 0);
@@ -728,7 +814,7 @@ void MenuTasks(int powerLost){
                         }
                     }
                     
-                    if(userInput || (((pars.Holder == 1) || ((pars.Holder == 2) && mainFlags.HolderPresent)) && (FNAP || CMode == TIP_CHANGE))){
+                    if(userInput || CMode == AUTO_TUNE || (((pars.Holder == 1) || ((pars.Holder == 2) && mainFlags.HolderPresent)) && (FNAP || CMode == TIP_CHANGE))){
                         CTicks = 0;
                         CSeconds = 0;
                         CMSeconds = 0;
@@ -24,11 +24,16 @@ typedef enum{
     SET_INPUT_TYPE,       /*input selection*/
     TIP_CHANGE,           /*tip change*/
     VERSION_INFO,         /*version information*/
+    AUTO_TUNE,            /*PID auto-tune*/
     STANDBY = 0xFF        /*standby*/
 }T_MENU_MODE;
 
 extern void MenuInit();
 extern void MenuTasks(int powerLost);
+extern void OLEDTasks(int powerLost);
+#ifdef HOST_BUILD
+extern void MenuSetMode(T_MENU_MODE mode, int dispTemp);
+#endif
 
 #ifdef	__cplusplus
 }
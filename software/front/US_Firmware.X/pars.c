@@ -18,7 +18,7 @@ const char * StrButtons[]   = {"+/- ", "-/+ "};
 const char * StrOffOnAuto[] = {"OFF ", "ON  ", "AUTO"};
 const char * StrMenuUp[]    = {"KEY+", "KEY-"};
 
-const unsigned char MenuOrder[] = {18,0,1,2,3,4,5,6,7,11,13,8,10,14,9,12,16,17,19};
+const unsigned char MenuOrder[] = {18,0,1,2,3,4,5,6,7,11,13,8,10,14,9,12,16,20,17,19};
 
 const t_ParDef ParDef[] = {
 //  NAME            DEF  MIN      MAX      IMMEDIATE SUFFIX STRINGS       DISPFUNC    
@@ -43,6 +43,7 @@ const t_ParDef ParDef[] = {
     {" INST.INFO ",   0,       0,       0, 0,            0, 0,            0}, //17
     {" TEMP.STEP ",   1,       1,      25, 0,            0, 0,            &ParDispTemp}, //18
     {"   VERSION ",   0,       0,       0, 0,            0, 0,            0}, //19
+    {" AUTO-TUNE ",   0,       0,       0, 0,            0, 0,            0}, //20
 };
 
 void ParDispStr(int par, int col, int row, int num){
@@ -78,54 +79,150 @@ void ParDispTemp(int par, int col, int row, int temp){
     ParDispCF(par, col + 24, row, pars.Deg);
 }
 
+//EEPROM contents as last read or written, ParsWriteBack writes the differences without reading the EEPROM
+static pars_t EEPPars;
+static UINT8 EEPRing[64];           //TTemp wear levelling ring at 64, the current TTemp follows the 0xFF mark
+static int EEPRingPos;              //ring index of the current TTemp, 64 if there is none
+static t_EEPReq ParsReq;
+static t_EEPReq RingReq[2];
+
+//Journal record armed with the current parameters, SavePars only adds TTemp and the sum
+static t_ParsJournal ParsJnl;
+static int ParsDirty;               //a parameter changed since LoadPars
+static t_EEPReq JnlReq;
+static const UINT8 JnlClear = 0xFF;
+
+static UINT8 ParsJournalSum(t_ParsJournal * J){
+    UINT8 * b = (UINT8 *)J;
+    UINT8 s = 0;
+    int i;
+    for(i = sizeof(t_ParsJournal) - 1; i--;) s += b[i];
+    return -s;
+}
+
+static int ParsValid(pars_t * P){
+    int i;
+    for(i = 0; i < sizeof(P->b); i++){
+        if((P->b[i] < ParDef[i].Min) || (P->b[i] > ParDef[i].Max)) return 0;
+    }
+    return 1;
+}
+
+//Queue the writes of the parameters and TTemp that differ from the EEPROM
+static void ParsWriteBack(void)
+{
+    int i, lo, hi;
+
+    lo = sizeof(pars.b);
+    hi = 0;
+    for(i = 0; i < sizeof(pars.b); i++){
+        if(EEPPars.b[i] != pars.b[i]){
+            if(lo > i) lo = i;
+            hi = i;
+        }
+    }
+    if(lo <= hi){
+        EEPWait(&ParsReq);
+        for(i = lo; i <= hi; i++) EEPPars.b[i] = pars.b[i];
+        ParsReq.Addr = lo;
+        ParsReq.Data = (UINT8 *)&EEPPars.b[lo];
+        ParsReq.Cnt = hi - lo + 1;
+        ParsReq.Write = 1;
+        EEPSubmit(&ParsReq);
+    }
+
+    i = EEPRingPos & 63;
+    if(EEPRing[i] != TTemp){
+        int n = (i + 1) & 63;
+        EEPWait(&RingReq[0]);
+        EEPWait(&RingReq[1]);
+        EEPRing[i] = 0xFF;
+        EEPRing[n] = TTemp;
+        RingReq[0].Addr = i + 64;
+        RingReq[0].Data = &EEPRing[i];
+        RingReq[0].Cnt = n ? 2 : 1;
+        RingReq[0].Write = 1;
+        EEPSubmit(&RingReq[0]);
+        if(!n){
+            RingReq[1].Addr = 64;
+            RingReq[1].Data = &EEPRing[0];
+            RingReq[1].Cnt = 1;
+            RingReq[1].Write = 1;
+            EEPSubmit(&RingReq[1]);
+        }
+        EEPRingPos = n;
+    }
+}
+
 void LoadPars(void)
 {
     int i;
     UINT8 b,oldb;
 
-    EEPRead(0, (UINT8 *)&pars, sizeof(pars));
-    for(i = 0; i < sizeof(pars.b); i++){
-        if((pars.b[i] < ParDef[i].Min) || (pars.b[i] > ParDef[i].Max)){
-            for(i = 0; i < sizeof(pars.b); i++){
-                pars.b[i] = ParDef[i].Default;
-            }
-            break;
+    EEPRead(0, (UINT8 *)&EEPPars, sizeof(EEPPars));
+    pars = EEPPars;
+    if(!ParsValid((pars_t *)&pars)){
+        for(i = 0; i < sizeof(pars.b); i++){
+            pars.b[i] = ParDef[i].Default;
         }
     }
 
     TTemp = 150;
-    oldb = EEPRead(64 + 63, 0, 1);
+    EEPRead(64, EEPRing, 64);
+    oldb = EEPRing[63];
     for(i = 0; i < 64; i++){
-        b = EEPRead(i + 64, 0, 1);
+        b = EEPRing[i];
         if((oldb == 0xFF) && (b >= MINTEMP) && (b <= MAXTEMP)){
             TTemp = b;
             break;
         }
         oldb = b;
     }
+    EEPRingPos = i;
+
+    EEPRead(PARS_JOURNAL_EEP, (UINT8 *)&ParsJnl, sizeof(ParsJnl));
+    if((ParsJnl.Mark == PARS_JOURNAL_MARK) && (ParsJnl.Sum == ParsJournalSum(&ParsJnl)) && ParsValid(&ParsJnl.Pars)
+        && (ParsJnl.TTemp >= MINTEMP) && (ParsJnl.TTemp <= MAXTEMP)){
+        pars = ParsJnl.Pars;
+        TTemp = ParsJnl.TTemp;
+        ParsWriteBack();
+        JnlReq.Addr = PARS_JOURNAL_EEP;     //queued after the write-back, the journal stays valid until it is done
+        JnlReq.Data = (UINT8 *)&JnlClear;
+        JnlReq.Cnt = 1;
+        JnlReq.Write = 1;
+        EEPSubmit(&JnlReq);
+    }
+    ParsJnl.Mark = PARS_JOURNAL_MARK;
+    ParsJnl.Pars = pars;
+    ParsJnl.TTemp = TTemp;
+    ParsDirty = 0;
 }
 
-void SavePars(void)
+//Set parameter p, the journal is kept armed with the new value
+void ParsSet(int p, UINT8 v)
 {
-    int i;
-    UINT8 b, oldb;
-
-    for(i = 0; i < sizeof(pars.b); i++){
-        if(EEPRead(i, 0 ,1) != pars.b[i]) EEPWriteImm(i, pars.b[i]);
-    }
-    
-    oldb = EEPRead(64 + 63, 0, 1);
-    for(i = 0; i < 64; i++){
-        b = EEPRead(64 + i, 0, 1);
-        if((oldb == 0xFF) && (b >= MINTEMP) && (b <= MAXTEMP)) break;
-        oldb = b;
+    pars.b[p] = v;
+    if(ParsJnl.Pars.b[p] != v){
+        ParsJnl.Pars.b[p] = v;
+        ParsDirty = 1;
     }
-    i &= 63;
-    b = EEPRead(64 + i, 0, 1);
-    if(b != TTemp){
-        EEPWriteImm(i + 64, 0xFF);
-        EEPWriteImm(((i + 1) & 63) + 64, TTemp);
+}
+
+//Power-loss save: one page write of the journal when a parameter or TTemp has changed, returns before it is done (EEPBusy)
+void SavePars(void)
+{
+    if(ParsJnl.TTemp != TTemp){
+        ParsJnl.TTemp = TTemp;
+        ParsDirty = 1;
     }
+    if(!ParsDirty) return;
+    ParsDirty = 0;
+    ParsJnl.Sum = ParsJournalSum(&ParsJnl);
+    JnlReq.Addr = PARS_JOURNAL_EEP;
+    JnlReq.Data = (UINT8 *)&ParsJnl;
+    JnlReq.Cnt = sizeof(ParsJnl);
+    JnlReq.Write = 1;
+    EEPSubmit(&JnlReq);
 }
 
 #undef _PARS_C
@@ -48,13 +48,26 @@ typedef struct {
     void (*OLEDDispFunc)(int, int, int, int);
 }t_ParDef;
 
+//Power-loss journal: SavePars writes the parameters and TTemp as one page, LoadPars takes them from there when the
+//record is valid, writes them back to the parameter block and the TTemp ring and clears the mark
+#define PARS_JOURNAL_EEP    32      //EEPROM page
+#define PARS_JOURNAL_MARK   0x5A
+
+typedef struct __PACKED {
+    UINT8 Mark;                     //PARS_JOURNAL_MARK, 0xFF when written back
+    pars_t Pars;
+    UINT8 TTemp;
+    UINT8 Sum;                      //the bytes up to and including Sum add up to 0
+}t_ParsJournal;
+
 #define NB_OF_MENU_PARAMS  (sizeof(MenuOrder) / sizeof(MenuOrder[0])
 
 #ifndef _PARS_C
-extern const char MenuOrder[19];
-extern const t_ParDef ParDef[20];
+extern const char MenuOrder[20];
+extern const t_ParDef ParDef[21];
 extern void LoadPars(void);
 extern void SavePars();
+extern void ParsSet(int p, UINT8 v);
 #endif
 
 #ifdef	__cplusplus
@@ -1,27 +1,45 @@
 #define _SENSORMATH_C
 #include <stdlib.h>
+#include <string.h>
 #include "sensorMath.h"
 #include "iron.h"
 #include "PID.h"
 #include "main.h"
 
-INT32 GetSensorTemperature(int input, t_SensorConfig * SC){
-    INT32 dw = input + SC->Offset;
-    if(dw < 0)dw = 0;
-    if(dw > 2047)dw = 2047;
+//a += b, signed
+static void SExtFloatAdd(SExtFloat * a, SExtFloat b){
+    UINT32 m;
+    int d;
+    if(!b.m) return;
+    if(!a->m || a->e < b.e || (a->e == b.e && a->m < b.m)){
+        //keep the larger magnitude in a
+        SExtFloat t = *a;
+        *a = b;
+        b = t;
+        if(!b.m) return;
+    }
+    d = a->e - b.e;
+    m = (d < 32) ? (b.m >> d) : 0;
+    if(a->s == b.s){
+        if((a->m += m) < m){
+            //carry
+            a->m = (a->m >> 1) | 0x80000000UL;
+            a->e++;
+        }
+    }
+    else{
+        a->m -= m;
+        ExtFloatNorm((*a));
+    }
+}
 
+//Polynomial temperature for the sensor input dw (ADC + Offset), multiplied by 2^frac, without cold junction compensation
+static INT32 SensorPolynomial(INT32 dw, t_SensorConfig * SC, int frac){
 ///******* INPUT MILLIVOLTS CALCULATION ***********************************************/
     //ADC = Vin * 750 * (IC->Gain / 256) * (1024 / 3000mV)
     //mV = (256 * 3000 * ADC) / (750 * 1024 * IC->Gain)) = ADC / IC->Gain
-    ExtFloat x1 = {((UINT32)dw)<<20, 0};
-    //if((x1.m = ((UINT32)dw) << 20)){
-    if(x1.m){
-        x1.e = 138;
-        while (x1.m < 0x80000000){
-            x1.m <<=1;
-            x1.e--;
-        }
-    }
+    ExtFloat x1 = {((UINT32)dw)<<20, 138};
+    ExtFloatNorm(x1);
     ExtFloatDivByUInt(x1, SC->Gain);
 
 ///******* Resistance calculation if resistive sensor *********************************/
@@ -49,108 +67,255 @@ INT32 GetSensorTemperature(int input, t_SensorConfig * SC){
 // >>> At this point in x1 we have millivolts if thermocouple sensor, or ohms if PTC/NTC sensor. <<<
 
 /******* TEMPERATURE POLYNOMIAL CALCULATION *****************************************************/
-    //T = C0 + C1 * X + c2 * X^2 + C3 * X^3 + ... + C9 * X^9
+    //T = C0 + X * (C1 + X * (C2 + ... + X * C9)), Horner scheme with signed ExtFloat
     {
-        ExtFloat PSum = {0, 0};
-        ExtFloat NSum = {0, 0};
-
-        {
-            int n; //current polynomial power
-            ExtFloat xn = x1;
-            SFLOAT cp;
-
-            cp.f = SC->TPoly[0];
-            //Load positive or negative sum with the first polynomial coefficient depending on it's sign
-            float2ExtFloat(PSum, cp.f);
-            if(cp.s){
-                NSum = PSum;
-                PSum.m = 0;
-                PSum.e = 0;
-            }
-
-            for(n = 1; n < 10; n++){
-                ExtFloat CSum, cn;
-                cp.f = SC->TPoly[n];
-
-                float2ExtFloat(cn, cp.f);
-
-                //get positive or negative sum depending on current coefficient sign
-                if(cp.s){
-                    CSum = NSum;
-                }
-                else{
-                    CSum = PSum;
-                }
-
-                ExtFloatMul(cn, xn);
-
-                ExtFloatAdd(CSum, cn);
-
-                //store in positive or negative sum depending on current coefficient
-                if(cp.s){
-                    NSum = CSum;
-                }
-                else{
-                    PSum = CSum;
-                }
-
-                //don't calculate next argument power if the end is reached
-                if(n >= 9) break;
-
-                //calculate next polynomial argument power
-                ExtFloatMul(xn, x1);
-            }
+        SExtFloat T, cn;
+        SFLOAT cp;
+        int n, s;
+
+        //skip zero high order coefficients, most of the instruments use C0 and C1 only
+        for(n = 9; n > 0; n--){
+            cp.f = SC->TPoly[n];
+            if(cp.e) break;
         }
+        cp.f = SC->TPoly[n];
+        float2ExtFloat(T, cp.f);
+        T.s = cp.s;
 
-        //calculate (PSum - NSum) * 2 in order to get integer temperature * 2
-        if(PSum.e > NSum.e || (PSum.e == NSum.e && PSum.m >= NSum.m)){
-            //positive result
-            int s = PSum.e - NSum.e;
-            if(s >= 32){
-                NSum.m = 0;
-            }
-            else if(s){
-                NSum.m >>= s;
-            }
-            PSum.m -= NSum.m;
-            s = -((PSum.e - 125) - 32);
-            if(s <= 0){
-                dw = 0x7FFFFFFF;
-            }
-            else{
-                dw = PSum.m >> s;
-            }
+        while(n--){
+            ExtFloatMul(T, x1);
+            cp.f = SC->TPoly[n];
+            float2ExtFloat(cn, cp.f);
+            cn.s = cp.s;
+            SExtFloatAdd(&T, cn);
+        }
+
+        //T * 2^frac to integer
+        s = -((T.e - 126 + frac) - 32);
+        if(!T.m || s >= 32){
+            dw = 0;
+        }
+        else if(s <= 0){
+            dw = T.s ? 0x80000000 : 0x7FFFFFFF;
         }
         else{
-            //negative result
-            int s = NSum.e - PSum.e;
-            if(s >= 32){
-                PSum.m = 0;
-            }
-            else if(s){
-                PSum.m >>= s;
-            }
-            NSum.m -= PSum.m;
-            s = -((NSum.e - 125) - 32);
-            if(s <= 0){
-                dw = 0x80000000;
-            }
-            else{
-                dw = -(INT32)(NSum.m >> s);
-            }          
+            dw = T.m >> s;
+            if(T.s) dw = -dw;
         }
     }
-    if(dw < -273*2) dw = -273*2;
-    if(dw > 2000) dw = 2000;
+    if(dw < -273*2 * (1 << (frac - 1))) dw = -273*2 * (1 << (frac - 1));
+    if(dw > (2000 << (frac - 1))) dw = 2000 << (frac - 1);
+    return dw;
+}
 
-    //Add room temperature if thermocouple
-    if(SC->Type == SENSOR_TC){
+//Add room temperature if thermocouple
+static INT32 SensorColdJunction(INT32 dw, int type){
+    if(type == SENSOR_TC){
         int temp = CRTemp;
         if(CJTemp >= -10) temp = CJTemp;
         dw += temp;
     }
-
     return dw;
- }   
+}
+
+INT32 GetSensorTemperature(int input, t_SensorConfig * SC){
+    INT32 dw = input + SC->Offset;
+    if(dw < 0)dw = 0;
+    if(dw > 2047)dw = 2047;
+    return SensorColdJunction(SensorPolynomial(dw, SC, 1), SC->Type);
+}
+
+//Tabulate the sensor polynomial every (1 << SENSOR_LUT_SHIFT) inputs, so that GetSensorTemperatureLUT
+//can replace the polynomial calculation in the control loop with a linear interpolation
+void SensorLUTBuild(t_SensorLUT * LUT, t_SensorConfig * SC){
+    int i;
+    memset(LUT, 0, sizeof(t_SensorLUT));
+    if(!SC) return;
+    LUT->Type = SC->Type;
+    LUT->Offset = SC->Offset;
+    if(SC->Type == SENSOR_UNDEFINED || SC->Type == SENSOR_NONE || !SC->Gain) return;
+    for(i = 0; i < SENSOR_LUT_SIZE; i++){
+        LUT->T[i] = SensorPolynomial(i << SENSOR_LUT_SHIFT, SC, SENSOR_LUT_FRAC);
+    }
+}
+
+INT32 GetSensorTemperatureLUT(int input, t_SensorLUT * LUT){
+    INT32 dw = input + LUT->Offset;
+    int i;
+    if(dw < 0)dw = 0;
+    if(dw > 2047)dw = 2047;
+    i = dw >> SENSOR_LUT_SHIFT;
+    dw &= (1 << SENSOR_LUT_SHIFT) - 1;
+    dw = LUT->T[i] + ((((INT32)LUT->T[i + 1] - LUT->T[i]) * dw) >> SENSOR_LUT_SHIFT);
+    //temperature * 2, rounded towards zero as in the polynomial calculation
+    dw = (dw < 0) ? -((-dw) >> (SENSOR_LUT_FRAC - 1)) : (dw >> (SENSOR_LUT_FRAC - 1));
+    return SensorColdJunction(dw, LUT->Type);
+}
+
+//round(256 * sqrt(i + 0.5)) for i = 64..255, seed for the Newton step of UIntSqrt
+static const UINT16 SqrtTab[192] = {
+    2056, 2072, 2088, 2103, 2119, 2134, 2149, 2165, 2180, 2195, 2210, 2224,
+    2239, 2254, 2268, 2283, 2297, 2311, 2325, 2339, 2353, 2367, 2381, 2395,
+    2408, 2422, 2435, 2449, 2462, 2475, 2489, 2502, 2515, 2528, 2541, 2554,
+    2566, 2579, 2592, 2604, 2617, 2629, 2642, 2654, 2667, 2679, 2691, 2703,
+    2715, 2727, 2739, 2751, 2763, 2775, 2787, 2798, 2810, 2822, 2833, 2845,
+    2856, 2868, 2879, 2891, 2902, 2913, 2924, 2936, 2947, 2958, 2969, 2980,
+    2991, 3002, 3013, 3024, 3034, 3045, 3056, 3067, 3077, 3088, 3099, 3109,
+    3120, 3130, 3141, 3151, 3161, 3172, 3182, 3192, 3203, 3213, 3223, 3233,
+    3243, 3253, 3263, 3273, 3283, 3293, 3303, 3313, 3323, 3333, 3343, 3353,
+    3362, 3372, 3382, 3391, 3401, 3411, 3420, 3430, 3439, 3449, 3458, 3468,
+    3477, 3487, 3496, 3505, 3515, 3524, 3533, 3543, 3552, 3561, 3570, 3579,
+    3589, 3598, 3607, 3616, 3625, 3634, 3643, 3652, 3661, 3670, 3679, 3688,
+    3697, 3705, 3714, 3723, 3732, 3741, 3749, 3758, 3767, 3775, 3784, 3793,
+    3801, 3810, 3819, 3827, 3836, 3844, 3853, 3861, 3870, 3878, 3887, 3895,
+    3903, 3912, 3920, 3929, 3937, 3945, 3954, 3962, 3970, 3978, 3987, 3995,
+    4003, 4011, 4019, 4027, 4036, 4044, 4052, 4060, 4068, 4076, 4084, 4092
+};
+
+//floor(sqrt(n)): seed from the top 7-8 bits of n, one Newton step and a final correction
+UINT32 UIntSqrt(UINT32 n){
+    UINT32 x;
+    int sh;
+    if(n < 64){
+        for(x = 0; (x + 1) * (x + 1) <= n; x++);
+        return x;
+    }
+    sh = (25 - __builtin_clz(n)) & ~1;  //n >> sh = 64..255
+    x = ((UINT32)SqrtTab[(n >> sh) - 64] << (sh >> 1)) >> 8;
+    x = (x + n / x) >> 1;               //never below floor(sqrt(n))
+    if(x > 0xFFFF) x = 0xFFFF;
+    while(x * x > n) x--;
+    return x;
+}
+
+void VIAccInit(t_VIAcc * A){
+    memset(A, 0, sizeof(t_VIAcc));
+}
+
+//one sample pair: current I[i] and the sum of the voltages around it, V[i] + V[i + 1]. Clipped currents are summed as they are,
+//the branch that counts them is only reached by samples at or above the highest current so far
+#define VIACC_SAMPLE(k) \
+{ \
+    ci = VIACC_I(w0); \
+    w0 = VI[(i + (k) + 1) & VIACC_RING_MASK]; \
+    v1 = VIACC_V(w0); \
+    cv = v0 + v1; \
+    cv2 = cv * cv; \
+    sv += cv2; \
+    si += ci * ci; \
+    sp += ci * cv; \
+    if(ci >= ri){ \
+        if(ci >= 1023){ \
+            svc += cv2; \
+            sc += cv; \
+            nc++; \
+        } \
+        else if(v0 < 1023 && v1 < 1023){ \
+            ri = ci; \
+            rv = cv; \
+        } \
+    } \
+    v0 = v1; \
+}
+
+//Add the ring sample pairs from A->Pos up to ring index e, the next pair the DMA writes. Has to be called before the DMA
+//gets a whole ring ahead of A->Pos, that is at every ring half. The pairs below e are not written again until then, so VI
+//is read as a plain snapshot, not through volatile
+void VIAccAdd(t_VIAcc * A, const UINT32 * VI, UINT32 e){
+    UINT32 i = A->Pos, sv = A->SV, si = A->SI, sp = A->SP, svc = A->SVC, sc = A->SC, nc = A->NC, ri = A->RI, rv = A->RV;
+    UINT32 ci, cv, cv2, v0, v1, w0, n;
+    n = (e - i) & VIACC_RING_MASK;
+    if(n < 2) return;
+    n--;                                //the last voltage sample waits for the next one
+    A->Cnt += n;
+    w0 = VI[i];
+    v0 = VIACC_V(w0);
+    for(; n >= 8; n -= 8){
+        VIACC_SAMPLE(0);
+        VIACC_SAMPLE(1);
+        VIACC_SAMPLE(2);
+        VIACC_SAMPLE(3);
+        VIACC_SAMPLE(4);
+        VIACC_SAMPLE(5);
+        VIACC_SAMPLE(6);
+        VIACC_SAMPLE(7);
+        i = (i + 8) & VIACC_RING_MASK;
+    }
+    for(; n; n--){
+        VIACC_SAMPLE(0);
+        i = (i + 1) & VIACC_RING_MASK;
+    }
+    A->Pos = i;
+    A->SV = sv;
+    A->SI = si;
+    A->SP = sp;
+    A->SVC = svc;
+    A->SC = sc;
+    A->NC = nc;
+    A->RI = ri;
+    A->RV = rv;
+}
+
+#undef VIACC_SAMPLE
+
+void VICapInit(t_VICap * C, UINT32 * buf, UINT32 size){
+    memset(C, 0, sizeof(t_VICap));
+    C->Buf = buf;
+    C->Size = size;
+}
+
+//Header of a new half period, the sampling starts at the ring start. Returns 0 if there is no room for a sample pair
+int VICapStart(t_VICap * C, const t_VICapHdr * H){
+    if(C->Len + VICAP_HDR_WORDS >= C->Size) return 0;
+    C->Hdr = C->Len;
+    memcpy(&C->Buf[C->Len], H, sizeof(t_VICapHdr));
+    ((t_VICapHdr *)&C->Buf[C->Hdr])->Cnt = 0;
+    C->Len += VICAP_HDR_WORDS;
+    C->Pos = 0;
+    return 1;
+}
+
+//Copy the sample pairs of the ring up to index e (exclusive) after the last header
+void VICapAdd(t_VICap * C, const UINT32 * VI, UINT32 e){
+    UINT32 i = C->Pos, n = (e - i) & VIACC_RING_MASK, m = C->Size - C->Len;
+    if(n > m){
+        C->Lost += n - m;
+        n = m;
+    }
+    ((t_VICapHdr *)&C->Buf[C->Hdr])->Cnt += n;
+    for(; n; n--, i = (i + 1) & VIACC_RING_MASK) C->Buf[C->Len++] = VI[i];
+    C->Pos = e;
+}
+
+//Heater voltage, current, power and resistance of the accumulated samples, duty = heated part of the half period * 1024
+void VIAccFinish(t_VIAcc * A, UINT32 duty){
+    UINT32 l = A->Cnt, sv, si = A->SI, sp = A->SP, f;
+    UINT64 t;
+    // 6738 = 10 * 256 * (((Rs1 * (R48 / R42)) / VRef) * 1024) / (((R51 / (R47 + R51)) / VRef) * 1024)
+    //      = 10 * 256 * (((0.003 * (47K / 1.5K)) / 3.0V) *1024) / (((1K / (27K + 1K)) / 3.0V) * 1024)
+    //      = 6737.92
+    A->HR = A->RI ? (((A->RV * 6738) / A->RI) + 256) >> 9 : 0x7FFF;
+    if(!l){
+        A->HV = A->HI = A->HP = 0;
+        return;
+    }
+    if(A->NC && A->RI && A->RV){
+        //replace the clipped currents with voltage * RI / RV = voltage * f / 65536, from the heater resistance without rounding it
+        f = (A->RI << 16) / A->RV;
+        t = ((UINT64)A->SVC * f) >> 16;
+        sp += t - A->SC * 1023;
+        si += ((t * f) >> 16) - A->NC * (1023UL * 1023UL);
+    }
+    sv = (A->SV + (l >> 1)) / l;
+    si = (si + (l >> 1)) / l;
+    l *= (UINT32)(391 * 2);
+    sp = (sp + (l >> 1)) / l;
+    // 391 = (((R51 / (R47 + R51)) / VRef) * 1024) * (((Rs1 * (R48 / R42)) / VRef) * 1024)
+    //     = (((1K / (27K + 1K)) / 3.0V) * 1024) * (((0.003 * (47K / 1.5K)) /3.0V) * 1024)
+    //     = 391,13549206349206349206349206349
+    A->HV = (UIntSqrt(sv * duty) + 31) >> 6;
+    A->HI = (UIntSqrt(si * duty) + 15) >> 5;
+    A->HP = ((sp * duty) + 511) >> 10;
+}
 
 #define _SENSORMATH_C
@@ -33,6 +33,24 @@ typedef struct {
     INT32 e;
 }ExtFloat;
 
+typedef struct {
+    UINT32 m;
+    INT32 e;
+    INT32 s;    //sign (1 = negative)
+}SExtFloat;
+
+#define ExtFloatNorm(ef) \
+{ \
+    if(ef.m){ \
+        int _n = __builtin_clz(ef.m); \
+        ef.m <<= _n; \
+        ef.e -= _n; \
+    } \
+    else { \
+        ef.e = 0; \
+    } \
+}
+
 #define float2ExtFloat(ef, f) \
 { \
     ef.m = ( ((UINT32)((SFLOAT)f).m) & 0x7FFFFFUL) << 8; \
@@ -104,13 +122,85 @@ typedef struct {
     } \
 }
 
+//Piecewise linear sensor input to temperature table, built from the polynomial when an instrument is identified
+#define SENSOR_LUT_SHIFT    4                                   //input step between table points = 16
+#define SENSOR_LUT_SIZE     ((2048 >> SENSOR_LUT_SHIFT) + 1)
+#define SENSOR_LUT_FRAC     4                                   //table temperature = degrees * 16
+#define SENSOR_LUT_CJ       2                                   //SensorLUT index of the cold junction sensor
+
+typedef struct {
+    UINT8   Type;                   //sensor type, SENSOR_UNDEFINED if there is no table
+    UINT16  Offset;                 //offset to add to the ADC reading
+    INT16   T[SENSOR_LUT_SIZE];     //temperature * 16 at input (i << SENSOR_LUT_SHIFT)
+} t_SensorLUT;
+
+//Heater voltage and current accumulator for the samples of a heated half period. The DMA writes them into the VIRing
+//ring of sample pairs and signals every completed ring half, the sums are built from there while sampling continues
+#define VIACC_RING_HALF 16                          //sample pairs per ring half
+#define VIACC_RING      (VIACC_RING_HALF * 2)
+#define VIACC_RING_MASK (VIACC_RING - 1)
+#define VIACC_V(p)      ((p) & 0xFFFF)              //voltage of a sample pair, converted first
+#define VIACC_I(p)      ((p) >> 16)                 //current (or cold junction) of a sample pair
+
+typedef struct {
+    UINT32 Pos;         //ring index of the next sample pair to add
+    UINT32 Cnt;         //number of sample pairs added
+    UINT32 SV;          //sum of voltage^2
+    UINT32 SI;          //sum of current^2
+    UINT32 SP;          //sum of voltage * current
+    UINT32 SVC;         //sum of voltage^2 of the clipped current samples
+    UINT32 SC;          //sum of voltage of the clipped current samples
+    UINT32 NC;          //number of clipped current samples
+    UINT32 RI;          //highest unclipped current with unclipped voltage, for heater resistance
+    UINT32 RV;          //voltage of the RI sample
+    int HV;             //results of VIAccFinish, same units as t_PIDVars
+    int HI;
+    int HP;
+    int HR;
+} t_VIAcc;
+
+//Raw capture of the VI ring into a buffer of words: each half period is a t_VICapHdr followed by its Cnt sample pairs
+//(VIACC_V and VIACC_I of every word), copied at every completed ring half like the accumulator
+typedef struct {
+    UINT16 Ticks;       //ISRTicks
+    UINT16 Cnt;         //sample pairs after the header
+    UINT16 VTemp;       //temperature ADC reading of the half period
+    UINT16 OffDelay;    //t_PIDVars.OffDelay (us * 16)
+    UINT8 Heater;       //1 if the samples are heater voltage and current, 0 for voltage and cold junction
+    UINT8 Ch;           //PIDVars index
+    UINT8 Power;        //t_PIDVars.Power
+    UINT8 ADCStep;
+} t_VICapHdr;
+
+#define VICAP_HDR_WORDS (sizeof(t_VICapHdr) / sizeof(UINT32))
+
+typedef struct {
+    UINT32 * Buf;
+    UINT32 Size;        //words of Buf
+    UINT32 Len;         //words written
+    UINT32 Hdr;         //word of the header of the half period being captured
+    UINT32 Pos;         //ring index of the next sample pair to copy
+    UINT32 Lost;        //sample pairs which did not fit
+} t_VICap;
+
 #ifndef _SENSORMATH_C
 #define SENSORMATH_H_EXTERN extern
 #else
 #define SENSORMATH_H_EXTERN
 #endif
 
+SENSORMATH_H_EXTERN t_SensorLUT SensorLUT[3];   //heater channel 0, heater channel 1, cold junction
+
 INT32 GetSensorTemperature(int input, t_SensorConfig * SC);
+INT32 GetSensorTemperatureLUT(int input, t_SensorLUT * LUT);
+void SensorLUTBuild(t_SensorLUT * LUT, t_SensorConfig * SC);
+UINT32 UIntSqrt(UINT32 n);
+void VIAccInit(t_VIAcc * A);
+void VIAccAdd(t_VIAcc * A, const UINT32 * VI, UINT32 e);
+void VIAccFinish(t_VIAcc * A, UINT32 duty);
+void VICapInit(t_VICap * C, UINT32 * buf, UINT32 size);
+int VICapStart(t_VICap * C, const t_VICapHdr * H);
+void VICapAdd(t_VICap * C, const UINT32 * VI, UINT32 e);
 
 #undef SENSORMATH_H_EXTERN
 
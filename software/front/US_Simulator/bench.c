@@ -0,0 +1,679 @@
+/*
+ * File:   bench.c
+ *
+ * Host benchmarks of the control core. Timings are host CPU cycles (time stamp counter on x86,
+ * nanoseconds elsewhere), useful to compare implementations, not as PIC32 figures.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "mcu.h"
+#include "isr.h"
+#include "main.h"
+#include "pars.h"
+#include "EEP.h"
+#include "iron.h"
+#include "PID.h"
+#include "sensorMath.h"
+#include "plant.h"
+#include "sim.h"
+#include "check.h"
+#include "bench.h"
+#include "OLED.h"
+#include "menu.h"
+
+extern const t_IronPars Irons[];
+extern const int IronsNum;
+
+static UINT64 BenchClock(){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (UINT64)t.tv_sec * 1000000000ULL + t.tv_nsec;
+#endif
+}
+
+static const char * BenchUnit(){
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+/**** Previous GetSensorTemperature polynomial: separate positive and negative sums, explicit powers of x ****/
+static INT32 SumsPolynomial(INT32 dw, t_SensorConfig * SC, int frac){
+    ExtFloat x1 = {((UINT32)dw)<<20, 0};
+    if(x1.m){
+        x1.e = 138;
+        while (x1.m < 0x80000000){
+            x1.m <<=1;
+            x1.e--;
+        }
+    }
+    ExtFloatDivByUInt(x1, SC->Gain);
+    if(SC->Type == SENSOR_PTC){
+        const ExtFloat rcc = {
+            0xA72F0539,   //1.6*256/1.225 32 bit mantissa
+            127+8        //1.6*256/1.225 exponent
+        };
+        ExtFloatMul(x1, rcc);
+        UINT32 current;
+        int cBand;
+        if(SC->InputInv){
+            current = SC->CurrentA;
+            cBand = SC->CBandA;
+        }
+        else{
+            current = SC->CurrentB;
+            cBand = SC->CBandB;                
+        }
+        if(!cBand) x1.e -=4;       //divide by 16 if higher current band on channel A
+        if(current == 0) current = 1;
+        ExtFloatDivByUInt(x1, current);
+    }
+// >>> At this point in x1 we have millivolts if thermocouple sensor, or ohms if PTC/NTC sensor. <<<
+
+/******* TEMPERATURE POLYNOMIAL CALCULATION *****************************************************/
+    //T = C0 + C1 * X + c2 * X^2 + C3 * X^3 + ... + C9 * X^9
+    {
+        ExtFloat PSum = {0, 0};
+        ExtFloat NSum = {0, 0};
+
+        {
+            int n; //current polynomial power
+            ExtFloat xn = x1;
+            SFLOAT cp;
+
+            cp.f = SC->TPoly[0];
+            //Load positive or negative sum with the first polynomial coefficient depending on it's sign
+            float2ExtFloat(PSum, cp.f);
+            if(cp.s){
+                NSum = PSum;
+                PSum.m = 0;
+                PSum.e = 0;
+            }
+
+            for(n = 1; n < 10; n++){
+                ExtFloat CSum, cn;
+                cp.f = SC->TPoly[n];
+
+                float2ExtFloat(cn, cp.f);
+
+                //get positive or negative sum depending on current coefficient sign
+                if(cp.s){
+                    CSum = NSum;
+                }
+                else{
+                    CSum = PSum;
+                }
+
+                ExtFloatMul(cn, xn);
+
+                ExtFloatAdd(CSum, cn);
+
+                //store in positive or negative sum depending on current coefficient
+                if(cp.s){
+                    NSum = CSum;
+                }
+                else{
+                    PSum = CSum;
+                }
+
+                //don't calculate next argument power if the end is reached
+                if(n >= 9) break;
+
+                //calculate next polynomial argument power
+                ExtFloatMul(xn, x1);
+            }
+        }
+
+        //calculate (PSum - NSum) * 2^frac in order to get integer temperature * 2^frac
+        if(PSum.e > NSum.e || (PSum.e == NSum.e && PSum.m >= NSum.m)){
+            //positive result
+            int s = PSum.e - NSum.e;
+            if(s >= 32){
+                NSum.m = 0;
+            }
+            else if(s){
+                NSum.m >>= s;
+            }
+            PSum.m -= NSum.m;
+            s = -((PSum.e - 126 + frac) - 32);
+            if(s <= 0){
+                dw = 0x7FFFFFFF;
+            }
+            else if(s >= 32){
+                dw = 0;
+            }
+            else{
+                dw = PSum.m >> s;
+            }
+        }
+        else{
+            //negative result
+            int s = NSum.e - PSum.e;
+            if(s >= 32){
+                PSum.m = 0;
+            }
+            else if(s){
+                PSum.m >>= s;
+            }
+            NSum.m -= PSum.m;
+            s = -((NSum.e - 126 + frac) - 32);
+            if(s <= 0){
+                dw = 0x80000000;
+            }
+            else if(s >= 32){
+                dw = 0;
+            }
+            else{
+                dw = -(INT32)(NSum.m >> s);
+            }          
+        }
+    }
+    if(dw < ((-273*2) << (frac - 1))) dw = (-273*2) << (frac - 1);
+    if(dw > (2000 << (frac - 1))) dw = 2000 << (frac - 1);
+    return dw;
+}
+
+static INT32 SumsSensorTemperature(int input, t_SensorConfig * SC){
+    INT32 dw = input + SC->Offset;
+    if(dw < 0)dw = 0;
+    if(dw > 2047)dw = 2047;
+    return SumsPolynomial(dw, SC, 1);
+}
+/************************************************************************************************************/
+
+#define BENCH_PASSES 32
+
+static volatile INT32 BenchSink;
+
+//Time one conversion function over the whole input range of a sensor, returns clock ticks per call
+static double BenchConversion(INT32 (*f)(int, t_SensorConfig *), t_SensorConfig * SC){
+    UINT64 t, best = ~0ULL;
+    int p, i;
+    for(p = BENCH_PASSES; p--;){
+        INT32 sum = 0;
+        t = BenchClock();
+        for(i = 0; i < 2048; i++) sum += f(i - SC->Offset, SC);
+        t = BenchClock() - t;
+        BenchSink = sum;
+        if(t < best) best = t;
+    }
+    return (double)best / 2048;
+}
+
+static int BenchTerms(t_SensorConfig * SC){
+    int n;
+    for(n = 9; n > 0 && SC->TPoly[n] == 0; n--);
+    return n + 1;
+}
+
+void BenchSensorTemperature(){
+    int i, ch, in, d, maxd = 0;
+    double to, tn, so = 0, sn = 0;
+    int cnt = 0;
+
+    //thermocouple output without cold junction compensation
+    CJTemp = -273*2;
+    CRTemp = 0;
+    printf("GetSensorTemperature, %s per call over the 0-2047 input range\n", BenchUnit());
+    printf("%-24s %-4s %5s %10s %10s %7s %9s\n", "instrument", "", "terms", "two sums", "Horner", "speedup", "max diff");
+    for(i = 0; i < IronsNum; i++){
+        for(ch = 0; ch < 3; ch++){
+            t_SensorConfig * SC = (ch < 2) ? (t_SensorConfig *)&Irons[i].Config[ch].SensorConfig : (t_SensorConfig *)Irons[i].ColdJunctionSensorConfig;
+            if(!SC || SC->Type == SENSOR_UNDEFINED || SC->Type == SENSOR_NONE) continue;
+            to = BenchConversion(SumsSensorTemperature, SC);
+            tn = BenchConversion(GetSensorTemperature, SC);
+            //both return degrees * 2, rounded towards zero
+            d = 0;
+            for(in = 0; in < 2048; in++){
+                int dd = abs(GetSensorTemperature(in - SC->Offset, SC) - SumsSensorTemperature(in - SC->Offset, SC));
+                if(dd > d) d = dd;
+            }
+            if(d > maxd) maxd = d;
+            printf("%-24.24s %-4s %5d %10.1f %10.1f %6.2fx %7d/2C\n", (const char *)Irons[i].Name, (ch == 2) ? "cj" : (ch ? "ch1" : "ch0"),
+                BenchTerms(SC), to, tn, to / tn, d);
+            so += to;
+            sn += tn;
+            cnt++;
+        }
+    }
+    if(cnt) printf("average %.1f -> %.1f %s per call (%.2fx), max difference %d/2C\n", so / cnt, sn / cnt, BenchUnit(), so / sn, maxd);
+}
+
+#define BENCH_STEP5_TIME 20.0
+
+//Closed loop at 350C: ISR step 5 with the PID deferred to the PID interrupt, against the PID run inside the ISR as before.
+//The PID run time is what the ISR no longer spends at IPL7 before step 6.
+void BenchISRStep5(){
+    static t_Plant PL;
+    int i, cnt = 0;
+    double t, ia, pa, sia = 0, spa = 0;
+
+    printf("ISR step 5 at 350C, %s per PID run, %.0f s closed loop\n", BenchUnit(), BENCH_STEP5_TIME);
+    printf("%-24s %10s %10s %10s\n", "instrument", "before", "ISR", "PID task");
+    for(i = 0; i < IronsNum; i++){
+        PlantInit(&PL, &Irons[i], 24, 25, 1);
+        if(SimInit(&PL, &Irons[i], 50)) continue;
+        SimSetTemperature(350);
+        memset(&SimProf, 0, sizeof(SimProf));
+        SimProf.Clock = BenchClock;
+        for(t = 0; t < BENCH_STEP5_TIME; t += SimHalfPeriodTime()) SimHalfPeriod(&PL);
+        SimProf.Clock = 0;
+        if(!SimProf.Cnt) continue;
+        ia = (double)SimProf.ISR / SimProf.Cnt;
+        pa = (double)SimProf.PID / SimProf.Cnt;
+        printf("%-24.24s %10.1f %10.1f %10.1f\n", (const char *)Irons[i].Name, ia + pa, ia, pa);
+        sia += ia;
+        spa += pa;
+        cnt++;
+    }
+    if(cnt) printf("average step 5 in the ISR %.1f -> %.1f %s (%.2fx)\n", (sia + spa) / cnt, sia / cnt, BenchUnit(), (sia + spa) / sia);
+}
+
+//Heater measurement of a 256 sample capture, with and without clipped current: previous single loop in step 2 against
+//the accumulator fed through the DMA ring at every ring half, all of it and only the rest added in step 2
+void BenchHeaterMeasure(){
+    static const double Ohms[] = {8, 2, 1};
+    static UINT32 V[CHECK_VI_SAMPLES], I[CHECK_VI_SAMPLES];
+    static UINT32 VI[VIACC_RING];
+    t_VIAcc A;
+    UINT32 rnd = 1, n;
+    UINT64 t, to, tn, ts, tl;
+    int o, p, hv, hi, hp, hr;
+    volatile UINT32 sink = 0;
+
+    printf("heater measurement of %d samples, %d sample ring halves, %s\n", CHECK_VI_SAMPLES, VIACC_RING_HALF, BenchUnit());
+    printf("%-10s %8s %10s %10s %10s %10s\n", "heater", "clipped", "previous", "accum.", "speedup", "last step");
+    for(o = 0; o < sizeof(Ohms) / sizeof(Ohms[0]); o++){
+        CheckVIWave(V, I, NULL, CHECK_VI_SAMPLES, 414, Ohms[o], &rnd);
+        to = tn = tl = ~0ULL;
+        for(p = BENCH_PASSES; p--;){
+            t = BenchClock();
+            RefVIMeasure(V, I, CHECK_VI_SAMPLES, 1000, &hv, &hi, &hp, &hr);
+            t = BenchClock() - t;
+            sink += hi;
+            if(t < to) to = t;
+
+            t = BenchClock();
+            n = CheckVIRingFeed(&A, VI, V, I, CHECK_VI_SAMPLES, 0);
+            VIAccAdd(&A, VI, n);
+            VIAccFinish(&A, 1000);
+            t = BenchClock() - t;
+            sink += A.HI;
+            ts = BenchClock();
+            CheckVIRingFeed(&A, VI, V, I, CHECK_VI_SAMPLES, -1);
+            ts = BenchClock() - ts;
+            t = (t > ts) ? t - ts : 0;
+            if(t < tn) tn = t;
+
+            n = CheckVIRingFeed(&A, VI, V, I, CHECK_VI_SAMPLES - 1, VIACC_RING_HALF - 1);   //a ring half left for step 2
+            t = BenchClock();
+            VIAccAdd(&A, VI, n);
+            VIAccFinish(&A, 1000);
+            t = BenchClock() - t;
+            sink += A.HI;
+            if(t < tl) tl = t;
+        }
+        printf("%6.1f ohm %8u %10llu %10llu %9.2fx %10llu\n", Ohms[o], A.NC, (unsigned long long)to, (unsigned long long)tn,
+            (double)to / tn, (unsigned long long)tl);
+    }
+
+    to = tn = ~0ULL;
+    for(p = BENCH_PASSES; p--;){
+        UINT32 s = 0;
+        t = BenchClock();
+        for(n = 0; n < 0xFFFFFFF0UL; n += 0x10001) s += RefSqrt(n);
+        t = BenchClock() - t;
+        if(t < to) to = t;
+        t = BenchClock();
+        for(n = 0; n < 0xFFFFFFF0UL; n += 0x10001) s += UIntSqrt(n);
+        t = BenchClock() - t;
+        if(t < tn) tn = t;
+        sink += s;
+    }
+    ts = 0xFFFFFFF0UL / 0x10001 + 1;
+    printf("square root: bitwise %.1f, table and Newton %.1f %s per call (%.2fx)\n", (double)to / ts, (double)tn / ts, BenchUnit(), (double)to / tn);
+}
+
+//SavePars before the EEPROM requests were queued: a blocking read and a write of every changed byte
+static void RefSavePars(){
+    int i;
+    UINT8 b, oldb;
+
+    for(i = 0; i < sizeof(pars.b); i++){
+        if(EEPRead(i, 0 ,1) != pars.b[i]) EEPWriteImm(i, pars.b[i]);
+    }
+    oldb = EEPRead(64 + 63, 0, 1);
+    for(i = 0; i < 64; i++){
+        b = EEPRead(64 + i, 0, 1);
+        if((oldb == 0xFF) && (b >= MINTEMP) && (b <= MAXTEMP)) break;
+        oldb = b;
+    }
+    i &= 63;
+    b = EEPRead(64 + i, 0, 1);
+    if(b != TTemp){
+        EEPWriteImm(i + 64, 0xFF);
+        EEPWriteImm(((i + 1) & 63) + 64, TTemp);
+    }
+}
+
+typedef struct {
+    double Done;        //ms until SavePars returns and EEPBusy is cleared
+    double Committed;   //ms until the last write cycle is over
+    UINT32 Starts;
+    UINT32 Ints;
+    UINT32 NACKs;
+    UINT32 Cycles;
+    int Fail;           //the next power-up does not load the saved parameters
+}t_BenchSave;
+
+//Power-loss save of npars changed parameters and a new TTemp after the one at ring index pos, on the I2C bus model
+static void BenchSave(int npars, int pos, int ref, t_BenchSave * B){
+    pars_t P;
+    int i;
+
+    HALEEPErase();
+    while(HALI2CRun());
+    I2CInit();
+    for(i = 0; i < sizeof(pars.b); i++) HALEEP[i] = ParDef[i].Default;
+    HALEEP[64 + pos] = 150;
+    LoadPars();
+    while(HALI2CRun());
+    HALI2CReset();
+    for(i = 0; i < npars; i++){
+        if(ParDef[i].Min < ParDef[i].Max) ParsSet(i, (ParDef[i].Default < ParDef[i].Max) ? ParDef[i].Default + 1 : ParDef[i].Default - 1);
+    }
+    TTemp = 151;
+    P = pars;
+
+    if(ref) RefSavePars();
+    else SavePars();
+    while(EEPBusy()) HALI2CIdle();
+    B->Done = HALI2CTime / 1000;
+    B->Committed = ((HALEEPReady() > HALI2CTime) ? HALEEPReady() : HALI2CTime) / 1000;
+    while(HALI2CRun());
+    B->Starts = HALI2CStats.Starts;
+    B->Ints = HALI2CStats.Ints;
+    B->NACKs = HALI2CStats.NACKs;
+    B->Cycles = HALEEPWrites;
+    LoadPars();
+    while(HALI2CRun());
+    B->Fail = memcmp((const void *)pars.b, P.b, sizeof(P.b)) || (TTemp != 151);
+}
+
+void BenchPowerLossSave(){
+    static const struct {
+        const char * Name;
+        int Pars;
+        int Pos;
+    } Cases[] = {
+        {"1 par, ring in page", 1, 10},
+        {"all pars, ring in page", 19, 10},
+        {"all pars, ring 31/32", 19, 31},
+        {"all pars, ring wrap", 19, 63},
+    };
+    t_BenchSave B;
+    int c, ref;
+
+    printf("power-loss SavePars on the I2C bus model, %luk clock, %.1fms write cycle\n", I2C_CLOCK_FREQ / 1000, HAL_EEP_TWC / 1000.0);
+    printf("%-24s %-10s %8s %10s %7s %7s %6s %6s\n", "case", "save", "done ms", "commit ms", "starts", "ints", "NACKs", "cycles");
+    for(c = 0; c < sizeof(Cases) / sizeof(Cases[0]); c++){
+        for(ref = 1; ref >= 0; ref--){
+            BenchSave(Cases[c].Pars, Cases[c].Pos, ref, &B);
+            printf("%-24s %-10s %8.2f %10.2f %7u %7u %6u %6u%s\n", ref ? Cases[c].Name : "", ref ? "byte-wise" : "journal",
+                B.Done, B.Committed, B.Starts, B.Ints, B.NACKs, B.Cycles, B.Fail ? "  FAIL" : "");
+        }
+    }
+    HALEEPErase();
+}
+
+//SPI bytes of the default temperature screen, one frame every other half period as MenuTasks draws it, and
+//the bytes the main loop waits for
+static double BenchScreenSPI(t_Plant * PL, int halves, int all, UINT32 * frames, double * blocked){
+    t_CheckScreen S;
+    UINT32 bytes = HALSPIBytes, dma = HALSPIDMABytes;
+    double t = 0;
+    int k;
+
+    memset(&S, 0, sizeof(S));
+    *frames = 0;
+    for(k = 0; k < halves; k++){
+        SimHalfPeriod(PL);
+        t += SimHalfPeriodTime();
+        if(!(ISRTicks & 1)) continue;
+        CheckTempScreen(&S);
+        if(all) OLEDMark(0, 128, 0, 8);
+        OLEDUpdate();
+        (*frames)++;
+    }
+    *blocked = (double)(HALSPIBytes - bytes - (HALSPIDMABytes - dma)) / *frames;
+    return (HALSPIBytes - bytes) / t;
+}
+
+void BenchOLEDScreen(){
+    static t_Plant PL;
+    static const char * Phase[] = {"heat-up 10s", "idle at 350C 20s"};
+    static const int Halves[] = {1000, 2000};
+    static const struct {
+        const char * Name;
+        int All;
+        int Auto;
+    } Mode[] = {
+        {"all pages", 1, 0},
+        {"frame diff", 0, 0},
+        {"diff, DMA", 0, 1},
+    };
+    UINT32 frames, ints;
+    double bs, blocked;
+    int ph, m;
+
+    printf("default temperature screen over SPI, instrument %.24s, 50Hz mains, %.1fus a byte\n", (const char *)Irons[0].Name, HAL_SPI_BYTE_US);
+    printf("%-18s %-12s %7s %8s %16s %14s\n", "phase", "update", "frames", "B/s", "main loop us/fr", "DMA ints/fr");
+    for(ph = 0; ph < 2; ph++){
+        for(m = 0; m < sizeof(Mode) / sizeof(Mode[0]); m++){
+            SPIAuto = 0;
+            OLEDInit();
+            SPIAuto = Mode[m].Auto;
+            PlantInit(&PL, &Irons[0], 24, 25, 1);
+            SimInit(&PL, &Irons[0], 50);
+            SimSetTemperature(350);
+            if(ph) BenchScreenSPI(&PL, 1000, 0, &frames, &blocked);
+            ints = HALSPIDMAInts;
+            bs = BenchScreenSPI(&PL, Halves[ph], Mode[m].All, &frames, &blocked);
+            printf("%-18s %-12s %7u %8.0f %16.0f %14.1f\n", m ? "" : Phase[ph], Mode[m].Name, frames, bs,
+                blocked * HAL_SPI_BYTE_US, (double)(HALSPIDMAInts - ints) / frames);
+        }
+    }
+    SPIAuto = 0;
+}
+
+#define BENCH_MENU_FRAMES 2000
+
+//Every menu screen drawn by OLEDTasks as MenuTasks does each other half period, and the moving stand-by text
+//and the side letters drawn at pixel rows by the byte-wise path and by the column word blitter
+void BenchMenuScreens(){
+    static t_Plant PL;
+    static const struct {
+        const char * Name;
+        T_MENU_MODE Mode;
+        int DispTemp;
+    } Screen[] = {
+        {"temperature", DEFAULT_MENU, 350 << 4},
+        {"set temperature", SET_TEMPERATURE, 350 << 4},
+        {"reset temperature", RESET_TEMPERATURE, 350 << 4},
+        {"menu", MENU, 350 << 4},
+        {"set parameter", SET_PARAMS, 350 << 4},
+        {"calibration", CALIBRATION, 350 << 4},
+        {"instrument info", INSTRUMENT_INFO, 350 << 4},
+        {"input type", SET_INPUT_TYPE, 350 << 4},
+        {"tip change", TIP_CHANGE, 350 << 4},
+        {"version info", VERSION_INFO, 350 << 4},
+        {"auto-tune", AUTO_TUNE, 350 << 4},
+        {"stand-by HOT", STANDBY, 350 << 4},
+        {"stand-by ZZZ", STANDBY, 25 << 4},
+    };
+    static const t_OLEDFont RawFont816 = {(const UINT8 *)RawFont8x16, 0, 0, 8, 2, 0};
+    static const struct {
+        const char * Name;
+        const char * S;
+        const t_OLEDFont * Font;
+        const void * Raw;
+        int Num;
+    } Text[] = {
+        {"stand-by HOT 8x16", "HOT", &RawFont816, RawFont8x16, 0},
+        {"stand-by ZZZ 6x8", "ZZZ", &OLEDFont68, font6x8, 0},
+        {"SET letter 8x8", "S", &OLEDFont88, font8x8, 0},
+        {"reset number 8x8", 0, &OLEDFont88, font8x8, 1},
+    };
+    const t_OLEDFont * F;
+    UINT64 t, tr, tb;
+    UINT32 bytes;
+    int c, k, x, y;
+
+    SPIAuto = 0;
+    OLEDInit();
+    PlantInit(&PL, &Irons[0], 24, 25, 1);
+    SimInit(&PL, &Irons[0], 50);
+    SimSetTemperature(350);
+    printf("menu screens drawn by OLEDTasks, %d frames, instrument %.24s\n", BENCH_MENU_FRAMES, (const char *)Irons[0].Name);
+    printf("%-18s %14s %12s\n", "screen", "frame", "SPI B/fr");
+    for(c = 0; c < sizeof(Screen) / sizeof(Screen[0]); c++){
+        MenuInit();
+        MenuSetMode(Screen[c].Mode, Screen[c].DispTemp);
+        OLEDTasks(0);
+        bytes = HALSPIBytes;
+        t = BenchClock();
+        for(k = 0; k < BENCH_MENU_FRAMES; k++) OLEDTasks(0);
+        t = BenchClock() - t;
+        printf("%-18s %7.0f %-6s %12.1f\n", Screen[c].Name, (double)t / BENCH_MENU_FRAMES, BenchUnit(),
+            (double)(HALSPIBytes - bytes) / BENCH_MENU_FRAMES);
+    }
+    MenuInit();
+
+    printf("\ntext at every pixel row over the screen\n");
+    printf("%-18s %12s %12s %8s\n", "text", "byte-wise", "blitter", "speedup");
+    for(c = 0; c < sizeof(Text) / sizeof(Text[0]); c++){
+        F = Text[c].Font;
+        for(k = 0; k < 2; k++){
+            t = BenchClock();
+            for(y = 0; y <= 64 - 8 * F->Height; y++){
+                for(x = 0; x < 128 - 24; x += 8){
+                    if(Text[c].Num){
+                        if(k) OLEDPrintNumXY(x, y, 1, (x + y) % 10, F);
+                        else RefOLEDPrintNumXY(x, y, 1, (x + y) % 10, Text[c].Raw, F->Start, F->Width, F->Height, F->Blank);
+                    }
+                    else{
+                        if(k) OLEDPrintXY(x, y, Text[c].S, 0, F);
+                        else RefOLEDPrintXY(x, y, Text[c].S, 0, Text[c].Raw, F->Start, F->Width, F->Height, F->Blank);
+                    }
+                }
+            }
+            t = BenchClock() - t;
+            if(k) tb = t;
+            else tr = t;
+        }
+        k = (65 - 8 * F->Height) * ((128 - 24 + 7) / 8);
+        printf("%-18s %5.0f %-6s %5.0f %-6s %7.2fx\n", Text[c].Name, (double)tr / k, BenchUnit(), (double)tb / k, BenchUnit(), (double)tr / tb);
+    }
+    OLEDInit();
+}
+
+#define BENCH_GLYPH_PASSES 2000
+
+//Cycles to draw a glyph from its raw bitmap as before fontpack and from the packed one
+static double BenchGlyph(int what, int packed, int * glyphs){
+    static const t_OLEDFont RawFont816 = {(const UINT8 *)RawFont8x16, 0, 0, 8, 2, 0};
+    UINT64 t;
+    int k, g, i, x, y, n = 0;
+
+    t = BenchClock();
+    for(k = 0; k < BENCH_GLYPH_PASSES; k++){
+        switch(what){
+            case 0:
+                for(g = 0; g < 10; g++, n++){
+                    if(packed) OLEDWritePacked(64, 32, 1, 6, &numbers32x48Packed, g);
+                    else OLEDWrite(64, 32, 1, (void *)RawNumbers32x48[g], 192);
+                }
+                break;
+            case 1:
+                for(g = 10; g < 12; g++, n++){
+                    if(packed){
+                        OLEDWritePacked(108, 16, 1, 5, &numbers32x48Packed, g);
+                    }
+                    else{
+                        for(i = 0; i < 5; i++) OLEDWrite(108, 16, 1 + i, (void *)&RawNumbers32x48[g][i * 32], 16);
+                    }
+                }
+                break;
+            case 2:
+                for(g = 'A'; g <= 'Z'; g++, n++){
+                    char s[2] = {g, 0};
+                    OLEDPrint(0, 2, s, 1, packed ? &OLEDFont816 : &RawFont816);
+                }
+                break;
+            case 3:
+                for(g = 'A'; g <= 'Z'; g++, n++){
+                    char s[2] = {g, 0};
+                    OLEDPrintXY(0, 3 + (g & 7), s, 1, packed ? &OLEDFont816 : &RawFont816);
+                }
+                break;
+            default:
+                n++;
+                if(packed){
+                    OLEDWritePacked(0, 128, 0, 8, &logoPacked, 0);
+                }
+                else{
+                    i = 1023;
+                    for(x = 0; x < 128; x++){
+                        for(y = 0; y < 8; y++) OLEDBUFF.B[y][x] = ~RawLogo[i--];
+                    }
+                }
+                break;
+        }
+    }
+    t = BenchClock() - t;
+    *glyphs = n / BENCH_GLYPH_PASSES;
+    return (double)t / n;
+}
+
+void BenchFontPack(){
+    static const struct {
+        const char * Name;
+        const t_OLEDPacked * P;
+        int Glyphs;
+        int Raw;
+    } Set[] = {
+        {"32x48 digits", &numbers32x48Packed, 12, sizeof(RawNumbers32x48)},
+        {"8x16 font", &font8x16Packed, 128, sizeof(RawFont8x16)},
+        {"logo", &logoPacked, 1, sizeof(RawLogo)},
+    };
+    static const char * Draw[] = {"32x48 digit", "16x40 C/F", "8x16 at a page", "8x16 at a pixel row", "128x64 logo"};
+    double tr, tp;
+    int c, n;
+
+    printf("bitmaps packed by fontpack\n");
+    printf("%-18s %8s %8s %6s\n", "set", "raw B", "packed B", "ratio");
+    for(c = 0; c < sizeof(Set) / sizeof(Set[0]); c++){
+        n = CheckPackedSize(Set[c].P, Set[c].Glyphs);
+        printf("%-18s %8d %8d %5.0f%%\n", Set[c].Name, Set[c].Raw, n, 100.0 * n / Set[c].Raw);
+    }
+
+    SPIAuto = 0;
+    OLEDInit();
+    printf("\n%-20s %14s %14s %8s\n", "glyph", "raw", "packed", "ratio");
+    for(c = 0; c < sizeof(Draw) / sizeof(Draw[0]); c++){
+        tr = BenchGlyph(c, 0, &n);
+        tp = BenchGlyph(c, 1, &n);
+        printf("%-20s %7.0f %-6s %7.0f %-6s %7.2fx\n", Draw[c], tr, BenchUnit(), tp, BenchUnit(), tp / tr);
+    }
+    OLEDInit();
+}
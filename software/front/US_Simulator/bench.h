@@ -0,0 +1,26 @@
+/*
+ * File:   bench.h
+ *
+ * Host benchmarks of the control core, run by ussim -B.
+ */
+
+#ifndef BENCH_H
+#define	BENCH_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+extern void BenchSensorTemperature();
+extern void BenchISRStep5();
+extern void BenchHeaterMeasure();
+extern void BenchPowerLossSave();
+extern void BenchOLEDScreen();
+extern void BenchMenuScreens();
+extern void BenchFontPack();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* BENCH_H */
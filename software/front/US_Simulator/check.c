@@ -0,0 +1,952 @@
+/*
+ * File:   check.c
+ *
+ * Host checks of the control core against reference calculations.
+ * Each check prints one line per case and returns the number of failures.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include "mcu.h"
+#include "isr.h"
+#include "main.h"
+#include "pars.h"
+#include "EEP.h"
+#include "iron.h"
+#include "PID.h"
+#include "sensorMath.h"
+#include "plant.h"
+#include "sim.h"
+#include "OLED.h"
+#include "io.h"
+#include "check.h"
+
+//the bitmaps as drawn before fontpack packed them
+#define numbers32x48 RawNumbers32x48
+#define font8x16 RawFont8x16
+#define logo RawLogo
+#include "font32x48numbers.h"
+#include "font8x16.h"
+#include "logo.h"
+#undef numbers32x48
+#undef font8x16
+#undef logo
+
+extern const t_IronPars Irons[];
+extern const int IronsNum;
+
+#define LUT_MAX_ERROR 0.5
+
+//Worst case difference between the sensor lookup table and the polynomial over the part of the
+//input range where the polynomial is monotonic and gives temperatures between tmin and tmax
+static int CheckLUT(const char * name, const char * sensor, const t_PlantSensor * PS, t_SensorConfig * SC, double tmin, double tmax){
+    static t_SensorLUT LUT;
+    double err = 0, at = 0;
+    int steps = 0, dw, n = 0;
+
+    SensorLUTBuild(&LUT, SC);
+    for(dw = PS->Lo; dw <= PS->Hi; dw++){
+        double ref = PS->TTab[dw];
+        double t;
+        int i = dw >> SENSOR_LUT_SHIFT;
+        int f = dw & ((1 << SENSOR_LUT_SHIFT) - 1);
+        int d;
+        if(ref < tmin || ref > tmax) continue;
+        //table interpolation before it is rounded to the 1/2 degree output of the polynomial path
+        t = (LUT.T[i] + (double)(LUT.T[i + 1] - LUT.T[i]) * f / (1 << SENSOR_LUT_SHIFT)) / (1 << SENSOR_LUT_FRAC);
+        if(fabs(t - ref) > err){
+            err = fabs(t - ref);
+            at = ref;
+        }
+        //firmware outputs (degrees * 2), lookup table vs polynomial path
+        d = abs(GetSensorTemperatureLUT(dw - SC->Offset, &LUT) - GetSensorTemperature(dw - SC->Offset, SC));
+        if(d > steps) steps = d;
+        n++;
+    }
+    printf("%-24.24s %-4s %5d inputs  max error %.3fC at %6.1fC  max output difference %d/2C  %s\n",
+        name, sensor, n, err, at, steps, (err < LUT_MAX_ERROR && n) ? "ok" : "FAIL");
+    return (err < LUT_MAX_ERROR && n) ? 0 : 1;
+}
+
+int CheckSensorLUT(){
+    static t_Plant PL;
+    int i, ch, fail = 0;
+
+    //no cold junction compensation, compare the polynomials only
+    CJTemp = -273*2;
+    CRTemp = 0;
+    for(i = 0; i < IronsNum; i++){
+        const t_IronPars * IP = &Irons[i];
+        PlantInit(&PL, IP, 24, 25, 1);
+        for(ch = 0; ch < 2; ch++){
+            t_SensorConfig * SC = (t_SensorConfig *)&IP->Config[ch].SensorConfig;
+            if(SC->Type == SENSOR_UNDEFINED || SC->Type == SENSOR_NONE) continue;
+            fail += CheckLUT((const char *)IP->Name, ch ? "ch1" : "ch0", &PL.Ch[ch].S, SC, 0, 600);
+        }
+        if(IP->ColdJunctionSensorConfig){
+            fail += CheckLUT((const char *)IP->Name, "cj", &PL.CJ, (t_SensorConfig *)IP->ColdJunctionSensorConfig, -10, 100);
+        }
+    }
+    printf("sensor lookup tables: %s\n", fail ? "FAIL" : "ok");
+    return fail;
+}
+
+/**** Previous heater measurement of ISRHigh step 2 and mcuSqrt, used as reference ****/
+UINT32 RefSqrt(UINT32 n){
+    UINT32 r, x;
+    r = 0;
+    for(x = 0x8000L; x; x >>= 1){
+        r += x;
+        if((UINT32)(r * r) > n)r -= x;
+    }
+    return r;
+}
+
+void RefVIMeasure(const UINT32 * VBuff, const UINT32 * TIBuff, UINT32 VTIBuffCnt, UINT32 dw, int * HV, int * HI, int * HP, int * HR){
+    UINT32 i, l;
+    *HV = *HI = *HP = 0;
+    *HR = 0x7FFF;
+    if((i = l = VTIBuffCnt) > 1){
+        UINT32 sv = 0, si = 0, sp = 0, ri = 0, rv = 0, r = 0;
+        for(i--, l--; i--;){
+            UINT32 ci = TIBuff[i];
+            UINT32 cv = VBuff[i] + VBuff[i + 1];
+            if(ci < 1023){
+                if(ri < ci && VBuff[i] < 1023 && VBuff[i + 1] < 1023){
+                    ri = ci;
+                    rv = cv;
+                    r = 0;
+                }
+            }
+            else{
+                if(!r && ri) r = ((rv * 6738) / ri) >> 9;
+                if(r) ci = ((cv * 6738) / r) >> 9;
+            }
+            sv += cv * cv;
+            si += ci * ci;
+            sp += ci * cv;
+        }
+        r = (ri ? (((rv * 6738) / ri) + 256) >> 9 : 0x7FFF);
+        sv = (sv + (l >> 1)) / l;
+        si = (si + (l >> 1)) / l;
+        l *= (UINT32)(391 * 2);
+        sp = (sp + (l >> 1)) / l;
+        *HV = (RefSqrt(sv * dw) + 31) >> 6;
+        *HI = (RefSqrt(si * dw) + 15) >> 5;
+        *HP = ((sp * dw) + 511) >> 10;
+        *HR = r;
+    }
+}
+/************************************************************************************/
+
+//Samples of a heated half period: n voltage samples with vpk ADC counts at the top of the mains sine
+//wave and the heater current through ohms, both clipped at 1023 like the ADC; C = current before clipping
+void CheckVIWave(UINT32 * V, UINT32 * I, double * C, int n, double vpk, double ohms, UINT32 * rnd){
+    int i;
+    for(i = 0; i < n; i++){
+        double ph = 3.14159265 * (i + 0.5) / n;
+        double v = vpk * sin(ph);
+        //current sample is taken between two voltage samples; current ADC = cv * 6738 / (ohms * 10 * 512)
+        double c = 2 * vpk * sin(3.14159265 * (i + 1.0) / n) * 6738 / (ohms * 10 * 512);
+        *rnd = *rnd * 1103515245 + 12345;
+        v += (int)((*rnd >> 16) % 5) - 2;
+        *rnd = *rnd * 1103515245 + 12345;
+        c += (int)((*rnd >> 16) % 5) - 2;
+        V[i] = (v < 0) ? 0 : (v > 1023) ? 1023 : (UINT32)v;
+        I[i] = (c < 0) ? 0 : (c > 1023) ? 1023 : (UINT32)c;
+        if(C) C[i] = (c < 0) ? 0 : c;
+    }
+}
+
+//Feed n samples to the accumulator the way the DMA and the firmware do: through the VI ring of pairs, with VIAccAdd run lag
+//samples after every completed ring half (lag < VIACC_RING_HALF, < 0 for the DMA writes only). Returns the ring position at the end of the capture,
+//the caller adds the rest with VIAccAdd(A, VI, end) like step 2
+UINT32 CheckVIRingFeed(t_VIAcc * A, UINT32 * VI, const UINT32 * V, const UINT32 * I, int n, int lag){
+    int s, due = -1;
+    VIAccInit(A);
+    for(s = 0; s < n; s++){
+        VI[s & VIACC_RING_MASK] = V[s] | (I[s] << 16);
+        if(!((s + 1) % VIACC_RING_HALF)) due = s + lag;
+        if(s == due) VIAccAdd(A, VI, (s + 1) & VIACC_RING_MASK);
+    }
+    return n & VIACC_RING_MASK;
+}
+
+//error in percent of a against the exact value e
+static double VIError(int a, double e){
+    return e ? 100.0 * fabs(a - e) / e : 0;
+}
+
+int CheckVIAcc(){
+    static const double Vpk[] = {60, 200, 414, 600};
+    static const double Ohms[] = {1, 1.5, 2, 3, 4, 8};
+    static const int N[] = {2, 3, 9, 15, 16, 17, 33, 64, 200, 256};
+    static UINT32 V[CHECK_VI_SAMPLES], I[CHECK_VI_SAMPLES];
+    static UINT32 VI[VIACC_RING];
+    static double C[CHECK_VI_SAMPLES];
+    t_VIAcc A;
+    UINT32 n, rnd = 1;
+    int v, o, k, p, fail = 0, cases = 0, clipped = 0;
+    int hv, hi, hp, hr;
+    double eio = 0, ein = 0, epo = 0, epn = 0;
+
+    //square root: every n up to 2^24, around every square and random values
+    for(n = 0; n < (1UL << 24); n++){
+        if(UIntSqrt(n) != RefSqrt(n)) fail++;
+    }
+    for(n = 1; n < 65536; n++){
+        UINT32 q = n * n;
+        if(UIntSqrt(q) != n || UIntSqrt(q - 1) != n - 1) fail++;
+    }
+    for(k = 0; k < 1000000; k++){
+        rnd = rnd * 1103515245 + 12345;
+        n = (rnd >> 8) * (rnd & 0xFF) ^ rnd;
+        if(UIntSqrt(n) != RefSqrt(n)) fail++;
+    }
+    if(UIntSqrt(0xFFFFFFFFUL) != 0xFFFF) fail++;
+    printf("integer square root: %s\n", fail ? "FAIL" : "ok");
+
+    //accumulator fed through the ring with random interrupt latency against the previous single loop: the same results without clipped current,
+    //and no further from the unclipped current than the previous reconstruction (or within 1%) with it
+    for(v = 0; v < sizeof(Vpk) / sizeof(Vpk[0]); v++){
+        for(o = 0; o < sizeof(Ohms) / sizeof(Ohms[0]); o++){
+            for(k = 0; k < sizeof(N) / sizeof(N[0]); k++){
+                for(p = 0; p < 8; p++){
+                    int ok;
+                    CheckVIWave(V, I, C, N[k], Vpk[v], Ohms[o], &rnd);
+                    RefVIMeasure(V, I, N[k], 1000, &hv, &hi, &hp, &hr);
+                    rnd = rnd * 1103515245 + 12345;
+                    n = CheckVIRingFeed(&A, VI, V, I, N[k], (rnd >> 16) % VIACC_RING_HALF);
+                    VIAccAdd(&A, VI, n);
+                    VIAccFinish(&A, 1000);
+                    if(A.Cnt != N[k] - 1) fail++;
+                    cases++;
+                    if(A.NC){
+                        double si = 0, sp = 0, ei, ep;
+                        int i;
+                        for(i = 0; i < N[k] - 1; i++){
+                            si += C[i] * C[i];
+                            sp += C[i] * (V[i] + V[i + 1]);
+                        }
+                        si = sqrt(si / (N[k] - 1) * 1000) / 32;
+                        sp = sp / (N[k] - 1) / 782 * 1000 / 1024;
+                        clipped++;
+                        ei = VIError(A.HI, si);
+                        ep = VIError(A.HP, sp);
+                        eio += VIError(hi, si);
+                        epo += VIError(hp, sp);
+                        ein += ei;
+                        epn += ep;
+                        ok = A.HV == hv && A.HR == hr && (ei <= VIError(hi, si) || ei <= 1.0 || abs(A.HI - (int)(si + 0.5)) <= 1) &&
+                            (ep <= VIError(hp, sp) || ep <= 1.0 || abs(A.HP - (int)(sp + 0.5)) <= 1);
+                    }
+                    else{
+                        ok = A.HV == hv && A.HI == hi && A.HP == hp && A.HR == hr;
+                    }
+                    if(!ok){
+                        if(fail < 10) printf("  vpk %.0f R %.1f n %d clipped %u: V %d/%d I %d/%d P %d/%d R %d/%d\n", Vpk[v], Ohms[o], N[k], A.NC,
+                            A.HV, hv, A.HI, hi, A.HP, hp, A.HR, hr);
+                        fail++;
+                    }
+                }
+            }
+        }
+    }
+    if(clipped){
+        eio /= clipped;
+        ein /= clipped;
+        epo /= clipped;
+        epn /= clipped;
+    }
+    printf("heater measurement: %d cases, %d with clipped current, average error of these I %.2f%% -> %.2f%% P %.2f%% -> %.2f%%  %s\n",
+        cases, clipped, eio, ein, epo, epn, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//Instrument with the override store as it is at power-up, 1 if it was not identified
+static int CheckOvrPowerUp(int iron){
+    static t_Plant PL;
+    PlantInit(&PL, &Irons[iron], 24, 25, 1);
+    return SimInit(&PL, &Irons[iron], 50) ? 1 : 0;
+}
+
+int CheckIronOvr(){
+    const t_IronConfig * A = &Irons[0].Config[0];
+    const t_IronConfig * B = &Irons[1].Config[0];
+    UINT32 r;
+    int i, fail = 0;
+
+    //only the saved fields of the saved instrument change, and they survive a power cycle
+    HALEEPErase();
+    fail += CheckOvrPowerUp(0);
+    IronPars.Config[0].PID_KP = A->PID_KP + 7;
+    IronPars.Config[0].PID_KI = A->PID_KI + 3;
+    IronPars.Config[0].SensorConfig.Gain = A->SensorConfig.Gain + 4;
+    IronOvrSave(IRON_OVR_KP | IRON_OVR_GAIN, 0);
+    r = HALEEPReads;
+    fail += CheckOvrPowerUp(0);
+    if(IronPars.Config[0].PID_KP != A->PID_KP + 7 || IronPars.Config[0].SensorConfig.Gain != A->SensorConfig.Gain + 4) fail++;
+    if(IronPars.Config[0].PID_KI != A->PID_KI) fail++;
+    //the store is read at power-up, the identified instrument reads its own record only
+    if(HALEEPReads - r != IRON_OVR_SLOTS + 1) fail++;
+    fail += CheckOvrPowerUp(1);
+    if(IronPars.Config[0].PID_KP != B->PID_KP || IronPars.Config[0].SensorConfig.Gain != B->SensorConfig.Gain) fail++;
+
+    //a second save keeps the first fields
+    IronPars.Config[0].PID_KI = B->PID_KI + 5;
+    IronOvrSave(IRON_OVR_KI, 0);
+    fail += CheckOvrPowerUp(0);
+    IronPars.Config[0].PID_DGain = A->PID_DGain + 1;
+    IronOvrSave(IRON_OVR_DGAIN, 0);
+    fail += CheckOvrPowerUp(0);
+    if(IronPars.Config[0].PID_KP != A->PID_KP + 7 || IronPars.Config[0].PID_DGain != A->PID_DGain + 1) fail++;
+    fail += CheckOvrPowerUp(1);
+    if(IronPars.Config[0].PID_KI != B->PID_KI + 5 || IronPars.Config[0].PID_KP != B->PID_KP) fail++;
+
+    //records of another layout or with a bad checksum are ignored
+    HALEEP[IRON_OVR_EEP + 2]++;
+    fail += CheckOvrPowerUp(0);
+    if(IronPars.Config[0].PID_KP != A->PID_KP) fail++;
+    HALEEP[IRON_OVR_EEP + 2]--;
+    HALEEP[IRON_OVR_EEP + 5] ^= 0x10;
+    fail += CheckOvrPowerUp(0);
+    if(IronPars.Config[0].PID_KP != A->PID_KP) fail++;
+    HALEEP[IRON_OVR_EEP + 5] ^= 0x10;
+
+    //cleared instruments are back to Irons[], the others keep their records
+    fail += CheckOvrPowerUp(0);
+    IronOvrClear();
+    fail += CheckOvrPowerUp(0);
+    if(IronPars.Config[0].PID_KP != A->PID_KP || IronPars.Config[0].SensorConfig.Gain != A->SensorConfig.Gain) fail++;
+    fail += CheckOvrPowerUp(1);
+    if(IronPars.Config[0].PID_KI != B->PID_KI + 5) fail++;
+
+    //with all slots taken a new instrument replaces the record saved least recently, Seq 0xFFF0 is older than 1 (wrapped count)
+    HALEEPErase();
+    for(i = 0; i < IRON_OVR_SLOTS; i++){
+        t_IronOvr O;
+        UINT8 * b = (UINT8 *)&O, sum = 0;
+        int j;
+        memset(&O, 0, sizeof(O));
+        O.ID = 0x0A00 + i;
+        O.Version = IRON_OVR_VERSION;
+        O.Seq = (i == 5) ? 0xFFF0 : (i == 3) ? 100 : i + 1;
+        for(j = sizeof(O) - 1; j--;) sum += b[j];
+        O.Sum = -sum;
+        memcpy(&HALEEP[IRON_OVR_EEP + i * 32], &O, sizeof(O));
+    }
+    fail += CheckOvrPowerUp(0);
+    IronPars.Config[0].PID_KP = A->PID_KP + 7;
+    IronOvrSave(IRON_OVR_KP, 0);
+    fail += CheckOvrPowerUp(1);
+    IronPars.Config[0].PID_KP = B->PID_KP + 9;
+    IronOvrSave(IRON_OVR_KP, 0);
+    while(HALI2CRun());
+    if(HALEEP[IRON_OVR_EEP + 5 * 32] != Irons[0].ID.v[0] || HALEEP[IRON_OVR_EEP + 5 * 32 + 1] != Irons[0].ID.v[1]) fail++;
+    if(HALEEP[IRON_OVR_EEP] != Irons[1].ID.v[0] || HALEEP[IRON_OVR_EEP + 1] != Irons[1].ID.v[1]) fail++;
+    for(i = 1; i < IRON_OVR_SLOTS; i++){
+        if(i != 5 && (HALEEP[IRON_OVR_EEP + i * 32] != i || HALEEP[IRON_OVR_EEP + i * 32 + 1] != 0x0A)) fail++;
+    }
+    fail += CheckOvrPowerUp(0);
+    if(IronPars.Config[0].PID_KP != A->PID_KP + 7) fail++;
+    fail += CheckOvrPowerUp(1);
+    if(IronPars.Config[0].PID_KP != B->PID_KP + 9) fail++;
+
+    HALEEPErase();
+    printf("instrument parameter overrides: %s\n", fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//Power-up: LoadPars with the transfers it queues complete
+static void CheckParsPowerUp(){
+    while(HALI2CRun());
+    I2CInit();
+    LoadPars();
+    while(HALI2CRun());
+}
+
+//Power-loss save: SavePars until EEPBusy clears, returns the bus transactions other than the write cycle polls
+static UINT32 CheckParsPowerLoss(){
+    HALI2CReset();
+    SavePars();
+    while(EEPBusy()) HALI2CIdle();
+    return HALI2CStats.Starts - HALI2CStats.NACKs;
+}
+
+int CheckParsJournal(){
+    pars_t P;
+    UINT32 n;
+    int fail = 0;
+
+    //nothing changed: no transfer at all
+    HALEEPErase();
+    CheckParsPowerUp();
+    if(CheckParsPowerLoss() != 0 || HALEEPWrites != 0) fail++;
+
+    //changed parameters and TTemp: one page write and the poll for its end, no reads
+    ParsSet(9, 3);
+    ParsSet(0, MAXTEMP);
+    TTemp = 200;
+    P = pars;
+    n = CheckParsPowerLoss();
+    printf("power-loss save: %u transactions, %u write cycles, %u reads, %.2fms\n", n, HALEEPWrites, HALEEPReads, HALI2CTime / 1000);
+    if(n != 2 || HALEEPWrites != 1 || HALEEPReads != 0) fail++;
+
+    //the next power-up takes them from the journal and writes them back, the one after from the parameter block and the ring
+    pars.b[9] = 0;
+    TTemp = 0;
+    CheckParsPowerUp();
+    if(memcmp((const void *)pars.b, P.b, sizeof(P.b)) || TTemp != 200) fail++;
+    if(HALEEP[PARS_JOURNAL_EEP] != 0xFF || HALEEP[9] != 3) fail++;
+    CheckParsPowerUp();
+    if(memcmp((const void *)pars.b, P.b, sizeof(P.b)) || TTemp != 200) fail++;
+    if(CheckParsPowerLoss() != 0) fail++;
+
+    //a torn journal write is ignored
+    ParsSet(9, 7);
+    CheckParsPowerLoss();
+    HALEEP[PARS_JOURNAL_EEP + 10]++;
+    CheckParsPowerUp();
+    if(pars.b[9] != 3 || TTemp != 200) fail++;
+
+    HALEEPErase();
+    printf("parameter journal: %s\n", fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//Pot and DAC writes of every instrument in 2s at 300C with an EEPROM burst in the second half: the front end must
+//be set up before every temperature read, the writes that would not change anything are skipped
+int CheckI2CSched(){
+    static t_Plant PL;
+    static UINT8 Buf[4096];
+    t_EEPReq W = {0, Buf, sizeof(Buf), 1, 0, 0, 0}, R = {0, Buf, sizeof(Buf), 0, 0, 0, 0};
+    UINT32 cmds = 0, skipped = 0, late = 0, writes = 0, bytes = 0, n = 0;
+    int i, k, fail = 0;
+    double t = 0;
+
+    for(i = 0; i < IronsNum; i++){
+        HALEEPErase();
+        PlantInit(&PL, &Irons[i], 24, 25, 1);
+        if(SimInit(&PL, &Irons[i], 50)){
+            fail++;
+            continue;
+        }
+        SimSetTemperature(300);
+        HALI2CReset();
+        memset((void *)&I2CStats, 0, sizeof(I2CStats));
+        for(k = 0; k < 200; k++){
+            if(k == 100){
+                EEPSubmit(&W);
+                EEPSubmit(&R);
+            }
+            SimHalfPeriod(&PL);
+        }
+        while(R.Busy) HALI2CIdle();
+        while(HALI2CRun());
+        if(HALPots.Current[0] != I2CData.CurrentA.ui16 || HALPots.Current[1] != I2CData.CurrentB.ui16
+            || HALPots.Gain != I2CData.Gain.ui16 || HALPots.Offset != I2CData.Offset.ui16) fail++;
+        cmds += I2CStats.Cmds;
+        skipped += I2CStats.Skipped;
+        late += I2CStats.Late;
+        writes += HALPots.Writes;
+        bytes += HALPots.Bytes;
+        t += HALI2CTime;
+        n++;
+    }
+    if(late) fail++;
+    HALEEPErase();
+    printf("I2C pots: %u instruments, %.0f writes/s, %.0f bytes/s, %.0f skipped/s, %u late  %s\n", n, writes / t * 1e6,
+        bytes / t * 1e6, skipped / t * 1e6, late, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//Pot and DAC writes of one register, as CheckI2CShadow queues them: returns the bytes of the transactions
+static UINT32 CheckPotWrite(UINT16 * v, UINT16 val){
+    UINT32 b = HALPots.Bytes;
+    *v = val;
+    I2CSetPots(mcuReadCoreTimer() + 1000 * (CORETIMER_FREQ / 1000000));
+    while(HALI2CRun());
+    if(HALPots.Current[0] != I2CData.CurrentA.ui16 || HALPots.Current[1] != I2CData.CurrentB.ui16
+        || HALPots.Gain != I2CData.Gain.ui16 || HALPots.Offset != I2CData.Offset.ui16) return 0xFFFF;
+    return HALPots.Bytes - b;
+}
+
+//Shadow registers: a change sends only the registers which differ, no change leaves the bus idle. The bus utilisation
+//counters of the I2C engine must agree with the bus model
+int CheckI2CShadow(){
+    static UINT8 Buf[256];
+    t_EEPReq W = {0, Buf, sizeof(Buf), 1, 0, 0, 0}, R = {0, Buf, sizeof(Buf), 0, 0, 0, 0};
+    UINT32 full, wiper, tcon, gain, offset, same, cmds, skipped;
+    double busy;
+    int fail = 0;
+
+    while(HALI2CRun());
+    HALI2CReset();
+    I2CInit();
+    memset((void *)&I2CStats, 0, sizeof(I2CStats));
+    I2CData.CurrentA.ui16 = 100;
+    I2CData.CurrentB.ui16 = 100;
+    I2CData.Gain.ui16 = 128;
+    full = CheckPotWrite((UINT16 *)&I2CData.Offset.ui16, 128);
+    wiper = CheckPotWrite((UINT16 *)&I2CData.CurrentA.ui16, 101);
+    tcon = CheckPotWrite((UINT16 *)&I2CData.CurrentB.ui16, 0);
+    if(HALPots.TCON != 0x0F) fail++;
+    gain = CheckPotWrite((UINT16 *)&I2CData.Gain.ui16, 129);
+    offset = CheckPotWrite((UINT16 *)&I2CData.Offset.ui16, 130);
+    cmds = I2CStats.Cmds;
+    same = CheckPotWrite((UINT16 *)&I2CData.CurrentA.ui16, 101);
+    if(I2CStats.Cmds != cmds) fail++;
+    if(full != 7 + 3 + 4 || wiper != 3 || tcon != 5 || gain != 3 || offset != 4 || same != 0) fail++;
+
+    //values changed back before the queued write starts, while the bus is busy: nothing to send
+    skipped = I2CStats.Skipped;
+    EEPSubmit(&W);
+    I2CData.CurrentA.ui16 = 102;
+    I2CAddCommands(I2C_SET_CPOT);
+    I2CData.CurrentA.ui16 = 101;
+    EEPSubmit(&R);
+    while(R.Busy) HALI2CIdle();
+    while(HALI2CRun());
+    if(I2CStats.Skipped != skipped + 1 || HALPots.Writes != 7) fail++;
+    busy = I2CStats.BusyTicks / (double)(CORETIMER_FREQ / 1000000);
+    if(I2CStats.Bytes != HALI2CStats.Bytes || I2CStats.Starts != HALI2CStats.Starts || I2CStats.Polls != HALI2CStats.NACKs
+        || busy < HALI2CStats.Busy || busy > HALI2CStats.Busy + HALI2CStats.Ints * 2 * HAL_I2C_LAT) fail++;
+    HALEEPErase();
+    printf("I2C shadow registers: all %u bytes, wiper %u, wiper and TCON %u, gain %u, offset %u, unchanged %u  "
+        "bus %u bytes %u starts %u polls %.0fus  %s\n", full, wiper, tcon, gain, offset, same, I2CStats.Bytes, I2CStats.Starts,
+        I2CStats.Polls, busy, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//Live record stream of every instrument at 300C: a reader which takes up to 4 records every half period gets all of
+//them in sequence, a reader stalled for 4s gets one gap of the records the ring could not keep and nothing else
+int CheckLiveRecs(){
+    static t_Plant PL;
+    t_PIDHist R[4];
+    UINT32 seq, next, recs = 0, reports = 0, lost, n = 0;
+    int i, k, m, fail = 0;
+    double t = 0;
+
+    for(i = 0; i < IronsNum; i++){
+        PlantInit(&PL, &Irons[i], 24, 25, 1);
+        if(SimInit(&PL, &Irons[i], 50)){
+            fail++;
+            continue;
+        }
+        SimSetTemperature(300);
+        seq = next = PIDHistCnt;
+        for(k = 0; k < 200; k++){
+            SimHalfPeriod(&PL);
+            t += SimHalfPeriodTime();
+            while((m = PIDHistRead(&seq, R, 4))){
+                if(seq != next || R[0].Ticks != PIDHist[seq & (PID_HIST_SIZE - 1)].Ticks) fail++;
+                seq += m;
+                next = seq;
+                recs += m;
+                reports++;
+            }
+        }
+        for(k = 0; k < 400; k++) SimHalfPeriod(&PL);
+        lost = 0;
+        while((m = PIDHistRead(&seq, R, 4))){
+            if(seq != next){
+                if(lost || seq - next != PIDHistCnt - next - (PID_HIST_SIZE - PID_HIST_MARGIN)) fail++;
+                lost += seq - next;
+            }
+            seq += m;
+            next = seq;
+        }
+        if(!lost || next != PIDHistCnt) fail++;
+        n++;
+    }
+    printf("live records: %u instruments, %.0f records/s in %.1f a read, stalled reader gap reported  %s\n", n,
+        recs / t, reports ? (double)recs / reports : 0, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//Telemetry frames of the dual instruments read one sensor a temperature window: the filtered temperature of
+//both channels must be PIDVars TAvgF at the averaging of PIDAVG and follow the temperature of its channel
+int CheckTlmDual(){
+    static t_Plant PL;
+    UINT32 mask = (1UL << TLM_CTEMP) | (1UL << TLM_TAVGF) | (1UL << TLM_HR);
+    const UINT8 * d = (const UINT8 *)TXP.Tlm.Data;
+    int i, k, ch, t, n = 0, err = 0, fail = 0;
+
+    SimDualScan = 0;
+    for(i = 0; i < IronsNum; i++){
+        if(!Irons[i].Config[1].SensorConfig.Type) continue;
+        PlantInit(&PL, &Irons[i], 24, 25, 1);
+        if(SimInit(&PL, &Irons[i], 50)){
+            fail++;
+            continue;
+        }
+        SimSetTemperature(300);
+        for(k = 0; k < 1500; k++) SimHalfPeriod(&PL);
+        if(IronDualScan || IOTlmFrame(mask) != mask || TXP.Tlm.Chs != 2) fail++;
+        for(ch = 0; ch < 2; ch++){
+            t = d[4 + 2 * ch] | (d[5 + 2 * ch] << 8);
+            if(t != (UINT16)(PIDVars[ch].TAvgF[0] >> PIDAVG())) fail++;
+            err = max(err, abs(t - PIDVars[ch].CTemp[0]));
+        }
+        n++;
+    }
+    SimDualScan = 1;
+    if(!n || err > 20) fail++;
+    printf("telemetry, dual without dual scan: %d instruments, TAvgF of both channels within %.1fC of CTemp  %s\n", n,
+        err / 2.0, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//Raw capture: half periods of random length fed through the ring with the ISR lag, the captured pairs
+//must follow each header in order, a small buffer counts the pairs which did not fit
+int CheckVICap(){
+    static const UINT32 Sizes[] = {2048, 100};
+    static UINT32 Buf[2048], Ref[2048];
+    static UINT32 VI[VIACC_RING];
+    t_VICap C;
+    t_VICapHdr H;
+    UINT32 rnd = 7, lost = 0, pairs = 0, want;
+    int z, h, s, n, due, len, fail = 0, halves = 0;
+
+    for(z = 0; z < 2; z++){
+        VICapInit(&C, Buf, Sizes[z]);
+        want = len = 0;
+        memset(&H, 0, sizeof(H));
+        for(h = 0; ; h++){
+            rnd = rnd * 1103515245 + 12345;
+            n = 2 + (rnd >> 8) % 255;
+            H.Ticks = h;
+            if(!VICapStart(&C, &H)) break;
+            if(C.Hdr != len) fail++;
+            len += VICAP_HDR_WORDS;
+            Ref[C.Hdr] = h;
+            due = -1;
+            for(s = 0; s < n; s++){
+                VI[s & VIACC_RING_MASK] = rnd ^ (s * 2654435761UL);
+                if(len < Sizes[z]) Ref[len++] = VI[s & VIACC_RING_MASK];
+                else want++;
+                if(!((s + 1) % VIACC_RING_HALF)) due = s + (rnd >> 16) % VIACC_RING_HALF;
+                if(s == due) VICapAdd(&C, VI, (s + 1) & VIACC_RING_MASK);
+            }
+            VICapAdd(&C, VI, n & VIACC_RING_MASK);
+            if(((t_VICapHdr *)&C.Buf[C.Hdr])->Cnt != len - C.Hdr - VICAP_HDR_WORDS || ((t_VICapHdr *)&C.Buf[C.Hdr])->Ticks != h) fail++;
+            Ref[C.Hdr] = C.Buf[C.Hdr];
+            halves++;
+            if(C.Lost) break;
+        }
+        if(C.Len != len || C.Lost != want || memcmp(Buf, Ref, len * sizeof(UINT32))) fail++;
+        if(z) lost += C.Lost;
+        else pairs += C.Len;
+    }
+    printf("raw capture: %d half periods, %u words in %u, %u pairs over a small buffer counted  %s\n", halves,
+        pairs, Sizes[0], lost, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//The default temperature screen of OLEDTasks for the PID state of the frame tick, drawn from a clear screen
+void CheckTempScreen(t_CheckScreen * S){
+    int dual = IronPars.Config[1].SensorConfig.Type;
+    t_PIDVars * PV1 = (t_PIDVars *)&PIDVars[0];
+    t_PIDVars * PV2 = dual ? (t_PIDVars *)&PIDVars[1] : PV1;
+    UINT8 b[65];
+    int i, p, df, AVG = PIDAVG();
+
+    S->DispTemp -= S->DispTemp >> 3;
+    S->DispTemp += dual ? (PV1->CTemp[0] + PV2->CTemp[0]) >> 1 : PV1->CTemp[0];
+    OLEDFill(0, 128, 0, 8, 0);
+    OLEDPrintNum3248(12, 1, (S->DispTemp >> 3) >> 1);
+    OLEDPrintCF1648(108, 1, 0);
+    OLEDPrint68(0, 0, (const char *)&IronPars.Name, 21);
+    OLEDPrint68(0, 7, "AC", 2);
+    OLEDPrint68(12, 7, &("FHQE")[PV1->Power], 1);
+    df = PV1->PIDDutyFull;
+    p = ((PV1->PIDDuty + 0x7FL) >> 8) * (PV1->HPAvg >> AVG);
+    if(dual){
+        df += PV2->PIDDutyFull;
+        p += ((PV2->PIDDuty + 0x7FL) >> 8) * (PV2->HPAvg >> AVG);
+    }
+    else{
+        df += df;
+    }
+    df >>= 19;
+    p = (p + 0x7FFFL) >> 16;
+    for(i = 0; i <= 64; i++){
+        b[i] = 0;
+        if(!(i & 1))b[i] += 16;
+        if(!(i & 15))b[i] += 40;
+        if(!(i & 31))b[i] += 68;
+        if(!(i & 63))b[i] += 130;
+        if(i && df){
+            df--;
+            b[i] =~ b[i];
+        }
+        b[i] &= 254;
+    }
+    for(i = 0; i <= 64; i++) OLEDBUFF.B[7][i + 31] = b[i];
+    if((ISRTicks & 15) == 1) S->Power = p;
+    OLEDPrintNum68(100, 7, 3, S->Power);
+    OLEDPrint68(118, 7, "W", 1);
+    if(HEATER) OLEDWrite(21, 8, 7, (char *)font8x8[4], 8);
+}
+
+//panel pages differing from OLEDBUFF, or with columns still marked
+static int OLEDDiffers(){
+    int r, c, n = 0, shift = DisplaySetup.SH1106 ? 2 : 0;
+    for(r = 0; r < 8; r++){
+        for(c = 0; c < 128 && HALOLED.RAM[r][c + shift] == OLEDBUFF.B[r][c]; c++);
+        if(c < 128 || OLEDDirty[r].L < OLEDDirty[r].R) n++;
+    }
+    return n;
+}
+
+//Random drawing through every OLED.c function with updates in between, sent blocking and on DMA: the panel
+//must show OLEDBUFF after each update although only the changed columns were sent, a rotation change sends
+//everything again and the same frame drawn again from a clear screen sends nothing
+int CheckOLEDUpdate(){
+    static t_OLEDFrame F;
+    UINT8 buf[32];
+    UINT32 rnd = 3, bytes, sent = 0, full = 0, updates = 0, dma = HALSPIDMABytes;
+    int k, i, w, h, x, y, fail = 0;
+
+    SPIAuto = 0;
+    OLEDInit();
+    if(OLEDDiffers()) fail++;
+    for(k = 0; k < 20000; k++){
+        SPIAuto = k >= 10000;
+        rnd = rnd * 1103515245 + 12345;
+        w = 1 + (rnd >> 8) % 16;
+        h = 1 + (rnd >> 12) % 2;
+        x = (rnd >> 16) % (129 - w);
+        y = (rnd >> 4) % 57;
+        for(i = 0; i < w * h; i++) buf[i] = rnd >> (i & 15);
+        switch((rnd >> 24) % 8){
+            case 0: OLEDFill(x, w, (rnd >> 4) % (9 - h), h, rnd >> 20); break;
+            case 1: OLEDFillXY(x, w, y, 1 + (rnd >> 10) % (64 - y), rnd & 0x100); break;
+            case 2: OLEDInvert(x, w, (rnd >> 4) % (9 - h), h); break;
+            case 3: OLEDInvertXY(x, w, y, 1 + (rnd >> 10) % (64 - y)); break;
+            case 4: OLEDWrite(x, w, (rnd >> 4) % (9 - h), buf, w * h); break;
+            case 5: OLEDWriteXY(x, w, (rnd >> 4) % (65 - 8 * h), buf, w * h); break;
+            case 6: OLEDPrintNumXY68(x % 100, y, 4, (int)(rnd % 20000) - 10000); break;
+            case 7: OLEDPrint816(x % 100, (rnd >> 4) % 7, "UniSolder", 3); break;
+        }
+        if((rnd >> 28) & 1) continue;
+        bytes = HALSPIBytes;
+        OLEDUpdate();
+        sent += HALSPIBytes - bytes;
+        full += 8 * (3 + 128);
+        updates++;
+        if(OLEDDiffers()){
+            if(fail < 10) printf("  update %u: %d pages differ\n", updates, OLEDDiffers());
+            fail++;
+        }
+        if(k % 100 == 99){
+            F = OLEDBUFF;
+            OLEDFill(0, 128, 0, 8, 0);
+            memcpy(OLEDBUFF.B, F.B, sizeof(F.B));
+            bytes = HALSPIBytes;
+            OLEDUpdate();
+            if(HALSPIBytes != bytes) fail++;
+        }
+        if(k % 1000 == 999){
+            pars.DispRot ^= 1;
+            memset(HALOLED.RAM, 0, sizeof(HALOLED.RAM));
+            OLEDUpdate();
+            if(OLEDDiffers()) fail++;
+        }
+    }
+    pars.DispRot = 0;
+    if(!(HALSPIDMABytes - dma)) fail++;
+    printf("OLED frame diff: %u random updates, %.0f%% of the bytes of whole frames sent, %.0f%% on DMA, panel matches  %s\n", updates,
+        100.0 * sent / full, 100.0 * (HALSPIDMABytes - dma) / sent, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//OLEDWriteXY before the column word blitter: every byte shifted and masked into two pages on its own
+static void RefWriteXY(int x, int colnum, int y, const UINT8 * buf, int num){
+    int row70 = y & 7;
+    int row71 = 8 - row70;
+    UINT8 mask0 = 0xFF >> row71;
+    UINT8 mask1 = 0xFF << row70;
+    if(!row70) return OLEDWrite(x, colnum, y >> 3, (void *)buf, num);
+    while(num){
+        int cc = colnum;
+        int buffRow = y >> 3;
+        while(num && cc--){
+            OLEDBUFF.B[buffRow][x] &= mask0;
+            OLEDBUFF.B[buffRow][x] |= *buf << row70;
+            OLEDBUFF.B[buffRow + 1][x] &= mask1;
+            OLEDBUFF.B[buffRow + 1][x++] |= *buf++ >> row71;
+            num--;
+        }
+        x -= colnum;
+        y += 8;
+    }
+}
+
+//OLEDPrintXY and OLEDPrintNumXY drawing each glyph with RefWriteXY and its blank columns with OLEDFillXY
+void RefOLEDPrintXY(int x, int y, const char * s, int num, const void * font, int startChar, int width, int height, int blank){
+    int cb = width * height;
+    if(num == 0) num = 128;
+    while(num-- && s[0]){
+        RefWriteXY(x, width, y, &((const UINT8 *)font)[cb * (s[0] - startChar)], cb);
+        OLEDFillXY(x + width, blank, y, height << 3, 0);
+        x += width + blank;
+        s++;
+    }
+}
+
+void RefOLEDPrintNumXY(int x, int y, int dec, int num, const void * font, int startChar, int width, int height, int blank){
+    int cb = width * height;
+    int cw = width + blank;
+    int i, cd;
+    int minus = 0;
+    if(num < 0){
+        num = -num;
+        minus = 1;
+    }
+    i = dec;
+    dec--;
+    x += cw * dec;
+    while(i--){
+        cd = num % 10;
+        num /= 10;
+        if(num || cd || (i == dec)){
+            RefWriteXY(x, width, y, &((const UINT8 *)font)[cb * (cd + 0x30 - startChar)], cb);
+            OLEDFillXY(x + width, blank, y, height << 3, 0);
+        }
+        else if(minus){
+            RefWriteXY(x, width, y, &((const UINT8 *)font)[cb * ('-' - startChar)], cb);
+            OLEDFillXY(x + width, blank, y, height << 3, 0);
+            minus = 0;
+        }
+        else{
+            OLEDFillXY(x, cw, y, height << 3, 0);
+        }
+        x -= cw;
+    }
+}
+
+//Text and glyphs at random pixel rows over random contents: the blitter must leave the same frame as the
+//byte-wise path, including the bits above and below the glyphs and the blank columns
+int CheckOLEDBlit(){
+    static t_OLEDFrame F0, R;
+    static const struct {
+        const t_OLEDFont * Font;
+        const void * Raw;
+    } Font[] = {
+        {&OLEDFont68, font6x8},
+        {&OLEDFont88, font8x8},
+        {&OLEDFont816, RawFont8x16},
+    };
+    const t_OLEDFont * F;
+    UINT8 buf[3 * 24];
+    char s[8];
+    UINT32 rnd = 7;
+    int k, i, f, w, h, x, y, n, v, fail = 0;
+
+    SPIAuto = 0;
+    OLEDInit();
+    for(k = 0; k < 30000; k++){
+        rnd = rnd * 1103515245 + 12345;
+        for(i = 0; i < sizeof(F0.B); i++) F0.B[i >> 7][i & 127] = (rnd >> (i % 24)) * (i + 1);
+        f = (rnd >> 4) % 3;
+        F = Font[f].Font;
+        n = 1 + (rnd >> 8) % 5;
+        x = (rnd >> 12) % (129 - n * (F->Width + F->Blank));
+        y = (rnd >> 20) % (65 - 8 * F->Height);
+        for(i = 0; i < n; i++) s[i] = 'A' + (rnd >> (i * 3)) % 26;
+        s[n] = 0;
+        for(i = 0; i < 2; i++){
+            OLEDBUFF = F0;
+            switch((rnd >> 28) % 3){
+                case 0:
+                    if(i) RefOLEDPrintXY(x, y, s, n, Font[f].Raw, F->Start, F->Width, F->Height, F->Blank);
+                    else OLEDPrintXY(x, y, s, n, F);
+                    break;
+                case 1:
+                    v = (int)(rnd % 20000) - 10000;
+                    if(i) RefOLEDPrintNumXY(x, y, n, v, Font[f].Raw, F->Start, F->Width, F->Height, F->Blank);
+                    else OLEDPrintNumXY(x, y, n, v, F);
+                    break;
+                default:
+                    w = 1 + (rnd >> 8) % 24;
+                    h = 1 + (rnd >> 14) % 3;
+                    y = (rnd >> 20) % (65 - 8 * h);
+                    x = (rnd >> 12) % (129 - w);
+                    memcpy(buf, RawFont8x16[32 + (rnd >> 16) % 64], sizeof(buf));
+                    if(i) RefWriteXY(x, w, y, buf, w * h);
+                    else OLEDWriteXY(x, w, y, buf, w * h);
+                    break;
+            }
+            if(!i) R = OLEDBUFF;
+        }
+        if(memcmp(R.B, OLEDBUFF.B, sizeof(R.B))){
+            if(fail < 10) printf("  case %d: font %d x %d y %d differs\n", k, f, x, y);
+            fail++;
+        }
+    }
+    OLEDInit();
+    printf("OLED glyph blitter: %d random texts, numbers and glyphs at pixel rows match the byte-wise path  %s\n", k, fail ? "FAIL" : "ok");
+    return fail;
+}
+
+//Flash of a packed set of n glyphs: the codes and literals up to the end of the last glyph and the offset tables
+int CheckPackedSize(const t_OLEDPacked * P, int n){
+    const UINT8 * s = &P->Data[P->Base[(n - 1) >> P->Shift] + P->Offs[n - 1]];
+    UINT8 codes = 0;
+    int i;
+    for(i = 0; i < P->Width * P->Height; i++, codes >>= 2){
+        if(!(i & 3)) codes = *s++;
+        if((codes & 3) == 3) s++;
+    }
+    return (s - P->Data) + 2 * (((n - 1) >> P->Shift) + 1) + n;
+}
+
+//Every packed glyph drawn by OLED.c against its raw bitmap drawn the way the firmware did before fontpack: the
+//temperature digits and C/F, the 8x16 font at pages and the boot logo
+int CheckFontPack(){
+    static t_OLEDFrame F;
+    int g, i, x, y, raw, packed, fail = 0;
+
+    SPIAuto = 0;
+    OLEDInit();
+    for(g = 0; g < 12; g++){
+        OLEDFill(0, 128, 0, 8, 0x5A);
+        OLEDWrite(10, 32, 1, (void *)RawNumbers32x48[g], 192);
+        OLEDWrite(60, 16, 2, (void *)&RawNumbers32x48[g][0], 16);
+        OLEDWrite(60, 16, 3, (void *)&RawNumbers32x48[g][32], 16);
+        OLEDWrite(60, 16, 4, (void *)&RawNumbers32x48[g][64], 16);
+        OLEDWrite(60, 16, 5, (void *)&RawNumbers32x48[g][96], 16);
+        OLEDWrite(60, 16, 6, (void *)&RawNumbers32x48[g][128], 16);
+        F = OLEDBUFF;
+        OLEDFill(0, 128, 0, 8, 0x5A);
+        OLEDWritePacked(10, 32, 1, 6, &numbers32x48Packed, g);
+        OLEDWritePacked(60, 16, 2, 5, &numbers32x48Packed, g);
+        if(memcmp(F.B, OLEDBUFF.B, sizeof(F.B))) fail++;
+    }
+    for(g = 0; g < 128; g++){
+        char s[2] = {g ? g : ' ', 0};
+        OLEDFill(0, 128, 0, 8, 0xA5);
+        OLEDWrite(3, 8, 5, (void *)RawFont8x16[(UINT8)s[0]], 16);
+        F = OLEDBUFF;
+        OLEDFill(0, 128, 0, 8, 0xA5);
+        OLEDPrint816(3, 5, s, 1);
+        if(memcmp(F.B, OLEDBUFF.B, sizeof(F.B))) fail++;
+    }
+    i = 1023;
+    for(x = 0; x < 128; x++){
+        for(y = 0; y < 8; y++){
+            F.B[y][x] = ~RawLogo[i--];
+        }
+    }
+    OLEDFill(0, 128, 0, 8, 0);
+    OLEDWritePacked(0, 128, 0, 8, &logoPacked, 0);
+    if(memcmp(F.B, OLEDBUFF.B, sizeof(F.B))) fail++;
+    OLEDInit();
+    raw = sizeof(RawNumbers32x48) + sizeof(RawFont8x16) + sizeof(RawLogo);
+    packed = CheckPackedSize(&numbers32x48Packed, 12) + CheckPackedSize(&font8x16Packed, 128) + CheckPackedSize(&logoPacked, 1);
+    printf("packed bitmaps: 32x48 digits, 8x16 font and logo decode to the raw ones, %d bytes of flash in %d  %s\n", packed, raw,
+        fail ? "FAIL" : "ok");
+    return fail;
+}
@@ -0,0 +1,56 @@
+/*
+ * File:   check.h
+ *
+ * Host checks of the control core, run by ussim -T.
+ */
+
+#ifndef CHECK_H
+#define	CHECK_H
+
+#include <GenericTypeDefs.h>
+#include "sensorMath.h"
+#include "OLED.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#define CHECK_VI_SAMPLES 256     //longest capture of a heated half period
+
+//State of the default temperature screen drawn by CheckTempScreen
+typedef struct {
+    int DispTemp;               //menu.c DispTemp, filtered temperature * 8
+    int Power;                  //OLEDPower, the watts shown
+}t_CheckScreen;
+
+extern int CheckSensorLUT();
+extern int CheckVIAcc();
+extern int CheckIronOvr();
+extern int CheckParsJournal();
+extern int CheckI2CSched();
+extern int CheckI2CShadow();
+extern int CheckLiveRecs();
+extern int CheckTlmDual();
+extern int CheckVICap();
+extern int CheckOLEDUpdate();
+extern int CheckOLEDBlit();
+extern int CheckFontPack();
+
+extern const char RawNumbers32x48[12][192];
+extern const UINT8 RawFont8x16[128][16];
+extern const UINT8 RawLogo[1024];
+
+extern UINT32 RefSqrt(UINT32 n);
+extern void RefVIMeasure(const UINT32 * VBuff, const UINT32 * TIBuff, UINT32 VTIBuffCnt, UINT32 dw, int * HV, int * HI, int * HP, int * HR);
+extern void CheckVIWave(UINT32 * V, UINT32 * I, double * C, int n, double vpk, double ohms, UINT32 * rnd);
+extern UINT32 CheckVIRingFeed(t_VIAcc * A, UINT32 * VI, const UINT32 * V, const UINT32 * I, int n, int lag);
+extern void CheckTempScreen(t_CheckScreen * S);
+extern int CheckPackedSize(const t_OLEDPacked * P, int n);
+extern void RefOLEDPrintXY(int x, int y, const char * s, int num, const void * font, int startChar, int width, int height, int blank);
+extern void RefOLEDPrintNumXY(int x, int y, int dec, int num, const void * font, int startChar, int width, int height, int blank);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CHECK_H */
@@ -0,0 +1,107 @@
+/*
+ * File:   fontpack.c
+ *
+ * Packs the large firmware bitmaps (font32x48numbers.h, font8x16.h, logo.h) into fontspacked.h, which OLED.c
+ * decodes while drawing. Run by make fonts after one of the bitmap headers changed.
+ *
+ * The packed format is described with t_OLEDPacked in OLED.h.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <GenericTypeDefs.h>
+#include "font32x48numbers.h"
+#include "font8x16.h"
+#include "logo.h"
+
+#define PACK_MAX 8192
+
+typedef struct {
+    const char * Name;
+    const char * Source;
+    int Glyphs;
+    int Width;
+    int Height;
+    UINT8 Raw[PACK_MAX];
+}t_PackSet;
+
+static UINT8 Data[PACK_MAX];
+static int Offs[256];
+
+//Codes of one glyph of n bytes appended at Data[len], returns the new length
+static int PackGlyph(const UINT8 * g, int n, int len){
+    int i, code = 0, prev = 0;
+    for(i = 0; i < n; i++){
+        int c;
+        if(!(i & 3)) Data[code = len++] = 0;
+        if(g[i] == 0) c = 0;
+        else if(g[i] == 0xFF) c = 1;
+        else if(g[i] == prev) c = 2;
+        else{
+            c = 3;
+            Data[len++] = g[i];
+        }
+        Data[code] |= c << ((i & 3) << 1);
+        prev = g[i];
+    }
+    return len;
+}
+
+static void PackArray(const char * type, const char * name, const char * part, const void * a, int size, int n){
+    int i;
+    printf("static const %s %s%s[%d] = {", type, name, part, n);
+    for(i = 0; i < n; i++){
+        if(!(i & 15)) printf("\n   ");
+        if(size == 2) printf(" 0x%04X,", ((const UINT16 *)a)[i]);
+        else printf(" 0x%02X,", ((const UINT8 *)a)[i]);
+    }
+    printf("\n};\n\n");
+}
+
+//Packed set with the largest blocks whose glyph offsets from the block start fit in a UINT8
+static void PackSet(const t_PackSet * S){
+    UINT16 base[256];
+    UINT8 offs[256];
+    int i, len = 0, shift, gs = S->Width * S->Height;
+
+    for(i = 0; i < S->Glyphs; i++){
+        Offs[i] = len;
+        len = PackGlyph(&S->Raw[i * gs], gs, len);
+    }
+    for(shift = 7; shift > 0; shift--){
+        for(i = 0; i < S->Glyphs && Offs[i] - Offs[i & ~((1 << shift) - 1)] < 256; i++);
+        if(i == S->Glyphs) break;
+    }
+    for(i = 0; i < S->Glyphs; i++){
+        base[i >> shift] = Offs[i & ~((1 << shift) - 1)];
+        offs[i] = Offs[i] - base[i >> shift];
+    }
+    printf("//%s: %d glyph%s of %dx%d, %d bytes packed to %d\n", S->Source, S->Glyphs, S->Glyphs > 1 ? "s" : "", S->Width, S->Height * 8,
+        S->Glyphs * gs, len + ((S->Glyphs + (1 << shift) - 1) >> shift) * 2 + S->Glyphs);
+    PackArray("UINT16", S->Name, "Base", base, 2, (S->Glyphs + (1 << shift) - 1) >> shift);
+    PackArray("UINT8", S->Name, "Offs", offs, 1, S->Glyphs);
+    PackArray("UINT8", S->Name, "Data", Data, 1, len);
+    printf("const t_OLEDPacked %sPacked = {%d, %d, %d, %sBase, %sOffs, %sData};\n\n", S->Name, S->Width, S->Height, shift,
+        S->Name, S->Name, S->Name);
+}
+
+int main(){
+    static t_PackSet Set[] = {
+        {"numbers32x48", "font32x48numbers.h", 12, 32, 6},
+        {"font8x16", "font8x16.h", 128, 8, 2},
+        {"logo", "logo.h", 1, 128, 8},
+    };
+    int i;
+
+    memcpy(Set[0].Raw, numbers32x48, sizeof(numbers32x48));
+    memcpy(Set[1].Raw, font8x16, sizeof(font8x16));
+    //the logo is stored a column at a time from the bottom right and inverted, OLEDBUFF wants it a page at a time
+    for(i = 0; i < 1024; i++) Set[2].Raw[((1023 - i) & 7) * 128 + ((1023 - i) >> 3)] = ~logo[i];
+
+    printf("/*\n * File:   fontspacked.h\n *\n");
+    printf(" * Generated by US_Simulator/fontpack (make fonts) from font32x48numbers.h, font8x16.h and logo.h, do not edit.\n");
+    printf(" */\n\n");
+    printf("#ifndef FONTSPACKED_H\n#define\tFONTSPACKED_H\n\n#ifdef\t__cplusplus\nextern \"C\" {\n#endif\n\n");
+    for(i = 0; i < sizeof(Set) / sizeof(Set[0]); i++) PackSet(&Set[i]);
+    printf("#ifdef\t__cplusplus\n}\n#endif\n\n#endif\t/* FONTSPACKED_H */\n");
+    return 0;
+}
@@ -0,0 +1,340 @@
+/*
+ * File:   hal.c
+ *
+ * Host side of the MCU: port pins, ADC, SPI, USB HID, the I2C bus with the EEPROM, and the
+ * globals owned by the firmware modules that are not part of the host build (main.c, isr.c).
+ */
+#define _HAL_C
+#define _ISR_C
+
+#include <GenericTypeDefs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mcu.h"
+#include "isr.h"
+#include "main.h"
+#include "EEP.h"
+#include "OLED.h"
+
+volatile halpins_t HALPins;
+volatile int mcuADCRES;
+UINT16 HALIDADC[2] = {1023, 1023};
+
+/****** main.c ****************************************************************/
+volatile T_BOARD_VERSION BoardVersion = BOARD_HW_5_2C;
+volatile unsigned int   BeepTicks;
+volatile unsigned int   InvertTicks;
+volatile unsigned int   POWER_DUTY;
+volatile unsigned int   MAINS_PER;
+volatile unsigned int   MAINS_PER_US;
+volatile unsigned int   MAINS_PER_H_US;
+volatile unsigned int   MAINS_PER_Q_US;
+volatile unsigned int   MAINS_PER_E_US;
+volatile unsigned int   T_PER;
+volatile mainflags_t    mainFlags;
+volatile int            CalCh;
+volatile unsigned int   TTemp;
+volatile pars_t         pars;
+volatile int            Enc;
+/******************************************************************************/
+
+static int ADCCh;
+
+void mcuADCStop(){
+}
+
+void mcuADCStartManualVRef(){
+}
+
+void mcuADCStartManualAVdd(){
+}
+
+void mcuADCRead(int ADCCH, int num){
+    ADCCh = ADCCH;
+}
+
+int mcuADCReadWait(int ADCCH, int num){
+    mcuADCRead(ADCCH, num);
+    if(ADCCh == ADCH_ID) return HALIDADC[HCH ? 1 : 0] * num;
+    return 0;
+}
+
+/****** isr.c *****************************************************************/
+void ISRStop(){
+    ISRStopped = 3;
+}
+
+void ISRStart(){
+    ISRStopped = 0;
+}
+/******************************************************************************/
+
+/****** SPI ******************************************************************/
+UINT32 HALSPIBytes;
+UINT32 HALSPIDMABytes;
+UINT32 HALSPIDMAInts;
+volatile int SPIAuto;
+t_HALOLED HALOLED;
+
+void mcuSPIOpen(){
+}
+
+void mcuSPIClose(){
+}
+
+//Page addressing mode of the SSD1306/SH1106: data bytes go to the current page from the current column on,
+//the commands with arguments used by OLED.c are skipped whole
+void mcuSPISendByte(unsigned int b){
+    HALSPIBytes++;
+    b &= 0xFF;
+    if(OLED_DC){
+        if(HALOLED.Col < HAL_OLED_COLS) HALOLED.RAM[HALOLED.Page][HALOLED.Col++] = b;
+    }
+    else if(HALOLED.Args){
+        HALOLED.Args--;
+    }
+    else if(b < 0x10){
+        HALOLED.Col = (HALOLED.Col & 0xF0) | b;
+    }
+    else if(b < 0x20){
+        HALOLED.Col = (HALOLED.Col & 0x0F) | ((b & 15) << 4);
+    }
+    else if(b >= 0xB0 && b <= 0xB7){
+        HALOLED.Page = b & 7;
+    }
+    else if(b == 0x21 || b == 0x22){
+        HALOLED.Args = 2;
+    }
+    else if(b == 0x20 || b == 0x81 || b == 0x8D || b == 0xAD || b == 0xA8 || b == 0xD3 || b == 0xD5 || b == 0xD9 || b == 0xDA || b == 0xDB){
+        HALOLED.Args = 1;
+    }
+}
+
+void mcuSPISendBytes(unsigned int * b, int n){
+    const UINT8 * p = (const UINT8 *)b;
+    while(n--) mcuSPISendByte(*p++);
+}
+
+//The DMA transfer completes at once, the block done interrupt follows it
+void mcuSPIStartAuto(void * buff, int len){
+    HALSPIDMABytes += len;
+    HALSPIDMAInts++;
+    mcuSPISendBytes(buff, len);
+    OLEDDMATasks();
+}
+
+void mcuSPIWait(){
+}
+
+void mcuSPIStop(){
+}
+/******************************************************************************/
+
+/****** USB HID ***************************************************************/
+void USBDriverInit(){
+    USBInHandle = 0;
+    USBOutHandle = 0;
+}
+
+void USBDeviceTasks(){
+}
+
+USB_HANDLE HIDTxPacket(BYTE ep, BYTE * data, WORD len){
+    memcpy(HALUSBIn, data, len);
+    HALUSBInReports++;
+    return (USB_HANDLE)HALUSBIn;
+}
+
+USB_HANDLE HIDRxPacket(BYTE ep, BYTE * data, WORD len){
+    return (USB_HANDLE)data;
+}
+/******************************************************************************/
+
+/****** I2C bus and 24LC64 ****************************************************/
+#define HAL_I2C_BIT (1e6 / I2C_CLOCK_FREQ)
+
+double HALI2CTime;
+t_HALI2CStats HALI2CStats;
+UINT8 HALEEP[HAL_EEP_SIZE];
+UINT32 HALEEPReads;
+UINT32 HALEEPWrites;
+
+static struct {
+    int Pending;            //I2C interrupt raised at Due
+    double Due;
+    int Dev;                //addressed device, -1 if none
+    int Phase;              //bytes after the device address
+    int ACK;                //acknowledge of the last byte sent
+    UINT8 RxByte;
+    UINT16 Ptr;             //EEPROM address pointer
+    UINT8 Page[EEP_PAGE];   //EEPROM page buffer, written into HALEEP at the stop
+    UINT32 PageMask;
+    double Ready;           //end of the EEPROM write cycle
+    int Used;
+    UINT8 Buf[8];           //bytes sent to a pot or the DAC after the device address
+}HALI2C;
+
+HALPotsS HALPots;
+
+//Pot and DAC registers written by the transaction in HALI2C.Buf
+static void HALPotWrite(int n){
+    int i;
+    if(HALI2C.Dev == CPOT){
+        for(i = 0; i + 1 < n; i += 2){
+            int a = HALI2C.Buf[i] >> 4, v = ((HALI2C.Buf[i] & 1) << 8) | HALI2C.Buf[i + 1];
+            if(a == 4) HALPots.TCON = v;
+            else if(a < 2) HALPots.Current[a] = v;
+        }
+    }
+    else if(HALI2C.Dev == GAINPOT){
+        if(n >= 2) HALPots.Gain = ((HALI2C.Buf[0] & 1) << 8) | HALI2C.Buf[1];
+    }
+    else if(HALI2C.Dev == OFFADC){
+        if(n >= 3) HALPots.Offset = (HALI2C.Buf[1] << 2) | (HALI2C.Buf[2] >> 6);
+    }
+    else return;
+    HALPots.Writes++;
+    HALPots.Bytes += n + 1;
+}
+
+void HALEEPErase(){
+    memset(HALEEP, 0xFF, sizeof(HALEEP));
+    HALI2C.Used = 1;
+}
+
+void HALI2CReset(){
+    int used = HALI2C.Used;
+    memset(&HALI2C, 0, sizeof(HALI2C));
+    memset(&HALI2CStats, 0, sizeof(HALI2CStats));
+    HALPots.Writes = 0;
+    HALPots.Bytes = 0;
+    HALI2C.Used = used;
+    HALI2C.Dev = -1;
+    HALI2CTime = 0;
+    HALEEPReads = 0;
+    HALEEPWrites = 0;
+}
+
+//Bus operation of bits clock periods, the interrupt follows its end
+static void HALI2COp(int bits){
+    double t = bits * HAL_I2C_BIT;
+    HALI2CStats.Busy += t;
+    HALI2C.Pending = 1;
+    HALI2C.Due = HALI2CTime + t + HAL_I2C_LAT;
+}
+
+int HALI2CRun(){
+    if(!HALI2C.Pending) return 0;
+    HALI2C.Pending = 0;
+    if(HALI2CTime < HALI2C.Due) HALI2CTime = HALI2C.Due;
+    HALI2CStats.Ints++;
+    I2CISRTasks();
+    return 1;
+}
+
+void HALI2CIdle(){
+    if(!HALI2CRun()){
+        fprintf(stderr, "I2C: waiting for a transfer with the bus idle\n");
+        abort();
+    }
+}
+
+void HALI2CRunUntil(double t){
+    while(HALI2C.Pending && (HALI2C.Due <= t)) HALI2CRun();
+    if(HALI2CTime < t) HALI2CTime = t;
+}
+
+double HALEEPReady(){
+    return HALI2C.Ready;
+}
+
+//The interrupt is taken at once, as on the MCU
+void mcuI2CWakeUp(){
+    HALI2C.Pending = 1;
+    HALI2C.Due = HALI2CTime + HAL_I2C_LAT;
+    HALI2CRun();
+}
+
+void mcuI2CStart(){
+    if(!HALI2C.Used) HALEEPErase();
+    HALI2CStats.Starts++;
+    HALI2C.Dev = -1;
+    HALI2C.Phase = 0;
+    HALI2C.PageMask = 0;
+    HALI2COp(1);
+}
+
+void mcuI2CStop(){
+    int i;
+    if((HALI2C.Dev == EEP) && HALI2C.PageMask){
+        for(i = 0; i < EEP_PAGE; i++){
+            if(HALI2C.PageMask & (1UL << i)) HALEEP[(HALI2C.Ptr & ~(EEP_PAGE - 1)) + i] = HALI2C.Page[i];
+        }
+        HALI2C.Ready = HALI2CTime + HAL_I2C_BIT + HAL_EEP_TWC;
+        HALEEPWrites++;
+    }
+    else if(HALI2C.Dev >= 0 && HALI2C.Phase > 1){
+        HALPotWrite(HALI2C.Phase - 1);
+    }
+    HALI2C.Dev = -1;
+    HALI2C.PageMask = 0;
+    HALI2COp(1);
+}
+
+void mcuI2CSendByte(UINT8 b){
+    HALI2CStats.Bytes++;
+    HALI2C.ACK = 1;
+    if(HALI2C.Phase == 0){
+        if((b & 0xFE) == EEP){
+            if(HALI2CTime < HALI2C.Ready){
+                HALI2C.ACK = 0;
+                HALI2CStats.NACKs++;
+            }
+            else{
+                HALI2C.Dev = EEP;
+                if(b & 1) HALEEPReads++;
+            }
+        }
+        else HALI2C.Dev = b;
+    }
+    else if(HALI2C.Dev == EEP){
+        if(HALI2C.Phase == 1) HALI2C.Ptr = (HALI2C.Ptr & 0xFF) | ((b << 8) & (HAL_EEP_SIZE - 1));
+        else if(HALI2C.Phase == 2) HALI2C.Ptr = (HALI2C.Ptr & 0xFF00) | b;
+        else{
+            HALI2C.Page[HALI2C.Ptr & (EEP_PAGE - 1)] = b;
+            HALI2C.PageMask |= 1UL << (HALI2C.Ptr & (EEP_PAGE - 1));
+            HALI2C.Ptr = (HALI2C.Ptr & ~(EEP_PAGE - 1)) | ((HALI2C.Ptr + 1) & (EEP_PAGE - 1));
+        }
+    }
+    else if(HALI2C.Dev < 0) HALI2C.ACK = 0;
+    else if(HALI2C.Phase <= sizeof(HALI2C.Buf)) HALI2C.Buf[HALI2C.Phase - 1] = b;
+    HALI2C.Phase++;
+    HALI2COp(9);
+}
+
+void mcuI2CReceiverEnable(){
+    HALI2CStats.Bytes++;
+    HALI2C.RxByte = (HALI2C.Dev == EEP) ? HALEEP[HALI2C.Ptr] : 0xFF;
+    HALI2C.Ptr = (HALI2C.Ptr + 1) & (HAL_EEP_SIZE - 1);
+    HALI2COp(8);
+}
+
+void mcuI2CReceiverDisable(){
+}
+
+UINT8 mcuI2CGetByte(){
+    return HALI2C.RxByte;
+}
+
+int mcuI2CIsACK(){
+    return HALI2C.ACK;
+}
+
+void mcuI2CACK(){
+    HALI2COp(1);
+}
+/******************************************************************************/
+
+#undef _ISR_C
+#undef _HAL_C
@@ -0,0 +1,54 @@
+/* 
+ * File:   GenericTypeDefs.h
+ *
+ * Host build replacement for the Microchip GenericTypeDefs.h.
+ * Only the types used by the firmware are defined, with the same sizes as on PIC32.
+ */
+
+#ifndef __GENERIC_TYPE_DEFS_H_
+#define	__GENERIC_TYPE_DEFS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+typedef enum _BOOL { FALSE = 0, TRUE } BOOL;
+
+typedef int8_t      INT8;
+typedef int16_t     INT16;
+typedef int32_t     INT32;
+typedef int64_t     INT64;
+typedef uint8_t     UINT8;
+typedef uint16_t    UINT16;
+typedef uint32_t    UINT32;
+typedef uint64_t    UINT64;
+typedef unsigned int UINT;
+typedef int         INT;
+
+typedef uint8_t     BYTE;
+typedef uint16_t    WORD;
+typedef uint32_t    DWORD;
+
+typedef union{
+    UINT16 Val;
+    UINT8 v[2];
+    struct{
+        UINT8 LB;
+        UINT8 HB;
+    } byte;
+}UINT16_VAL;
+
+typedef union{
+    UINT32 Val;
+    UINT16 w[2];
+    UINT8 v[4];
+}UINT32_VAL;
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* __GENERIC_TYPE_DEFS_H_ */
@@ -0,0 +1,253 @@
+/*
+ * File:   hal.h
+ *
+ * Host build replacement for PIC32MX564F128H.h, included by mcu.h when HOST_BUILD is defined.
+ * Port pins are plain variables, timers and delays are no-ops and the ADC reads
+ * are answered by the simulator, so the control core can run on a PC.
+ */
+
+#ifndef HAL_H
+#define	HAL_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <GenericTypeDefs.h>
+
+#ifdef _HAL_C
+#define HAL_EXTERN
+#else
+#define HAL_EXTERN extern
+#endif
+
+#define SYS_FREQ                    (80000000UL)
+#define CORETIMER_FREQ              (SYS_FREQ/2UL)
+#define PER_FREQ                    (SYS_FREQ/2UL)
+#define I2C_CLOCK_FREQ              (400000UL)
+#define HAL_EEP_SIZE                8192            //24LC64
+#define APP_CRC_VALUE               0x5AA5          //no application image CRC on the host
+
+#define _delay_us(a)
+#define _delay_ms(a)
+
+#ifndef min
+#define min(a,b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a,b) (((a) > (b)) ? (a) : (b))
+#endif
+
+
+typedef struct {
+    int HEATER;
+    int HCH;
+    int CBANDA;
+    int CBANDB;
+    int CHSEL1;
+    int CHSEL2;
+    int CHPOL;
+    int ID_OUT;
+    int ID_3S;
+    int PGC;
+    int PGD;
+    int OLED_VCC;
+    int OLED_VDD;
+    int OLED_RES;
+    int OLED_DC;
+    int OLED_CS;
+    int OLED_SCK;
+    int OLED_SDI;
+    int OLED_SDO;
+    int OLED_RES_3S;
+    int OLED_DC_3S;
+    int OLED_CS_3S;
+    int OLED_DC_PU;
+    int OLED_CS_PU;
+    int SCK_3S;
+    int SDI_3S;
+    int SDO_3S;
+    int MAINS;
+    int NAP;
+    int B1;
+    int B2;
+    int B3;
+    int SPEAKER;
+}halpins_t;
+
+HAL_EXTERN volatile halpins_t HALPins;
+
+//outputs
+#define HEATER      HALPins.HEATER
+#define HCH         HALPins.HCH
+#define CBANDA      HALPins.CBANDA
+#define CBANDB      HALPins.CBANDB
+#define CHSEL1      HALPins.CHSEL1
+#define CHSEL2      HALPins.CHSEL2
+#define CHPOL       HALPins.CHPOL
+#define OLED_VCC    HALPins.OLED_VCC
+#define OLED_VDD    HALPins.OLED_VDD
+#define OLED_RES    HALPins.OLED_RES
+#define OLED_DC     HALPins.OLED_DC
+#define OLED_CS     HALPins.OLED_CS
+#define OLED_SCK    HALPins.OLED_SCK
+#define OLED_SDI    HALPins.OLED_SDI
+#define OLED_SDO    HALPins.OLED_SDO
+#define ID_OUT      HALPins.ID_OUT
+#define PGC         HALPins.PGC
+#define PGD         HALPins.PGD
+#define SPEAKER     HALPins.SPEAKER
+#define SPKON       if(!SPEAKER)SPEAKER=1
+#define SPKOFF      if(SPEAKER)SPEAKER=0
+
+//inputs
+#define NAP         HALPins.NAP
+#define ID_3S       HALPins.ID_3S
+#define MAINS       HALPins.MAINS
+#define B1          HALPins.B1
+#define B2          HALPins.B2
+#define B3          HALPins.B3
+#define OLED_DC_IN  OLED_DC
+#define OLED_CS_IN  OLED_CS
+
+#define OLED_RES_3S HALPins.OLED_RES_3S
+#define OLED_DC_3S  HALPins.OLED_DC_3S
+#define OLED_CS_3S  HALPins.OLED_CS_3S
+#define OLED_DC_PU  HALPins.OLED_DC_PU
+#define OLED_CS_PU  HALPins.OLED_CS_PU
+#define SCK_3S      HALPins.SCK_3S
+#define SDI_3S      HALPins.SDI_3S
+#define SDO_3S      HALPins.SDO_3S
+#define SDI_OUT     OLED_SDI
+#define SDO_OUT     OLED_SDO
+
+//I2C devices
+#define CPOT 0b01011110
+#define GAINPOT 0b01011100
+#define OFFADC 0b11000000
+#define EEP 0b10100000
+
+#define mcuReset()
+#define mcuJumpToBootLoader()
+
+#define mcuDisableInterrupts() 0
+#define mcuEnableInterrupts()
+#define mcuRestoreInterrupts(a) ((void)(a))
+
+//ADC channels
+#define ADCH_VIN    3
+#define ADCH_VSHUNT 4
+#define ADCH_TEMP   5
+#define ADCH_HOLDER 13
+#define ADCH_RT     14
+#define ADCH_ID     15
+
+HAL_EXTERN volatile int mcuADCRES;
+HAL_EXTERN UINT16 HALIDADC[2];      //ID resistor ADC reading (0-1023) with HCH low/high, set by the simulator
+HAL_EXTERN void mcuADCStop();
+HAL_EXTERN void mcuADCStartManualVRef();
+HAL_EXTERN void mcuADCStartManualAVdd();
+HAL_EXTERN void mcuADCRead(int ADCCH, int num);
+HAL_EXTERN int mcuADCReadWait(int ADCCH, int num);
+
+//SPI to the display: the bytes are counted and fed to a model of the controller, RAM has what the panel shows
+#define HAL_OLED_COLS 132
+#define HAL_SPI_BYTE_US 1.2         //SPI3 at PBCLK / 6 = 6.67MHz
+
+typedef struct {
+    UINT8 RAM[8][HAL_OLED_COLS];
+    int Page;
+    int Col;
+    int Args;               //arguments of the last command still to come
+}t_HALOLED;
+
+HAL_EXTERN UINT32 HALSPIBytes;
+HAL_EXTERN UINT32 HALSPIDMABytes;   //bytes of the display DMA transfers
+HAL_EXTERN UINT32 HALSPIDMAInts;    //their block done interrupts
+HAL_EXTERN volatile int SPIAuto;
+HAL_EXTERN t_HALOLED HALOLED;
+HAL_EXTERN void mcuSPIOpen();
+HAL_EXTERN void mcuSPIClose();
+HAL_EXTERN void mcuSPISendByte(unsigned int b);
+HAL_EXTERN void mcuSPISendBytes(unsigned int * b, int n);
+#define mcuSPIIsBusy() 0
+HAL_EXTERN void mcuSPIStartAuto(void * buff, int len);
+HAL_EXTERN void mcuSPIWait();
+HAL_EXTERN void mcuSPIStop();
+
+//USB HID endpoint of io.c: the device is never configured, HIDTxPacket keeps the last IN report
+#define USB_HANDLE void*
+#define HID_EP 1
+#define CONFIGURED_STATE 32
+
+HAL_EXTERN int USBDeviceState;
+HAL_EXTERN int USBSuspendControl;
+HAL_EXTERN volatile USB_HANDLE USBInHandle;
+HAL_EXTERN volatile USB_HANDLE USBOutHandle;
+HAL_EXTERN UINT8 HALUSBIn[64];
+HAL_EXTERN UINT32 HALUSBInReports;
+HAL_EXTERN void USBDriverInit();
+HAL_EXTERN void USBDeviceTasks();
+HAL_EXTERN USB_HANDLE HIDTxPacket(BYTE ep, BYTE * data, WORD len);
+HAL_EXTERN USB_HANDLE HIDRxPacket(BYTE ep, BYTE * data, WORD len);
+#define HIDTxHandleBusy(h) 0
+#define HIDRxHandleBusy(h) 1
+
+//I2C bus at I2C_CLOCK_FREQ with a 24LC64 at EEP and the pots and the offset DAC, which acknowledge everything.
+//Every bus operation raises the I2C interrupt (I2CISRTasks) when it would be complete on the real bus, the time
+//advances from one interrupt to the next in HALI2CRun and in HALI2CRunUntil
+#define HAL_EEP_TWC     5000            //24LC64 write cycle, us
+#define HAL_I2C_LAT     1               //interrupt latency, us
+
+typedef struct {
+    UINT32 Ints;            //I2CISRTasks calls
+    UINT32 Starts;          //start and repeated start conditions
+    UINT32 Bytes;           //bytes sent or received
+    UINT32 NACKs;           //addressing of the EEPROM during its write cycle
+    double Busy;            //us of bus activity
+}t_HALI2CStats;
+
+//Registers of the pots and the offset DAC as written over the bus
+typedef struct {
+    UINT16 Current[2];      //CPOT wipers
+    UINT16 TCON;
+    UINT16 Gain;
+    UINT16 Offset;
+    UINT32 Writes;          //transactions
+    UINT32 Bytes;           //bytes of the transactions, with the device address
+}HALPotsS;
+
+HAL_EXTERN double HALI2CTime;           //bus time, us
+HAL_EXTERN HALPotsS HALPots;
+HAL_EXTERN t_HALI2CStats HALI2CStats;
+HAL_EXTERN void HALI2CReset();
+HAL_EXTERN int HALI2CRun();             //run the pending interrupt, 0 if there is none
+HAL_EXTERN void HALI2CRunUntil(double t);
+HAL_EXTERN void HALI2CIdle();           //run the pending interrupt, stops the program if there is none
+HAL_EXTERN double HALEEPReady();        //bus time at which the EEPROM write cycle ends
+HAL_EXTERN void mcuI2CStart();
+HAL_EXTERN void mcuI2CStop();
+HAL_EXTERN void mcuI2CSendByte(UINT8 b);
+HAL_EXTERN void mcuI2CReceiverEnable();
+HAL_EXTERN void mcuI2CReceiverDisable();
+HAL_EXTERN UINT8 mcuI2CGetByte();
+HAL_EXTERN int mcuI2CIsACK();
+HAL_EXTERN void mcuI2CACK();
+HAL_EXTERN void mcuI2CWakeUp();
+#define mcuI2CSendAddrW(b) mcuI2CSendByte(b)
+#define mcuI2CSendAddrR(b) mcuI2CSendByte((b) | 1)
+#define mcuI2CIdle() HALI2CIdle()
+#define mcuReadCoreTimer() ((UINT32)(HALI2CTime * (CORETIMER_FREQ / 1000000)))
+
+HAL_EXTERN UINT8 HALEEP[HAL_EEP_SIZE];  //EEPROM contents
+HAL_EXTERN UINT32 HALEEPReads;          //EEPROM read transactions
+HAL_EXTERN UINT32 HALEEPWrites;         //EEPROM write cycles
+HAL_EXTERN void HALEEPErase();
+
+#undef HAL_EXTERN
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HAL_H */
@@ -0,0 +1,11 @@
+/* 
+ * File:   xc.h
+ *
+ * Host build replacement for the XC32 device header.
+ * Everything the firmware needs from the MCU is provided by hal.h.
+ */
+
+#ifndef XC_H
+#define	XC_H
+
+#endif	/* XC_H */
@@ -0,0 +1,529 @@
+/*
+ * File:   main.c
+ *
+ * UniSolder closed loop simulator. Runs the firmware control core (PID.c, sensorMath.c, iron.c)
+ * against a simulated instrument, one PID call per mains half period like ISRHigh and the PID interrupt do.
+ *
+ * usage: ussim [options]
+ *   -i <n|ID>     instrument: index into Irons[] or hex ID (e.g. 1813), default 0
+ *   -t <C>        set temperature, default 350
+ *   -d <s>        simulated time, default 30
+ *   -l <s> <W>    load step at time s drawing W watts at the set temperature, default 20s, PID_PMax/2
+ *   -p <s> <C>    set temperature step at time s (before the load step) to C
+ *   -m <50|60|dc> mains, default 50
+ *   -v <V>        heater supply voltage (RMS), default 24
+ *   -r <C>        room temperature, default 25
+ *   -R <ohm>      heater resistance, default from PID_PMax
+ *   -s <n>        noise seed
+ *   -c            print CSV trace of every PID step
+ *   -b <n>        batch: run n scenarios over all Irons[] with random set temperature, mains and load
+ *   -S            dual instruments: one sensor per temperature window (previous schedule)
+ *   -D            compare both dual instrument schedules
+ *   -F            feed-forward coefficients (FF_Loss, FF_Mass) from the simulated instrument
+ *   -P            compare the PID with and without feed-forward
+ *   -M <x>        tip thermal mass times x (a tip the coefficients were not tuned for)
+ *   -A            relay auto-tune, then compare the tuned coefficients with the Irons[] ones
+ *   -L            list instruments
+ *   -T            run the host checks of the control core
+ *   -B            run the host benchmarks of the control core
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mcu.h"
+#include "iron.h"
+#include "PID.h"
+#include "plant.h"
+#include "sim.h"
+#include "check.h"
+#include "bench.h"
+
+extern const t_IronPars Irons[];
+extern const int IronsNum;
+
+#define SETTLE_BAND 5.0
+
+typedef struct {
+    int Iron;               //index into Irons[]
+    int Temp;               //set temperature
+    double Time;            //simulated time
+    double LoadTime;        //load step time, < 0 - no load step
+    double LoadW;           //load power at set temperature, < 0 - PID_PMax/2
+    int Mains;              //50, 60 or SIM_MAINS_DC
+    double VRMS;
+    double TAmb;
+    double R;               //heater resistance, 0 - default
+    UINT32 Seed;
+    double StepTime;        //set temperature step time, < 0 - no step
+    int StepTemp;           //set temperature after the step
+    int FF;                 //1 - feed-forward coefficients from the plant
+    double TipMass;         //tip thermal mass factor, 0 - as derived from PID_PMax
+} t_Scenario;
+
+typedef struct {
+    double RiseTime;        //time to reach set temperature - SETTLE_BAND
+    double Overshoot;       //maximum temperature above set temperature before the load step
+    double SettleTime;      //time after which the temperature stays within SETTLE_BAND before the load step, -1 - not settled
+    double Ripple;          //peak to peak temperature in the last 2 seconds before the load step
+    double Error;           //mean temperature error in the last 2 seconds before the load step
+    double LoadDrop;        //maximum temperature drop after the load step
+    double Recovery;        //time after the load step until the temperature stays within SETTLE_BAND, -1 - not recovered
+    double StepOvershoot;   //maximum temperature beyond the set temperature step before the load step
+    double StepSettle;      //time after the set temperature step until the temperature stays within SETTLE_BAND, -1 - not settled
+    double Energy;          //heater energy (J)
+} t_Result;
+
+//Plant and firmware at power-up with instrument S->Iron plugged in and the set temperature of S
+static int ScenarioInit(const t_Scenario * S, t_Plant * PL){
+    const t_IronPars * IP = &Irons[S->Iron];
+    int ch;
+
+    PlantInit(PL, IP, S->VRMS, S->TAmb, S->Seed);
+    for(ch = 0; ch < 2; ch++){
+        if(S->R > 0) PL->Ch[ch].P.R0 = S->R;
+        if(S->TipMass > 0) PL->Ch[ch].P.CT *= S->TipMass;
+    }
+    if(SimInit(PL, IP, S->Mains)) return -1;
+    SimSetTemperature(S->Temp);
+    if(S->FF){
+        //steady state loss of the tip node and thermal mass of both nodes
+        for(ch = 0; ch < 2; ch++){
+            IronPars.Config[ch].FF_Loss = (UINT16)(PL->Ch[ch].P.GA * 1000 + 0.5);
+            IronPars.Config[ch].FF_Mass = (UINT16)((PL->Ch[ch].P.CH + PL->Ch[ch].P.CT) * 1000 + 0.5);
+        }
+    }
+    return 0;
+}
+
+static int RunScenario(const t_Scenario * S, t_Result * R, FILE * trace){
+    static t_Plant PL;
+    const t_IronPars * IP = &Irons[S->Iron];
+    double t = 0, dt, end, tq, lt;
+    double tmin = 1e9, tmax = -1e9, esum = 0;
+    int ch, n = 0, nch, loaded = 0, rise = 0, set = S->Temp, stepped = 0;
+    double lastOut = -1, lastOutLoad = -1, lastOutStep = -1;
+
+    if(ScenarioInit(S, &PL)) return -1;
+
+    memset(R, 0, sizeof(*R));
+    R->Overshoot = -1e9;
+    R->RiseTime = -1;
+    R->StepOvershoot = -1e9;
+    nch = IP->Config[1].SensorConfig.Type ? 2 : 1;
+    dt = SimHalfPeriodTime();
+    end = S->Time;
+    lt = (S->LoadTime >= 0 && S->LoadTime < end) ? S->LoadTime : end;
+    tq = lt - 2;
+
+    if(trace) printf("t,set,%s\n", nch > 1 ? "th0,tt0,ctemp0,duty0,heater0,th1,tt1,ctemp1,duty1,heater1" : "th0,tt0,ctemp0,duty0,heater0");
+
+    while(t < end){
+        if(!stepped && S->StepTime >= 0 && t >= S->StepTime && t < lt){
+            stepped = 1;
+            set = S->StepTemp;
+            SimSetTemperature(set);
+        }
+        if(!loaded && t >= lt){
+            loaded = 1;
+            for(ch = 0; ch < nch; ch++){
+                PlantSetLoad(&PL, ch, (S->LoadW >= 0) ? S->LoadW : IP->Config[ch].PID_PMax / 2.0, set);
+            }
+        }
+        SimHalfPeriod(&PL);
+        t += dt;
+        n++;
+
+        for(ch = 0; ch < nch; ch++){
+            double th = PL.Ch[ch].TH;
+            double e = th - set;
+            if(!loaded){
+                if(stepped){
+                    double o = (S->StepTemp >= S->Temp) ? e : -e;
+                    if(o > R->StepOvershoot) R->StepOvershoot = o;
+                    if(e > SETTLE_BAND || e < -SETTLE_BAND) lastOutStep = t;
+                }
+                else{
+                    if(!rise && e >= -SETTLE_BAND){
+                        rise = 1;
+                        R->RiseTime = t;
+                    }
+                    if(e > R->Overshoot) R->Overshoot = e;
+                    if(rise && (e > SETTLE_BAND || e < -SETTLE_BAND)) lastOut = t;
+                }
+                if(t >= tq){
+                    if(th < tmin) tmin = th;
+                    if(th > tmax) tmax = th;
+                    esum += e;
+                }
+            }
+            else{
+                if(-e > R->LoadDrop) R->LoadDrop = -e;
+                if(e > SETTLE_BAND || e < -SETTLE_BAND) lastOutLoad = t;
+            }
+        }
+
+        if(trace && (n & 1) == 0){
+            printf("%.3f,%d", t, set);
+            for(ch = 0; ch < nch; ch++){
+                printf(",%.1f,%.1f,%d,%u,%d", PL.Ch[ch].TH, PL.Ch[ch].TT, PIDVars[ch].CTemp[0] >> 1, (unsigned)(PIDVars[ch].PIDDuty >> 8), PL.Ch[ch].Frac > 0);
+            }
+            printf("\n");
+        }
+    }
+
+    if(!rise) R->RiseTime = -1;
+    R->SettleTime = rise ? ((lastOut > 0) ? lastOut : R->RiseTime) : -1;
+    if(R->SettleTime >= (stepped ? S->StepTime : lt)) R->SettleTime = -1;
+    R->StepSettle = stepped ? ((lastOutStep > 0) ? lastOutStep - S->StepTime : 0) : 0;
+    if(stepped && lastOutStep >= lt - dt) R->StepSettle = -1;
+    if(!stepped) R->StepOvershoot = 0;
+    R->Ripple = tmax - tmin;
+    R->Error = esum / (((lt - tq) / dt) * nch);
+    R->Recovery = loaded ? ((lastOutLoad > 0) ? lastOutLoad - lt : 0) : 0;
+    if(loaded && lastOutLoad >= t - dt) R->Recovery = -1;
+    for(ch = 0; ch < nch; ch++) R->Energy += PL.Ch[ch].Energy;
+    return 0;
+}
+
+static int FindIron(const char * s){
+    int i;
+    unsigned long id;
+    char * e;
+    id = strtoul(s, &e, 16);
+    if(*e == 0 && strlen(s) == 4){
+        for(i = 0; i < IronsNum; i++) if(Irons[i].ID.Val == id) return i;
+    }
+    i = atoi(s);
+    return (i >= 0 && i < IronsNum) ? i : -1;
+}
+
+static void PrintResult(const t_Scenario * S, const t_Result * R){
+    printf("%-24.24s %3dC %2s rise %5.2fs overshoot %5.1fC settle %6.2fs ripple %4.1fC error %+5.1fC load drop %5.1fC recovery %5.2fs",
+        (const char *)Irons[S->Iron].Name, S->Temp, S->Mains == SIM_MAINS_DC ? "DC" : (S->Mains == 50 ? "50" : "60"),
+        R->RiseTime, R->Overshoot, R->SettleTime, R->Ripple, R->Error, R->LoadDrop, R->Recovery);
+    if(S->StepTime >= 0) printf(" step to %dC overshoot %5.1fC settle %5.2fs", S->StepTemp, R->StepOvershoot, R->StepSettle);
+    printf("\n");
+}
+
+static void Batch(const t_Scenario * Base, int num){
+    static const int MainsSel[3] = {50, 60, SIM_MAINS_DC};
+    t_Scenario S;
+    t_Result R;
+    struct timespec t0, t1;
+    double el;
+    int i, k;
+    struct {
+        int n, unsettled, unrecovered;
+        double rise, overshoot, settle, drop, recovery, maxOvershoot, maxDrop;
+    } sum[64];
+    UINT32 rnd = Base->Seed ? Base->Seed : 1;
+
+    memset(sum, 0, sizeof(sum));
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(i = 0; i < num; i++){
+        S = *Base;
+        rnd = rnd * 1664525 + 1013904223;
+        S.Iron = i % IronsNum;
+        S.Temp = 250 + ((rnd >> 8) % 51) * 4;
+        S.Mains = MainsSel[(rnd >> 20) % 3];
+        S.LoadW = Irons[S.Iron].Config[0].PID_PMax * (0.2 + ((rnd >> 4) & 15) / 25.0);
+        S.Seed = rnd;
+        if(RunScenario(&S, &R, NULL)) continue;
+        k = S.Iron & 63;
+        sum[k].n++;
+        if(R.SettleTime < 0){
+            sum[k].unsettled++;
+        }
+        else{
+            sum[k].settle += R.SettleTime;
+        }
+        sum[k].rise += R.RiseTime;
+        sum[k].overshoot += R.Overshoot;
+        sum[k].drop += R.LoadDrop;
+        if(R.Recovery < 0){
+            sum[k].unrecovered++;
+        }
+        else{
+            sum[k].recovery += R.Recovery;
+        }
+        if(R.Overshoot > sum[k].maxOvershoot) sum[k].maxOvershoot = R.Overshoot;
+        if(R.LoadDrop > sum[k].maxDrop) sum[k].maxDrop = R.LoadDrop;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    el = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+
+    printf("%-24s %5s %7s %9s %9s %8s %9s %9s %8s %9s %11s\n", "instrument", "runs", "rise", "overshoot", "max ovs", "settle", "unsettled", "load drop", "max drop", "recovery", "unrecovered");
+    for(k = 0; k < IronsNum && k < 64; k++){
+        int n = sum[k].n;
+        int ns = n - sum[k].unsettled;
+        int nr = n - sum[k].unrecovered;
+        if(!n) continue;
+        printf("%-24.24s %5d %6.2fs %8.1fC %8.1fC %7.2fs %9d %8.1fC %7.1fC %8.2fs %11d\n", (const char *)Irons[k].Name, n,
+            sum[k].rise / n, sum[k].overshoot / n, sum[k].maxOvershoot, ns ? sum[k].settle / ns : 0, sum[k].unsettled,
+            sum[k].drop / n, sum[k].maxDrop, nr ? sum[k].recovery / nr : 0, sum[k].unrecovered);
+    }
+    printf("%d scenarios of %.0fs in %.2fs, %.0f scenarios/min\n", num, Base->Time, el, el > 0 ? num * 60 / el : 0);
+}
+
+//Averages of instrument iron over set temperatures and mains, one line of DualCompare and FFCompare
+static void CompareRow(const t_Scenario * Base, int iron, const char * label){
+    static const int MainsSel[3] = {50, 60, SIM_MAINS_DC};
+    static const int Temps[4] = {250, 300, 350, 400};
+    t_Scenario S;
+    t_Result R;
+    int m, t, n = 0, ns = 0, nr = 0, nt = 0;
+    double rise = 0, ovs = 0, settle = 0, sovs = 0, ssettle = 0, drop = 0, rec = 0;
+
+    for(m = 0; m < 3; m++){
+        for(t = 0; t < 4; t++){
+            S = *Base;
+            S.Iron = iron;
+            S.Mains = MainsSel[m];
+            S.Temp = Temps[t];
+            if(S.StepTime >= 0) S.StepTemp = S.Temp + Base->StepTemp;
+            S.Seed = Base->Seed + m * 4 + t;
+            if(RunScenario(&S, &R, NULL)) continue;
+            n++;
+            rise += R.RiseTime;
+            ovs += R.Overshoot;
+            sovs += R.StepOvershoot;
+            drop += R.LoadDrop;
+            if(R.SettleTime >= 0){
+                settle += R.SettleTime;
+                ns++;
+            }
+            if(R.StepSettle >= 0){
+                ssettle += R.StepSettle;
+                nt++;
+            }
+            if(R.Recovery >= 0){
+                rec += R.Recovery;
+                nr++;
+            }
+        }
+    }
+    if(!n) return;
+    printf("%-24.24s %-9s %6.2fs %8.1fC %7.2fs %8.1fC %7.2fs %8.1fC %8.2fs%s\n", (const char *)Irons[iron].Name, label,
+        rise / n, ovs / n, ns ? settle / ns : -1, sovs / n, nt ? ssettle / nt : -1, drop / n, nr ? rec / nr : -1,
+        (ns < n || nr < n || nt < n) ? " (not all settled)" : "");
+}
+
+static void CompareHeader(){
+    printf("%-24s %-9s %7s %9s %8s %9s %8s %9s %9s\n", "instrument", "", "rise", "overshoot", "settle", "step ovs", "step", "load drop", "recovery");
+}
+
+//Dual instruments with both sensors read in every window against one sensor per window.
+//Both PIDs run every other half period with the first, every fourth with the second
+static void DualCompare(const t_Scenario * Base){
+    int i, k;
+
+    CompareHeader();
+    for(i = 0; i < IronsNum; i++){
+        if(!Irons[i].Config[1].SensorConfig.Type) continue;
+        for(k = 2; k--;){
+            SimDualScan = k;
+            CompareRow(Base, i, k ? "scan" : "one/win");
+        }
+    }
+    SimDualScan = 1;
+}
+
+//PID with the feed-forward coefficients of the simulated instrument against the integral term alone,
+//heat-up, a set temperature step of +50C at 20s and a load step of PID_PMax/2 (big ground plane) at 30s
+static void FFCompare(const t_Scenario * Base){
+    t_Scenario S = *Base;
+    int i;
+
+    S.Time = 40;
+    S.StepTime = 20;
+    S.StepTemp = 50;
+    S.LoadTime = 30;
+    S.LoadW = -1;
+    CompareHeader();
+    for(i = 0; i < IronsNum; i++){
+        for(S.FF = 0; S.FF < 2; S.FF++){
+            CompareRow(&S, i, S.FF ? "ff" : "integral");
+        }
+    }
+}
+
+//Auto-tune run as started from the menu at the set temperature of S, until the coefficients are saved to the EEPROM
+//(by IronTasks, the next SimInit loads them) or the run fails. Returns the PIDTuneState at the end
+static int TuneRun(const t_Scenario * S, double * time){
+    static t_Plant PL;
+    double t = 0, dt;
+    int st;
+
+    *time = 0;
+    if(ScenarioInit(S, &PL)) return PID_TUNE_FAILED;
+    dt = SimHalfPeriodTime();
+    PIDTuneStart();
+    while((st = PIDTuneState()) != PID_TUNE_SAVED && st != PID_TUNE_FAILED && st != PID_TUNE_OFF && t < 300){
+        SimHalfPeriod(&PL);
+        t += dt;
+    }
+    *time = t;
+    return st;
+}
+
+//Irons[] coefficients against the auto-tuned ones, on the instrument as simulated and with a tip of twice the thermal mass.
+//The tune runs at 300C and 50Hz, the comparison is the FFCompare one
+static void TuneCompare(const t_Scenario * Base){
+    static const double Mass[2] = {1, 2};
+    t_Scenario S = *Base;
+    char label[16];
+    double tt;
+    int i, m, st;
+
+    S.Time = 40;
+    S.StepTime = 20;
+    S.StepTemp = 50;
+    S.LoadTime = 30;
+    S.LoadW = -1;
+    CompareHeader();
+    for(i = 0; i < IronsNum; i++){
+        S.Iron = i;
+        for(m = 0; m < 2; m++){
+            S.TipMass = Mass[m];
+            HALEEPErase();
+            sprintf(label, "x%.0f flash", Mass[m]);
+            CompareRow(&S, i, label);
+            S.Temp = 300;
+            S.Mains = 50;
+            st = TuneRun(&S, &tt);
+            if(st != PID_TUNE_SAVED){
+                printf("%-24.24s x%.0f tune  failed after %.1fs\n", (const char *)Irons[i].Name, Mass[m], tt);
+                continue;
+            }
+            sprintf(label, "x%.0f %.0fs", Mass[m], tt);
+            CompareRow(&S, i, label);
+            HALEEPErase();
+        }
+    }
+}
+
+int main(int argc, char ** argv){
+    t_Scenario S;
+    t_Result R;
+    int i, n, trace = 0, batch = 0;
+
+    S.Iron = 0;
+    S.Temp = 350;
+    S.Time = 30;
+    S.LoadTime = 20;
+    S.LoadW = -1;
+    S.Mains = 50;
+    S.VRMS = 24;
+    S.TAmb = 25;
+    S.R = 0;
+    S.Seed = 1;
+    S.StepTime = -1;
+    S.StepTemp = 0;
+    S.FF = 0;
+    S.TipMass = 0;
+
+    for(i = 1; i < argc; i++){
+        const char * a = argv[i];
+        const char * v = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if(a[0] != '-' || a[1] == 0 || a[2] != 0) goto usage;
+        switch(a[1]){
+            case 'c':
+                trace = 1;
+                continue;
+            case 'S':
+                SimDualScan = 0;
+                continue;
+            case 'D':
+                DualCompare(&S);
+                return 0;
+            case 'F':
+                S.FF = 1;
+                continue;
+            case 'P':
+                FFCompare(&S);
+                return 0;
+            case 'A':
+                TuneCompare(&S);
+                return 0;
+            case 'L':
+                for(i = 0; i < IronsNum; i++) printf("%2d %04X %.24s\n", i, Irons[i].ID.Val, (const char *)Irons[i].Name);
+                return 0;
+            case 'T':
+                n = CheckSensorLUT();
+                n += CheckVIAcc();
+                n += CheckIronOvr();
+                n += CheckParsJournal();
+                n += CheckI2CSched();
+                n += CheckI2CShadow();
+                n += CheckLiveRecs();
+                n += CheckTlmDual();
+                n += CheckVICap();
+                n += CheckOLEDUpdate();
+                n += CheckOLEDBlit();
+                n += CheckFontPack();
+                return n ? 1 : 0;
+            case 'B':
+                BenchSensorTemperature();
+                printf("\n");
+                BenchISRStep5();
+                printf("\n");
+                BenchHeaterMeasure();
+                printf("\n");
+                BenchPowerLossSave();
+                printf("\n");
+                BenchOLEDScreen();
+                printf("\n");
+                BenchMenuScreens();
+                printf("\n");
+                BenchFontPack();
+                return 0;
+        }
+        if(!v) goto usage;
+        i++;
+        switch(a[1]){
+            case 'i':
+                if((S.Iron = FindIron(v)) < 0){
+                    fprintf(stderr, "unknown instrument %s\n", v);
+                    return 1;
+                }
+                break;
+            case 't': S.Temp = atoi(v); break;
+            case 'd': S.Time = atof(v); break;
+            case 'l':
+                if(i + 1 >= argc) goto usage;
+                S.LoadTime = atof(v);
+                S.LoadW = atof(argv[++i]);
+                break;
+            case 'p':
+                if(i + 1 >= argc) goto usage;
+                S.StepTime = atof(v);
+                S.StepTemp = atoi(argv[++i]);
+                break;
+            case 'm': S.Mains = (v[0] == 'd' || v[0] == 'D') ? SIM_MAINS_DC : atoi(v); break;
+            case 'v': S.VRMS = atof(v); break;
+            case 'r': S.TAmb = atof(v); break;
+            case 'R': S.R = atof(v); break;
+            case 's': S.Seed = strtoul(v, NULL, 0); break;
+            case 'M': S.TipMass = atof(v); break;
+            case 'b': batch = atoi(v); break;
+            default: goto usage;
+        }
+    }
+    if(S.Mains != 50 && S.Mains != 60 && S.Mains != SIM_MAINS_DC) goto usage;
+
+    if(batch){
+        Batch(&S, batch);
+        return 0;
+    }
+    if(RunScenario(&S, &R, trace ? stdout : NULL)){
+        fprintf(stderr, "instrument not identified\n");
+        return 1;
+    }
+    if(!trace) PrintResult(&S, &R);
+    return 0;
+
+usage:
+    fprintf(stderr, "usage: %s [-i n|ID] [-t C] [-d s] [-l s W] [-p s C] [-m 50|60|dc] [-v V] [-r C] [-R ohm] [-s seed] [-c] [-b n] [-M x] [-S] [-D] [-F] [-P] [-A] [-L] [-T] [-B]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,188 @@
+/*
+ * File:   plant.c
+ *
+ * Thermal and analog front end model of a soldering instrument.
+ */
+#include <math.h>
+#include <string.h>
+#include "plant.h"
+
+static double PlantRand(t_Plant * PL){
+    //xorshift32, returns -0.5..0.5
+    UINT32 x = PL->Rnd;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    PL->Rnd = x;
+    return ((double)x / 4294967296.0) - 0.5;
+}
+
+static double PlantNoise(t_Plant * PL, double rms){
+    //sum of 4 uniform numbers, close enough to gaussian
+    if(rms <= 0) return 0;
+    return (PlantRand(PL) + PlantRand(PL) + PlantRand(PL) + PlantRand(PL)) * rms * 1.732;
+}
+
+static double PlantPoly(const t_SensorConfig * SC, double x){
+    int n;
+    double t = 0;
+    for(n = 10; n--;) t = t * x + SC->TPoly[n];
+    return t;
+}
+
+//Sensor input (ADC + Offset, as in GetSensorTemperature) to polynomial argument (millivolts or ohms)
+static double PlantPolyX(const t_SensorConfig * SC, double input){
+    double x = input / (SC->Gain ? SC->Gain : 1);
+    if(SC->Type == SENSOR_PTC){
+        double current = SC->InputInv ? SC->CurrentA : SC->CurrentB;
+        int cBand = SC->InputInv ? SC->CBandA : SC->CBandB;
+        if(current == 0) current = 1;
+        x *= (1.6 * 256) / 1.225;
+        if(!cBand) x /= 16;
+        x /= current;
+    }
+    return x;
+}
+
+static void PlantSensorInit(t_PlantSensor * PS, const t_SensorConfig * SC){
+    int i, s, d;
+    PS->SC = SC;
+    PS->Dir = 1;
+    PS->Lo = 0;
+    PS->Hi = 2047;
+    if(!SC || SC->Type == SENSOR_UNDEFINED || SC->Type == SENSOR_NONE) return;
+    for(i = 0; i < 2048; i++) PS->TTab[i] = PlantPoly(SC, PlantPolyX(SC, i));
+    //polynomials are fitted to the useful range only, invert within the longest monotonic part of the table
+    PS->Hi = 0;
+    for(i = 0, s = 0, d = 0; i < 2047; i++){
+        int nd = (PS->TTab[i + 1] > PS->TTab[i]) ? 1 : -1;
+        if(nd != d){
+            s = i;
+            d = nd;
+        }
+        if(i + 1 - s > PS->Hi - PS->Lo){
+            PS->Lo = s;
+            PS->Hi = i + 1;
+            PS->Dir = d;
+        }
+    }
+}
+
+double PlantSensorTemperature(const t_PlantSensor * PS, double input){
+    int i;
+    if(input <= 0) return PS->TTab[0];
+    if(input >= 2047) return PS->TTab[2047];
+    i = (int)input;
+    return PS->TTab[i] + (PS->TTab[i + 1] - PS->TTab[i]) * (input - i);
+}
+
+//Polynomial temperature to sensor input (ADC + Offset), fractional
+static double PlantSensorInput(const t_PlantSensor * PS, double t){
+    int lo = PS->Lo, hi = PS->Hi;
+    double d;
+    t *= PS->Dir;
+    if(t <= PS->TTab[lo] * PS->Dir) return lo;
+    if(t >= PS->TTab[hi] * PS->Dir) return hi;
+    while(hi - lo > 1){
+        int m = (lo + hi) >> 1;
+        if(PS->TTab[m] * PS->Dir > t) hi = m; else lo = m;
+    }
+    d = (PS->TTab[hi] - PS->TTab[lo]) * PS->Dir;
+    return lo + ((d > 0) ? (t - PS->TTab[lo] * PS->Dir) / d : 0);
+}
+
+void PlantInit(t_Plant * PL, const t_IronPars * IP, double VRMS, double TAmb, UINT32 Seed){
+    int i;
+    memset(PL, 0, sizeof(*PL));
+    PL->VRMS = VRMS;
+    PL->TAmb = TAmb;
+    PL->Rnd = Seed ? Seed : 0x12345678;
+    for(i = 0; i < 2; i++){
+        t_PlantChannel * C = &PL->Ch[i];
+        const t_IronConfig * IC = &IP->Config[i];
+        double pmax = IC->PID_PMax ? IC->PID_PMax : 40;
+        //Defaults scaled from the rated power: ~50% headroom on full power,
+        //heat-up to 350C in ~8s, ~20% of rated power needed to idle at 350C
+        C->P.R0 = (VRMS * VRMS) / (pmax * 1.5);
+        C->P.Alpha = 0;
+        C->P.CH = 0.3 * pmax / 35;
+        C->P.CT = 0.7 * pmax / 35;
+        C->P.GHT = pmax / 70;
+        C->P.GA = pmax / 1650;
+        C->P.Spike = IC->WSLen ? 0.3 : 0;
+        C->P.SpikeDecay = 0.5;
+        C->P.Noise = 0.3;
+        C->HRComp = (IC->SensorConfig.Type == SENSOR_TC) ? IC->HRCompCurrent : 0;
+        C->TH = C->TT = TAmb;
+        C->R = C->P.R0;
+        PlantSensorInit(&C->S, &IC->SensorConfig);
+    }
+    PlantSensorInit(&PL->CJ, IP->ColdJunctionSensorConfig);
+}
+
+void PlantSetLoad(t_Plant * PL, int ch, double watts, double temp){
+    PL->Ch[ch].GL = (temp > PL->TAmb) ? watts / (temp - PL->TAmb) : 0;
+}
+
+//Advance the plant by one mains half period with heater channel ch on for fraction frac of it (ch < 0 - all off)
+void PlantStep(t_Plant * PL, int ch, double frac, double dt){
+    int i;
+    for(i = 0; i < 2; i++){
+        t_PlantChannel * C = &PL->Ch[i];
+        double p = 0, q;
+        C->R = C->P.R0 * (1 + C->P.Alpha * (C->TH - 20));
+        if(C->R < 0.01) C->R = 0.01;
+        C->Frac = (i == ch) ? frac : 0;
+        if(C->Frac > 0) p = (PL->VRMS * PL->VRMS / C->R) * C->Frac;
+        C->Power = p;
+        C->Energy += p * dt;
+        q = C->P.GHT * (C->TH - C->TT);
+        C->TH += dt * (p - q) / C->P.CH;
+        C->TT += dt * (q - (C->P.GA + C->GL) * (C->TT - PL->TAmb)) / C->P.CT;
+        if(C->Frac > 0){
+            C->Spike = C->P.Spike * p;
+        }
+        else{
+            C->Spike *= C->P.SpikeDecay;
+        }
+    }
+    PL->Time += dt;
+}
+
+//Sum of samples 10 bit ADC readings of the temperature input of channel ch (as mcuADCRES)
+int PlantSensorADC(t_Plant * PL, int ch, int samples){
+    t_PlantChannel * C = &PL->Ch[ch];
+    const t_SensorConfig * SC = C->S.SC;
+    double t, in;
+    int s, sum = 0;
+
+    if(!SC || SC->Type == SENSOR_UNDEFINED || SC->Type == SENSOR_NONE) return 1023 * samples;
+    t = C->TH + C->Spike;
+    if(SC->Type == SENSOR_TC) t -= PL->TAmb;
+    in = PlantSensorInput(&C->S, t) - SC->Offset;
+    //series TC - voltage drop of the sensor current on the heater
+    if(C->HRComp) in += SC->Gain * (C->HRComp * 1.225 / (1.6 * 256)) * C->R;
+    for(s = samples; s--;){
+        int a = (int)floor(in + PlantNoise(PL, C->P.Noise) + 0.5);
+        if(a < 0) a = 0;
+        if(a > 1023) a = 1023;
+        sum += a;
+    }
+    return sum;
+}
+
+//Cold junction sensor single ADC reading
+int PlantCJADC(t_Plant * PL){
+    const t_SensorConfig * SC = PL->CJ.SC;
+    int a;
+    if(!SC) return 0;
+    a = (int)floor(PlantSensorInput(&PL->CJ, PL->TAmb) - SC->Offset + PlantNoise(PL, 0.3) + 0.5);
+    if(a < 1) a = 1;
+    if(a > 1023) a = 1023;
+    return a;
+}
+
+//Room temperature sensor single ADC reading (inverse of the PID.c room temperature calculation)
+int PlantRTADC(t_Plant * PL){
+    return (int)floor(((PL->TAmb * 4 + 200) * 256 / 147) / 2 + PlantNoise(PL, 0.3) + 0.5);
+}
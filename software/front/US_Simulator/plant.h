@@ -0,0 +1,73 @@
+/*
+ * File:   plant.h
+ *
+ * Simulated soldering instrument: two heater/sensor channels, each modelled as a
+ * heater/sensor node and a tip node, plus the analog front end that turns the
+ * sensor signal into the ADC counts the firmware sees.
+ */
+
+#ifndef PLANT_H
+#define	PLANT_H
+
+#include <GenericTypeDefs.h>
+#include "iron.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    double R0;              //heater resistance at 20C (ohms)
+    double Alpha;           //heater resistance temperature coefficient (1/K)
+    double CH;              //heater/sensor node thermal mass (J/K)
+    double CT;              //tip node thermal mass (J/K)
+    double GHT;             //heater to tip thermal conductance (W/K)
+    double GA;              //tip to ambient thermal conductance (W/K)
+    double Spike;           //series TC spike after a heated half period (degrees per watt)
+    double SpikeDecay;      //spike decay per half period with heater off (0-1)
+    double Noise;           //ADC noise (LSB RMS)
+} t_PlantPars;
+
+typedef struct {
+    const t_SensorConfig * SC;
+    int Dir;                //1 if temperature rises with the ADC input, -1 otherwise
+    int Lo, Hi;             //monotonic part of TTab
+    float TTab[2048];       //sensor input (0-2047, offset included) to temperature
+} t_PlantSensor;
+
+typedef struct {
+    t_PlantPars P;
+    t_PlantSensor S;
+    int HRComp;             //heater resistance compensation current (series TC)
+    double TH;              //heater/sensor node temperature
+    double TT;              //tip temperature
+    double GL;              //load thermal conductance to ambient (W/K)
+    double Spike;           //current series TC spike (degrees)
+    double R;               //heater resistance in the last half period
+    double Power;           //average heater power in the last half period (W)
+    double Frac;            //heated fraction of the last half period (0 when off)
+    double Energy;          //total heater energy (J)
+} t_PlantChannel;
+
+typedef struct {
+    t_PlantChannel Ch[2];
+    t_PlantSensor CJ;
+    double VRMS;            //heater supply voltage (RMS)
+    double TAmb;            //room and cold junction temperature
+    double Time;            //simulated time (s)
+    UINT32 Rnd;
+} t_Plant;
+
+extern void PlantInit(t_Plant * PL, const t_IronPars * IP, double VRMS, double TAmb, UINT32 Seed);
+extern void PlantStep(t_Plant * PL, int ch, double frac, double dt);
+extern int PlantSensorADC(t_Plant * PL, int ch, int samples);
+extern int PlantCJADC(t_Plant * PL);
+extern int PlantRTADC(t_Plant * PL);
+extern void PlantSetLoad(t_Plant * PL, int ch, double watts, double temp);
+extern double PlantSensorTemperature(const t_PlantSensor * PS, double input);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* PLANT_H */
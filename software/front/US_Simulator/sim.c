@@ -0,0 +1,273 @@
+/*
+ * File:   sim.c
+ *
+ * Mains half period driver for the host build of the control core.
+ */
+#include <math.h>
+#include <string.h>
+#include "mcu.h"
+#include "isr.h"
+#include "main.h"
+#include "iron.h"
+#include "PID.h"
+#include "sim.h"
+
+extern const UINT16 IDHash[25];
+
+static int OldHeater;
+static int HPower;
+t_SimProf SimProf;
+int SimDualScan = 1;
+static const double PowerFrac[4] = {1.0, 1.0 / 2, 1.0 / 4, 1.0 / 8};
+
+//Channel served at ADC step s, same selection as ISRHigh
+static int SimChannel(int s){
+    return ((s < 2) || (IronPars.Config[1].SensorConfig.Type == SENSOR_UNDEFINED)) ? 0 : 1;
+}
+
+//ID resistor ADC reading which IronIdentify() decodes to ID byte v
+static UINT16 SimIDADC(UINT8 v){
+    if(v == 0) return IDHash[0] >> 1;
+    if(v >= 25) return 1000;
+    return (IDHash[v - 1] + IDHash[v]) >> 1;
+}
+
+//Mains timing, as measured in main()
+static void SimMainsInit(int Mains){
+    if(Mains == SIM_MAINS_DC){
+        MAINS_PER_US = 9091;
+        POWER_DUTY = (1060*(9091-810))/9091;
+        MAINS_PER_H_US = (MAINS_PER_US - 810) >> 1;
+        MAINS_PER_Q_US = (MAINS_PER_US - 810) >> 2;
+        MAINS_PER_E_US = (MAINS_PER_US - 810) >> 3;
+        mainFlags.ACPower = 0;
+    }
+    else{
+        MAINS_PER_US = 500000 / Mains;
+        POWER_DUTY = (1060*(MAINS_PER_US-510))/MAINS_PER_US;
+        MAINS_PER_H_US = MAINS_PER_US >> 1;
+        MAINS_PER_Q_US = (MAINS_PER_US * 368)/1001;
+        MAINS_PER_E_US = (MAINS_PER_US * 271)/964;
+        mainFlags.ACPower = 1;
+    }
+    MAINS_PER_E_US = MAINS_PER_H_US - MAINS_PER_E_US;
+    MAINS_PER_Q_US = MAINS_PER_H_US - MAINS_PER_Q_US;
+    MAINS_PER_E_US -= MAINS_PER_Q_US;
+}
+
+//Power-up sequence of main(): IronInit, ISRInit, PIDInit, IronOvrInit, then IronTasks until the instrument is identified and
+//its overrides are applied
+int SimInit(t_Plant * PL, const t_IronPars * IP, int Mains){
+    int i;
+
+    memset((void *)PIDVars, 0, sizeof(PIDVars));
+    memset((void *)&ADCData, 0, sizeof(ADCData));
+    memset((void *)&mainFlags, 0, sizeof(mainFlags));
+    SimMainsInit(Mains);
+    RTAvg = 0;
+    CRTemp = 0;
+    CTTemp = 0;
+
+    IronInit();
+
+    ISRStep = 0;
+    ADCStep = 0;
+    ISRTicks = 1;
+    CJTicks = 0;
+    PHEATER = 0;
+    while(HALI2CRun());     //transfers queued by the previous run complete before the power-up
+    I2CInit();
+    for(i = 2; i--;){
+        PIDVars[i].NoHeater = 255;
+        PIDVars[i].NoSensor = 255;
+        PIDVars[i].ShortCircuit = 255;
+        PIDVars[i].HInitData = 1;
+        PIDVars[i].OffDelay = 1600;
+    }
+    OldHeater = 0;
+    HPower = 3;
+    PIDPending = 0;
+
+    PIDInit();
+    IronOvrInit();
+
+    HALIDADC[0] = SimIDADC(IP->ID.v[0]);
+    HALIDADC[1] = SimIDADC(IP->ID.v[1]);
+    for(i = 0; i < 128 && IronID != IP->ID.Val; i++){
+        ISRTicks++;
+        IronTasks();
+    }
+    while(HALI2CRun());     //the overrides of the instrument are read
+    IronTasks();
+    if(!SimDualScan) IronDualScan = 0;
+    return (IronID == IP->ID.Val) ? 0 : -1;
+}
+
+void SimSetTemperature(int temp){
+    TTemp = temp >> 1;
+    CTTemp = TTemp;
+}
+
+double SimHalfPeriodTime(){
+    return MAINS_PER_US * 1e-6;
+}
+
+//Pot and DAC settings of a sensor, queued with the deadline us from now as in cases 6 and 7
+static void SimSetPots(const t_SensorConfig * SC, UINT32 us){
+    I2CData.CurrentA.ui16 = SC->CurrentA;
+    I2CData.CurrentB.ui16 = SC->CurrentB;
+    I2CData.Gain.ui16 = SC->Gain;
+    I2CData.Offset.ui16 = SC->Offset;
+    I2CSetPots(mcuReadCoreTimer() + us * (CORETIMER_FREQ / 1000000));
+}
+
+//The I2C bus runs from the zero cross at the start of the half period: case 4 reads the temperature at 65us, case 6
+//is at 250us and case 7 at MAINS_PER_H_US
+void SimHalfPeriod(t_Plant * PL){
+    t_PIDVars * PV;
+    t_IronConfig * IC;
+    t_PlantChannel * C;
+    t_PIDOut * PO;
+    UINT64 t = 0;
+    int ch, adc, scan = -1;
+    double t0 = HALI2CTime;
+
+    HALI2CRunUntil(t0 + 65);
+    ch = SimChannel(ADCStep);
+    PV = (t_PIDVars *)&PIDVars[ch];
+    C = &PL->Ch[ch];
+
+    //case 2: heater voltage, current, power and resistance of the previous half period
+    if(!(ADCStep & 1) && OldHeater){
+        double k = POWER_DUTY;
+        double v = PL->VRMS;
+        double i = v / C->R;
+        if(IronPars.Config[1].SensorConfig.Type) k /= 2;
+        k /= 1024;
+        PV->HV = (int)(v * 12.19 * sqrt(k) + 0.5);
+        PV->HI = (int)(i * sqrt(C->Frac) * 42.55 * sqrt(k) + 0.5);
+        PV->HP = (int)(v * i * C->Frac * k + 0.5);
+        PV->HR = (int)(C->R * 10 + 0.5);
+        PV->HNewData = 1;
+    }
+
+    //case 3, 4: room temperature
+    if(ADCStep & 1){
+        if(ADCStep <= 1){
+            ADCData.VRT = PlantRTADC(PL);
+        }
+        else{
+            ADCData.VRT += PlantRTADC(PL);
+        }
+    }
+
+    //case 5: iron temperature, sensor and heater checks, latch the samples for the PID task
+    adc = PlantSensorADC(PL, ch, 4);
+    if(SimProf.Clock) t = SimProf.Clock();
+    ADCData.HeaterOn = PHEATER;
+    ADCData.VTEMP[ADCStep & 1] = adc >> 2;
+    if(ADCStep & 1){
+        if(PV->HR > 3000) {
+            if(PV->NoHeater < 255) PV->NoHeater++;
+        }
+        else{
+            PV->NoHeater = 0;
+        }
+        if(PV->HR < 8){
+            if(PV->ShortCircuit < 255) PV->ShortCircuit++;
+        }
+        else{
+            PV->ShortCircuit = 0;
+        }
+        if(ADCData.VTEMP[1] >= 1023){
+            if(PV->NoSensor < 255) PV->NoSensor++;
+        }
+        else{
+            PV->NoSensor = 0;
+        }
+        PIDADC[ADCStep >> 1].HeaterOn = ADCData.HeaterOn;
+        PIDADC[ADCStep >> 1].VRT = ADCData.VRT;
+        PIDADC[ADCStep >> 1].VTEMP[1] = ADCData.VTEMP[1];
+        PIDPending |= 1 << (ADCStep >> 1);
+        if(IronDualScan) scan = (ADCStep >> 1) ^ 1;
+    }
+    ADCStep = (ADCStep + 1) & 3;
+    if(SimProf.Clock) t = SimProf.Clock() - t;
+
+    //case 6, dual scan: the other sensor, its heater was off in the last two half periods
+    if(scan >= 0){
+        adc = PlantSensorADC(PL, scan, 4) >> 2;
+        if(adc >= 1023){
+            if(PIDVars[scan].NoSensor < 255) PIDVars[scan].NoSensor++;
+        }
+        else{
+            PIDVars[scan].NoSensor = 0;
+        }
+        PIDADC[scan].HeaterOn = 0;
+        PIDADC[scan].VRT = 0;
+        PIDADC[scan].VTEMP[1] = adc;
+        PIDPending |= 1 << scan;
+    }
+
+    //PID interrupt, runs as soon as ISRHigh returns
+    if(PIDPending){
+        UINT64 tp = 0;
+        if(SimProf.Clock) tp = SimProf.Clock();
+        while(PIDPending){
+            int s = (PIDPending & 1) ? 0 : 1;
+            PID(s);
+            PIDPending &= ~(1 << s);
+        }
+        if(SimProf.Clock){
+            tp = SimProf.Clock() - tp;
+            SimProf.ISR += t;
+            SimProf.PID += tp;
+            SimProf.Cnt++;
+        }
+    }
+
+    ch = SimChannel(ADCStep);
+    PV = (t_PIDVars *)&PIDVars[ch];
+    IC = (t_IronConfig *)&IronPars.Config[ch];
+
+    //case 6: heater decision on the published PID results
+    PO = &PV->Out[PV->OutSel];
+    HPower = PO->Power;
+    if(!(ADCStep & 1)){
+        PV->PWM += PO->Duty;
+        PHEATER = ((PV->PWM>>24)!=0);
+        PV->PWM &= 0x00FFFFFF;
+    }
+    if(PO->KeepOff || IC->SensorConfig.Type == SENSOR_UNDEFINED || IC->SensorConfig.Type == SENSOR_NONE) PHEATER = 0;
+
+    //case 6: front end setup for the cold junction sample of case 7
+    HALI2CRunUntil(t0 + 250);
+    if(!PHEATER && !CJTicks && IronPars.ColdJunctionSensorConfig && IronPars.ColdJunctionSensorConfig->HChannel == IC->SensorConfig.HChannel){
+        SimSetPots(IronPars.ColdJunctionSensorConfig, MAINS_PER_H_US - 250);
+    }
+
+    //case 7: cold junction sensor, front end setup for the temperature read of case 4
+    HALI2CRunUntil(t0 + MAINS_PER_H_US);
+    SimSetPots((IronDualScan) ? (const t_SensorConfig *)&IronScanConfig : &IC->SensorConfig, MAINS_PER_H_US);
+    if(!PHEATER && !CJTicks && IronPars.ColdJunctionSensorConfig && IronPars.ColdJunctionSensorConfig->HChannel == IC->SensorConfig.HChannel){
+        ADCData.VCJ = PlantCJADC(PL);
+        CJTicks = CJ_PERIOD;
+    }
+    else{
+        ADCData.VCJ = 0;
+        if(!IronPars.ColdJunctionSensorConfig) CJTicks = 0;
+    }
+
+    //cases 6-9: heater on from the full, 1/2, 1/4 or 1/8 power point until the next zero cross
+    PlantStep(PL, PHEATER ? ch : -1, PowerFrac[HPower & 3], SimHalfPeriodTime());
+    OldHeater = PHEATER;
+
+    //case 10
+    ISRTicks++;
+    if(CJTicks) CJTicks--;
+
+    //main loop
+    IronTasks();
+    PIDTasks();
+    HALI2CRunUntil(t0 + MAINS_PER_US);
+}
@@ -0,0 +1,41 @@
+/*
+ * File:   sim.h
+ *
+ * Mains half period driver: feeds the plant into the firmware control core the
+ * same way ISRHigh does (heater data in case 2, temperature in case 5 with the PID
+ * run right after it as the PID interrupt, heater decision in case 6) and lets the
+ * main loop tasks run in between.
+ */
+
+#ifndef SIM_H
+#define	SIM_H
+
+#include <GenericTypeDefs.h>
+#include "plant.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#define SIM_MAINS_DC 0
+
+typedef struct {
+    UINT64 (*Clock)();      //time source, SimHalfPeriod profiles step 5 when set
+    UINT64 ISR;             //step 5 as run in the ISR: sensor checks and latching of the samples
+    UINT64 PID;             //deferred PID task
+    UINT32 Cnt;             //number of PID runs
+}t_SimProf;
+
+extern t_SimProf SimProf;
+extern int SimDualScan;     //1 - both sensors of a dual instrument are read in every window when the front end allows it (default)
+
+extern int SimInit(t_Plant * PL, const t_IronPars * IP, int Mains);
+extern void SimSetTemperature(int temp);
+extern void SimHalfPeriod(t_Plant * PL);
+extern double SimHalfPeriodTime();
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SIM_H */